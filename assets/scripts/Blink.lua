@@ -0,0 +1,19 @@
+-- Latent action example: no OnTick at all, so the entity is never ticked.
+-- The coroutine sleeps between steps and costs nothing while it waits.
+-- API: StartLatent(fn, ...) -> handle, StopLatent(handle), IsLatentRunning(handle)
+--      Wait(seconds), WaitFrames(n), WaitUntil(fn) -- only inside a latent action
+--      SetTickEnabled(id, enabled)
+
+interval = interval or 2.0 -- seconds between turns
+
+function OnStart(id)
+  StartLatent(function()
+    WaitFrames(1) -- let the rest of the scene start first
+    while true do
+      local t = GetTransform(id)
+      local r = t.rotation
+      t.rotation = vec3(r.x, r.y + 90, r.z)
+      Wait(interval)
+    end
+  end)
+end
@@ -0,0 +1,21 @@
+-- GC stress script: every OnTick makes garbage on purpose
+-- Put it on a few hundred entities, then compare frame times per GC mode in the console:
+--   gc mode auto, gc reset, (wait a few seconds), gc   -> Lua's own collector
+--   gc mode inc,  gc reset, (wait a few seconds), gc   -> scheduled in leftover frame time
+-- 'gc' prints the p50/p99 frame time and the GC pause histogram.
+
+churn = churn or 64 -- short-lived tables per entity per tick
+
+function OnStart(id)
+  Print("GcStress.lua OnStart for entity " .. tostring(id))
+end
+
+function OnTick(id, dt)
+  local garbage = {}
+  for i = 1, churn do
+    garbage[i] = { id = id, dt = dt, tag = "tmp" .. i }
+  end
+  -- Use the result so the entity visibly spins
+  local x, y, z = GetRotation(id)
+  SetRotation(id, vec3(x, y + #garbage * dt * 0.5, z))
+end
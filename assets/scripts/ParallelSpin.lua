@@ -0,0 +1,19 @@
+-- Parallel-safe spinner, used to load-test parallel ticking:
+--   spawn 20000 assets/scripts/ParallelSpin.lua
+--   profile on / gc reset, then compare 'gc' frame times with 'parallel off' and 'parallel 8'
+-- Parallel scripts only read the registry and use the Set* calls (buffered per thread);
+-- OnStart runs on the main state, OnTick on whichever state owns the entity.
+
+Parallel = true
+
+speed = speed or 30.0 -- deg/sec
+
+function OnTick(id, dt)
+  local x, y, z = GetRotation(id)
+  -- A little arithmetic so the tick is not all call overhead
+  local wobble = 0
+  for i = 1, 16 do
+    wobble = wobble + math.sin(y * 0.01 + i)
+  end
+  SetRotation(id, vec3(x, y + speed * dt, wobble * 0.1))
+end
@@ -1,14 +1,32 @@
 -- Minimal example script for SproutEngine
 -- API available in C++ binding: GetRotation(id) / SetRotation(id, vec3), Print(msg)
+-- Batch API: GetRotations(ids [, out]) / SetRotations(ids, rotations) over flat {x, y, z, ...} arrays
+-- Transform API: GetTransform(id) -> t.position / t.scale (t.position.x = 1 writes through, :Get() copies), t.rotation (Euler degrees)
 
 speed = speed or 45.0 -- deg/sec; can be overridden by inspector later
 
+-- Reused across frames so the batch tick does not allocate
+local rotations = {}
+
 function OnStart(id)
   Print("Rotate.lua OnStart for entity " .. tostring(id))
 end
 
+-- Called once per frame with every entity running this script
+function OnTickBatch(ids, dt)
+  GetRotations(ids, rotations)
+  local step = speed * dt
+  for i = 1, #ids do
+    local y = 3 * i - 1
+    rotations[y] = rotations[y] + step
+  end
+  SetRotations(ids, rotations)
+end
+
+-- Per-entity form; only used by the engine when OnTickBatch is not defined
 function OnTick(id, dt)
-  local x, y, z = GetRotation(id)
-  y = y + speed * dt
-  SetRotation(id, {x, y, z})
+  local t = GetTransform(id)
+  local r = t.rotation
+  r.y = r.y + speed * dt
+  t.rotation = r
 end
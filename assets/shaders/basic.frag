@@ -1,10 +1,11 @@
 #version 330 core
+#include "frame.glsl"
 in vec3 vNormal;
 out vec4 FragColor;
 uniform vec3 uTint;
 
 void main(){
-  float l = max(dot(normalize(vNormal), normalize(vec3(0.3,0.6,0.7))), 0.15);
-  vec3 base = vec3(0.35, 0.65, 0.95) * l;
+  float l = max(dot(normalize(vNormal), normalize(uLightDirection.xyz)), uLightColor.a);
+  vec3 base = vec3(0.35, 0.65, 0.95) * uLightColor.rgb * l;
   FragColor = vec4(base * uTint, 1.0);
 }
@@ -0,0 +1,8 @@
+// Per-frame data shared by every program (ShaderLibrary::FrameData, binding 0)
+layout (std140) uniform FrameBlock {
+  mat4 uViewProj;
+  vec4 uLightDirection;   // xyz toward the light
+  vec4 uLightColor;       // rgb, a = ambient floor
+  vec4 uCameraPosition;
+  vec4 uTime;             // x = seconds
+};
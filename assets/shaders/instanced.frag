@@ -0,0 +1,11 @@
+#version 330 core
+#include "frame.glsl"
+in vec3 vNormal;
+in vec3 vTint;
+out vec4 FragColor;
+
+void main(){
+  float l = max(dot(normalize(vNormal), normalize(uLightDirection.xyz)), uLightColor.a);
+  vec3 base = vec3(0.35, 0.65, 0.95) * uLightColor.rgb * l;
+  FragColor = vec4(base * vTint, 1.0);
+}
@@ -0,0 +1,16 @@
+#version 330 core
+#include "frame.glsl"
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+// Per instance (divisor 1): model matrix in 2..5, tint in 6
+layout (location = 2) in mat4 aModel;
+layout (location = 6) in vec4 aTint;
+
+out vec3 vNormal;
+out vec3 vTint;
+
+void main(){
+  vNormal = aNormal;
+  vTint = aTint.rgb;
+  gl_Position = uViewProj * aModel * vec4(aPos, 1.0);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Bench - minimal timing harness behind SproutBench
+ * Benchmarks are free functions registered with SPROUT_BENCH(Name). SproutBench runs
+ * all of them, or only those whose name contains the first argument. Measure() times
+ * a callable repeatedly and Report() prints median / p99 / min per line, so the
+ * before/after rows of one benchmark line up.
+ */
+namespace Bench {
+
+struct Result {
+    double medianMs = 0.0;
+    double p99Ms = 0.0;
+    double minMs = 0.0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+inline double ElapsedMs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Median / p99 / min of the samples (sorts them in place)
+Result Summarize(std::vector<double>& samplesMs);
+
+// Runs fn once untimed, then times it iterations times
+template<typename Fn>
+Result Measure(int iterations, Fn&& fn) {
+    fn();
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        const Clock::time_point start = Clock::now();
+        fn();
+        samples.push_back(ElapsedMs(start, Clock::now()));
+    }
+    return Summarize(samples);
+}
+
+// One result line; items > 0 adds a per-item cost in nanoseconds
+void Report(const std::string& label, const Result& result, size_t items = 0);
+
+// Keeps the compiler from discarding work whose result is otherwise unused
+void Consume(const void* value);
+
+using BenchFn = void (*)();
+
+struct Registrar {
+    Registrar(const char* name, BenchFn fn);
+};
+
+} // namespace Bench
+
+#define SPROUT_BENCH(Name)                                            \
+    static void Name();                                               \
+    static const Bench::Registrar Name##Registrar(#Name, &Name);      \
+    static void Name()
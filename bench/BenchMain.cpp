@@ -0,0 +1,71 @@
+#include "Bench.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace Bench {
+
+namespace {
+    struct Entry {
+        const char* name;
+        BenchFn fn;
+    };
+
+    std::vector<Entry>& Entries() {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    volatile const void* g_sink = nullptr;
+}
+
+Registrar::Registrar(const char* name, BenchFn fn) {
+    Entries().push_back(Entry{name, fn});
+}
+
+Result Summarize(std::vector<double>& samplesMs) {
+    Result result;
+    if (samplesMs.empty()) return result;
+
+    std::sort(samplesMs.begin(), samplesMs.end());
+    const size_t last = samplesMs.size() - 1;
+    result.medianMs = samplesMs[last / 2];
+    result.p99Ms = samplesMs[static_cast<size_t>(std::ceil(0.99 * static_cast<double>(last)))];
+    result.minMs = samplesMs.front();
+    return result;
+}
+
+void Report(const std::string& label, const Result& result, size_t items) {
+    std::printf("  %-44s median %9.3f ms   p99 %9.3f ms   min %9.3f ms", label.c_str(),
+                result.medianMs, result.p99Ms, result.minMs);
+    if (items > 0) {
+        std::printf("   %8.2f ns/item", result.medianMs * 1.0e6 / static_cast<double>(items));
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+void Consume(const void* value) {
+    g_sink = value;
+}
+
+} // namespace Bench
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    int run = 0;
+    for (const auto& entry : Bench::Entries()) {
+        if (filter && !std::strstr(entry.name, filter)) continue;
+        std::printf("%s\n", entry.name);
+        entry.fn();
+        ++run;
+    }
+
+    if (run == 0) {
+        std::fprintf(stderr, "No benchmark matches '%s'\n", filter ? filter : "");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "Bench.h"
+#include "Engine/Actor.h"
+#include "Engine/ComponentStorage.h"
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Component lookup (GetComponent<T>) on 10k actors with 1, 4 and 16 components each:
+// the unordered_map<type_index, unique_ptr> actors used to keep, against ComponentStorage
+// (inline SIMD search up to 8, sorted vector past that). Every lookup hits.
+
+namespace {
+
+constexpr size_t ActorCount = 10000;
+constexpr size_t MaxTypes = 16;
+
+template<size_t N>
+class BenchComponent : public ActorComponent {
+public:
+    BenchComponent() : ActorComponent(nullptr) {}
+};
+
+struct ComponentType {
+    std::type_index index;
+    ComponentTypeId id;
+    std::unique_ptr<ActorComponent> (*make)();
+};
+
+template<size_t... N>
+std::array<ComponentType, sizeof...(N)> MakeTypes(std::index_sequence<N...>) {
+    return {ComponentType{std::type_index(typeid(BenchComponent<N>)), GetComponentTypeId<BenchComponent<N>>(),
+                          [] { return std::unique_ptr<ActorComponent>(new BenchComponent<N>()); }}...};
+}
+
+const std::array<ComponentType, MaxTypes>& Types() {
+    static const auto types = MakeTypes(std::make_index_sequence<MaxTypes>());
+    return types;
+}
+
+using LegacyStorage = std::unordered_map<std::type_index, std::unique_ptr<ActorComponent>>;
+
+void RunComponentCount(size_t perActor) {
+    const auto& types = Types();
+    std::vector<LegacyStorage> legacy(ActorCount);
+    std::vector<ComponentStorage> storage(ActorCount);
+    for (size_t a = 0; a < ActorCount; ++a) {
+        for (size_t t = 0; t < perActor; ++t) {
+            // Per-actor order varies, like components created in different orders
+            const ComponentType& type = types[(t + a) % perActor];
+            legacy[a].emplace(type.index, type.make());
+            storage[a].Set(type.id, type.make());
+        }
+    }
+
+    // Lookup order per actor: each of its types once
+    const size_t lookups = ActorCount * perActor;
+    ActorComponent* sink = nullptr;
+    const Bench::Result before = Bench::Measure(50, [&] {
+        for (size_t a = 0; a < ActorCount; ++a) {
+            for (size_t t = 0; t < perActor; ++t) sink = legacy[a].find(types[t].index)->second.get();
+        }
+        Bench::Consume(sink);
+    });
+    const Bench::Result after = Bench::Measure(50, [&] {
+        for (size_t a = 0; a < ActorCount; ++a) {
+            for (size_t t = 0; t < perActor; ++t) sink = storage[a].Find(types[t].id);
+        }
+        Bench::Consume(sink);
+    });
+
+    std::printf("  %zu component(s) per actor\n", perActor);
+    Bench::Report("unordered_map<type_index> (before)", before, lookups);
+    Bench::Report("ComponentStorage", after, lookups);
+}
+
+} // namespace
+
+SPROUT_BENCH(ComponentLookup) {
+    for (size_t perActor : {size_t(1), size_t(4), size_t(16)}) {
+        RunComponentCount(perActor);
+    }
+}
@@ -0,0 +1,50 @@
+#include "Bench.h"
+#include "Engine/FrustumCulling.h"
+#include "Engine/JobSystem.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// FrustumCulling::Cull on 1M boxes spread around the camera, per path, and CullParallel
+// on the shared pool.
+
+namespace {
+
+constexpr size_t BoxCount = 1000000;
+
+} // namespace
+
+SPROUT_BENCH(FrustumCull) {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> extent(0.5f, 2.0f);
+    FrustumCulling::BoxList boxes;
+    boxes.Reserve(BoxCount);
+    for (size_t i = 0; i < BoxCount; ++i) {
+        boxes.Add({position(rng), position(rng) * 0.1f, position(rng)}, glm::vec3(extent(rng)));
+    }
+
+    const glm::mat4 viewProj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 400.0f) *
+                               glm::lookAt(glm::vec3(0.0f, 20.0f, 0.0f), glm::vec3(100.0f, 0.0f, 100.0f),
+                                           glm::vec3(0.0f, 1.0f, 0.0f));
+    const FrustumCulling::Frustum frustum = FrustumCulling::ExtractFrustum(viewProj);
+    const FrustumCulling::AABBArrays arrays = boxes.GetArrays();
+    std::vector<uint32_t> visible(BoxCount);
+    size_t visibleCount = 0;
+
+    for (FrustumCulling::Path path : {FrustumCulling::Path::Scalar, FrustumCulling::Path::SSE2, FrustumCulling::Path::AVX2}) {
+        if (!FrustumCulling::IsPathSupported(path)) continue;
+        Bench::Report(std::string("1M boxes, ") + FrustumCulling::GetPathName(path), Bench::Measure(20, [&] {
+            visibleCount = FrustumCulling::Cull(frustum, arrays, BoxCount, visible.data(), path);
+        }), BoxCount);
+    }
+
+    JobSystem& jobs = JobSystem::Shared();
+    Bench::Report("1M boxes, parallel (" + std::to_string(jobs.GetWorkerCount() + 1) + " threads)",
+                  Bench::Measure(20, [&] {
+                      visibleCount = FrustumCulling::CullParallel(jobs, frustum, arrays, BoxCount, visible.data());
+                  }), BoxCount);
+    std::printf("    %zu visible, %zu culled\n", visibleCount, BoxCount - visibleCount);
+    Bench::Consume(visible.data());
+}
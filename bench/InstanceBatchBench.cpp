@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "Engine/InstanceBatcher.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstdio>
+#include <vector>
+
+// CPU side of instanced cube submission at 10k / 100k cubes: InstanceBatcher filling
+// the upload buffer, and the draw calls left (one per mesh/material instead of one per
+// cube). GPU frame times need a window: SproutEngine --bench-cubes N, with
+// LIBGL_ALWAYS_SOFTWARE=1 for llvmpipe.
+
+namespace {
+
+constexpr uint32_t MaterialCount = 4;
+
+void RunSize(size_t count) {
+    std::vector<glm::mat4> models;
+    std::vector<glm::vec4> tints;
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 position(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+        models.push_back(glm::translate(glm::mat4(1.0f), position));
+        tints.push_back(glm::vec4(static_cast<float>(i % 7) / 7.0f, 0.5f, 1.0f, 1.0f));
+    }
+
+    InstanceBatcher batcher;
+    std::vector<InstanceData> upload(count);
+    size_t drawCalls = 0;
+    auto pack = [&](auto materialOf) {
+        return Bench::Measure(20, [&] {
+            batcher.Clear();
+            for (size_t i = 0; i < count; ++i) {
+                batcher.Add(0, materialOf(i), models[i], tints[i]);
+            }
+            drawCalls = batcher.Pack(upload.data()).size();
+            Bench::Consume(upload.data());
+        });
+    };
+
+    const std::string size = std::to_string(count / 1000) + "k cubes";
+    // Materials in runs (the usual scene order) hit the last-bucket fast path
+    Bench::Report(size + ", materials in runs", pack([&](size_t i) {
+        return static_cast<uint32_t>(i * MaterialCount / count);
+    }), count);
+    Bench::Report(size + ", materials interleaved", pack([](size_t i) {
+        return static_cast<uint32_t>(i % MaterialCount);
+    }), count);
+    std::printf("    %zu draw calls instead of %zu\n", drawCalls, count);
+}
+
+} // namespace
+
+SPROUT_BENCH(InstanceBatch) {
+    RunSize(10000);
+    RunSize(100000);
+}
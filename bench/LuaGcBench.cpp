@@ -0,0 +1,63 @@
+#include "Bench.h"
+#include "Engine/LuaGcScheduler.h"
+#include <lua.hpp>
+#include <cstdio>
+#include <vector>
+
+// Frame times (p50 / p99) of a garbage-heavy script under each LuaGcScheduler mode.
+// Every frame allocates short-lived tables and replaces part of a long-lived set, then
+// gives the scheduler what is left of a 60 Hz frame.
+
+namespace {
+
+constexpr const char* Setup = R"(
+    live = {}
+    for i = 1, 20000 do live[i] = { i, tostring(i) } end
+    cursor = 0
+)";
+
+constexpr const char* Frame = R"(
+    for i = 1, 5000 do local t = { i, i * 2, tostring(i) } end
+    for i = 1, 500 do
+        cursor = cursor % #live + 1
+        live[cursor] = { cursor, tostring(cursor) }
+    end
+)";
+
+constexpr double TargetFrameSeconds = 1.0 / 60.0;
+
+void RunMode(LuaGcScheduler::Mode mode) {
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+    LuaGcScheduler scheduler;
+    scheduler.Attach(L);
+    scheduler.SetMode(mode);
+    luaL_dostring(L, Setup);
+
+    constexpr int frames = 600;
+    std::vector<double> samples;
+    samples.reserve(frames);
+    for (int frame = 0; frame < frames + 30; ++frame) {
+        const Bench::Clock::time_point start = Bench::Clock::now();
+        luaL_dostring(L, Frame);
+        scheduler.Step(Bench::ElapsedMs(start, Bench::Clock::now()) * 0.001, TargetFrameSeconds);
+        // The first frames grow the heap to its working size
+        if (frame >= 30) samples.push_back(Bench::ElapsedMs(start, Bench::Clock::now()));
+    }
+
+    const LuaGcScheduler::Stats& stats = scheduler.GetStats();
+    Bench::Report(LuaGcScheduler::GetModeName(mode), Bench::Summarize(samples));
+    std::printf("    heap %zu KB, %llu cycles, %llu emergencies, max scheduled pause %.3f ms\n",
+                scheduler.GetHeapKB(), static_cast<unsigned long long>(stats.cycles),
+                static_cast<unsigned long long>(stats.emergencies), stats.maxPauseSeconds * 1000.0);
+    lua_close(L);
+}
+
+} // namespace
+
+SPROUT_BENCH(LuaGcFrameTimes) {
+    for (auto mode : {LuaGcScheduler::Mode::Automatic, LuaGcScheduler::Mode::Incremental,
+                      LuaGcScheduler::Mode::Generational}) {
+        RunMode(mode);
+    }
+}
@@ -0,0 +1,29 @@
+#include "ScriptBench.h"
+#include <algorithm>
+#include <thread>
+
+// 20k entities on ParallelSpin.lua (Parallel = true): every tick on the main Lua state,
+// then sharded over 2, 4, ... Lua states up to the core count. Frame times include
+// applying the buffered SetRotation writes after the shards finish.
+
+namespace {
+
+constexpr size_t EntityCount = 20000;
+constexpr int Frames = 60;
+
+} // namespace
+
+SPROUT_BENCH(ParallelScripts) {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("  %u hardware threads\n", cores);
+    const std::string script = ScriptBench::AssetScript("ParallelSpin.lua");
+
+    {
+        ScriptBench::Scene scene(EntityCount, script);
+        Bench::Report("main state only", scene.Measure(Frames), EntityCount);
+    }
+    for (unsigned threads = 2; threads <= std::max(2u, cores); threads *= 2) {
+        ScriptBench::Scene scene(EntityCount, script, threads);
+        Bench::Report(std::to_string(threads) + " Lua states", scene.Measure(Frames), EntityCount);
+    }
+}
@@ -0,0 +1,56 @@
+#include "Bench.h"
+#include "Engine/GameplayActors.h"
+#include "Engine/World.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// World::Tick over RotatingCube actors (parallel ticks) from 1 thread up to every core
+
+namespace {
+
+void RunScaling(size_t cubeCount) {
+    World world("RotatingCubeBench");
+    world.PrewarmActors<RotatingCube>(cubeCount);
+    World::PrewarmComponents<MeshRendererComponent>(cubeCount);
+
+    // RotatingCube::BeginPlay logs one line per actor
+    std::ostringstream muted;
+    std::streambuf* coutBuffer = std::cout.rdbuf(muted.rdbuf());
+    for (size_t i = 0; i < cubeCount; ++i) {
+        RotatingCube* cube = world.SpawnActor<RotatingCube>("Cube");
+        cube->RotationAxis = glm::vec3(0.3f, 1.0f, 0.1f * static_cast<float>(i % 7));
+    }
+    world.BeginPlay();
+    std::cout.rdbuf(coutBuffer);
+
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    const int iterations = cubeCount >= 100000 ? 20 : 100;
+    double single = 0.0;
+    for (unsigned threads : threadCounts) {
+        world.SetWorkerThreadCount(threads - 1);
+        Bench::Result result = Bench::Measure(iterations, [&] { world.Tick(0.016f); });
+        if (threads == 1) single = result.medianMs;
+
+        std::ostringstream label;
+        label << cubeCount / 1000 << "k cubes, " << threads << " threads (x" << std::fixed;
+        label.precision(2);
+        label << (result.medianMs > 0.0 ? single / result.medianMs : 0.0) << ")";
+        Bench::Report(label.str(), result, cubeCount);
+    }
+    Bench::Consume(world.GetAllActors().front().get());
+}
+
+} // namespace
+
+SPROUT_BENCH(RotatingCubeScaling) {
+    for (size_t cubeCount : {10000u, 100000u}) {
+        RunScaling(cubeCount);
+    }
+}
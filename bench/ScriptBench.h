@@ -0,0 +1,68 @@
+#pragma once
+#include "Bench.h"
+#include "Engine/Components.h"
+#include "Engine/Scripting.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * ScriptBench - a registry and a Scripting instance with every entity running one script
+ * file, for the script dispatch benchmarks. Frames go through Scripting::update, so they
+ * pay for everything a game frame does around the Lua calls.
+ */
+namespace ScriptBench {
+
+constexpr float FrameDt = 1.0f / 60.0f;
+
+// Drops std::cout output (Print from OnStart) while thousands of entities bind
+struct QuietCout {
+    QuietCout() : saved(std::cout.rdbuf(nullptr)) {}
+    ~QuietCout() {
+        std::cout.rdbuf(saved);
+        std::cout.clear();
+    }
+    std::streambuf* saved;
+};
+
+// Writes source to name under the temp directory; returns the path
+inline std::string WriteScript(const std::string& name, const std::string& source) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << source;
+    return path.string();
+}
+
+inline std::string AssetScript(const std::string& name) {
+    return std::string(SE_ASSETS_DIR) + "/scripts/" + name;
+}
+
+struct Scene {
+    // Before scripting: the bindings hold a reference to it
+    entt::registry reg;
+    Scripting scripting;
+
+    Scene(size_t entityCount, const std::string& scriptPath, unsigned parallelThreads = 0) {
+        scripting.init();
+        scripting.attach(reg);
+        scripting.setParallelThreads(parallelThreads);
+
+        QuietCout quiet;
+        for (size_t i = 0; i < entityCount; ++i) {
+            const entt::entity e = reg.create();
+            reg.emplace<Transform>(e);
+            reg.emplace<Script>(e);
+            if (!scripting.loadScript(reg, e, scriptPath)) failed = true;
+        }
+    }
+
+    Bench::Result Measure(int frames) {
+        if (failed) std::printf("    script failed to load, timings are meaningless\n");
+        return Bench::Measure(frames, [this] { scripting.update(reg, FrameDt); });
+    }
+
+    bool failed = false;
+};
+
+} // namespace ScriptBench
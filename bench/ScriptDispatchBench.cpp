@@ -0,0 +1,73 @@
+#include "ScriptBench.h"
+#include <sol/sol.hpp>
+#include <tuple>
+
+// 10k entities running Rotate.lua, before and after per-script environments with cached
+// dispatch. "global OnTick lookup" is the old Scripting::update loop: every script in one
+// global state, lua["OnTick"] fetched and wrapped in a new protected_function per entity.
+// The other rows are Scripting::update today, calling the LoadedScript's cached OnTick
+// per entity, and Rotate.lua as shipped, which ticks through OnTickBatch.
+
+namespace {
+
+constexpr size_t EntityCount = 10000;
+constexpr int Frames = 60;
+
+// Rotate.lua before OnTickBatch and GetTransform existed
+constexpr const char* PerEntityRotate = R"(
+speed = speed or 45.0
+
+function OnTick(id, dt)
+  local x, y, z = GetRotation(id)
+  y = y + speed * dt
+  SetRotation(id, {x, y, z})
+end
+)";
+
+Bench::Result GlobalLookupDispatch() {
+    entt::registry reg;
+    for (size_t i = 0; i < EntityCount; ++i) {
+        const entt::entity e = reg.create();
+        reg.emplace<Transform>(e);
+        reg.emplace<Script>(e);
+    }
+
+    // The old bindings: a tuple out, a table in
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua["GetRotation"] = [&reg](uint32_t id) {
+        const glm::vec3 r = reg.get<Transform>((entt::entity)id).GetRotationEuler();
+        return std::make_tuple(r.x, r.y, r.z);
+    };
+    lua["SetRotation"] = [&reg](uint32_t id, sol::table t) {
+        const glm::vec3 r{t.get_or(1, 0.0f), t.get_or(2, 0.0f), t.get_or(3, 0.0f)};
+        reg.get<Transform>((entt::entity)id).SetRotationEuler(r);
+    };
+    lua.script(PerEntityRotate);
+
+    auto view = reg.view<Script>();
+    return Bench::Measure(Frames, [&] {
+        for (auto e : view) {
+            sol::object onTickObj = lua["OnTick"];
+            if (onTickObj.is<sol::protected_function>()) {
+                sol::protected_function onTick = onTickObj.as<sol::protected_function>();
+                onTick((uint32_t)e, ScriptBench::FrameDt);
+            }
+        }
+    });
+}
+
+} // namespace
+
+SPROUT_BENCH(ScriptDispatch) {
+    Bench::Report("global OnTick lookup (before)", GlobalLookupDispatch(), EntityCount);
+
+    {
+        ScriptBench::Scene scene(EntityCount, ScriptBench::WriteScript("sprout_bench_rotate.lua", PerEntityRotate));
+        Bench::Report("cached OnTick per script", scene.Measure(Frames), EntityCount);
+    }
+    {
+        ScriptBench::Scene scene(EntityCount, ScriptBench::AssetScript("Rotate.lua"));
+        Bench::Report("Rotate.lua OnTickBatch", scene.Measure(Frames), EntityCount);
+    }
+}
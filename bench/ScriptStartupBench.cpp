@@ -0,0 +1,103 @@
+#include "Bench.h"
+#include "Engine/ScriptBytecodeCache.h"
+#include <lua.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Startup of a level with 500 distinct scripts: parse every source, against loading
+// bytecode from a warm ScriptBytecodeCache directory. Each script is loaded and run
+// once, as Scripting::compileScript does.
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int ScriptCount = 500;
+
+// A gameplay-sized script (~120 lines), distinct per index
+std::string MakeScript(int index) {
+    std::string source = "local id = " + std::to_string(index) + "\nlocal state = { t = 0, phase = 0 }\n";
+    for (int f = 0; f < 12; ++f) {
+        const std::string n = std::to_string(f);
+        source += "local function Step" + n + "(dt, x)\n"
+                  "    local a, b = x * " + n + ".5, dt + id\n"
+                  "    if a > b then a = a - b elseif a < -b then a = a + b else a = a * 0.5 end\n"
+                  "    for i = 1, 3 do state.t = state.t + math.sin(a * i) * dt end\n"
+                  "    state.phase = (state.phase + " + n + ") % 360\n"
+                  "    return { a = a, b = b, name = \"step" + n + "\" .. id }\n"
+                  "end\n"
+                  "_G[\"Step" + n + "_\" .. id] = Step" + n + "\n";
+    }
+    source += "function OnTick(dt)\n";
+    for (int f = 0; f < 12; ++f) source += "    Step" + std::to_string(f) + "(dt, state.t)\n";
+    source += "end\nreturn id\n";
+    return source;
+}
+
+std::string ChunkName(int index) { return "@scripts/level/script" + std::to_string(index) + ".lua"; }
+
+struct Level {
+    std::vector<std::string> sources;
+    std::vector<std::string> chunkNames;
+};
+
+// One startup in a fresh state; false if any script failed
+bool Startup(const Level& level, ScriptBytecodeCache* cache) {
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+    bool ok = true;
+    for (size_t i = 0; i < level.sources.size() && ok; ++i) {
+        const std::string& source = level.sources[i];
+        const char* name = level.chunkNames[i].c_str();
+        if (cache) {
+            std::string error;
+            const std::string* bytecode = cache->GetBytecode(L, source, level.chunkNames[i], error);
+            ok = bytecode && luaL_loadbufferx(L, bytecode->data(), bytecode->size(), name, "b") == LUA_OK;
+        } else {
+            ok = luaL_loadbufferx(L, source.data(), source.size(), name, "t") == LUA_OK;
+        }
+        ok = ok && lua_pcall(L, 0, 0, 0) == LUA_OK;
+        lua_settop(L, 0);
+    }
+    lua_close(L);
+    return ok;
+}
+
+} // namespace
+
+SPROUT_BENCH(ScriptStartup) {
+    Level level;
+    size_t sourceBytes = 0;
+    for (int i = 0; i < ScriptCount; ++i) {
+        level.sources.push_back(MakeScript(i));
+        level.chunkNames.push_back(ChunkName(i));
+        sourceBytes += level.sources.back().size();
+    }
+    const fs::path directory = fs::temp_directory_path() / "sprout_bench_luac";
+    fs::remove_all(directory);
+
+    std::printf("  %d scripts, %zu KB of source\n", ScriptCount, sourceBytes / 1024);
+    bool ok = true;
+    Bench::Report("parse every source", Bench::Measure(10, [&] { ok = Startup(level, nullptr) && ok; }), ScriptCount);
+
+    // First run against an empty directory: parse, dump and write every file
+    {
+        ScriptBytecodeCache cache(directory.string());
+        const Bench::Clock::time_point start = Bench::Clock::now();
+        ok = Startup(level, &cache) && ok;
+        std::printf("    cold cache: %.2f ms (%llu compiles)\n", Bench::ElapsedMs(start, Bench::Clock::now()),
+                    static_cast<unsigned long long>(cache.GetStats().compiles));
+    }
+
+    uint64_t compiles = 0;
+    Bench::Report("warm cache directory", Bench::Measure(10, [&] {
+        ScriptBytecodeCache cache(directory.string());
+        ok = Startup(level, &cache) && ok;
+        compiles += cache.GetStats().compiles;
+    }), ScriptCount);
+    std::printf("    %llu compiles on warm starts%s\n", static_cast<unsigned long long>(compiles),
+                ok ? "" : ", SOME SCRIPTS FAILED");
+    fs::remove_all(directory);
+}
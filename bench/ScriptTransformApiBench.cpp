@@ -0,0 +1,44 @@
+#include "ScriptBench.h"
+
+// The same rotation update written against each Transform API Lua scripts have, 10k
+// entities with a per-entity OnTick. Dispatch is identical in every row; only the calls
+// into the component differ.
+
+namespace {
+
+constexpr size_t EntityCount = 10000;
+constexpr int Frames = 60;
+
+struct Variant {
+    const char* label;
+    const char* file;
+    const char* onTick;
+};
+
+constexpr Variant Variants[] = {
+    {"tuple out, table in", "sprout_bench_api_table.lua", R"(
+  local x, y, z = GetRotation(id)
+  SetRotation(id, {x, y + speed * dt, z}))"},
+    {"tuple out, vec3 in", "sprout_bench_api_vec3.lua", R"(
+  local x, y, z = GetRotation(id)
+  SetRotation(id, vec3(x, y + speed * dt, z)))"},
+    {"GetTransform rotation", "sprout_bench_api_ref.lua", R"(
+  local t = GetTransform(id)
+  local r = t.rotation
+  r.y = r.y + speed * dt
+  t.rotation = r)"},
+    // No table-API equivalent: one axis written through the position proxy
+    {"GetTransform position.y write", "sprout_bench_api_position.lua", R"(
+  local p = GetTransform(id).position
+  p.y = p.y + speed * dt)"},
+};
+
+} // namespace
+
+SPROUT_BENCH(ScriptTransformApi) {
+    for (const Variant& variant : Variants) {
+        const std::string source = std::string("speed = 45.0\nfunction OnTick(id, dt)") + variant.onTick + "\nend\n";
+        ScriptBench::Scene scene(EntityCount, ScriptBench::WriteScript(variant.file, source));
+        Bench::Report(variant.label, scene.Measure(Frames), EntityCount);
+    }
+}
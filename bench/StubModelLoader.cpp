@@ -0,0 +1,7 @@
+#include "Engine/FbxImporter.h"
+
+// Stands in for the assimp importer so gameplay actors (whose mesh components load a
+// model when constructed) can be spawned in benchmarks without asset files
+std::optional<Model> LoadModel(const std::string &path) {
+  return Model{};
+}
@@ -0,0 +1,113 @@
+#include "Bench.h"
+#include "Engine/Actor.h"
+#include "Engine/World.h"
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+// Old World::Tick against the TickRegistry path, at 1k / 10k / 100k actors.
+// Every actor ticks and carries one ticking and one non-ticking component.
+
+namespace {
+
+class BenchMoverComponent : public ActorComponent {
+public:
+    BenchMoverComponent(Actor* owner) : ActorComponent(owner) {
+        SetTickEnabled(true);
+        SetTickOnGameThreadOnly(false);
+    }
+    void TickComponent(float deltaTime) override { distance += speed * deltaTime; }
+
+    float speed = 2.0f;
+    float distance = 0.0f;
+};
+
+class BenchTagComponent : public ActorComponent {
+public:
+    BenchTagComponent(Actor* owner) : ActorComponent(owner) {}
+    int tag = 0;
+};
+
+class BenchActor : public Actor {
+public:
+    using ThisClass = BenchActor;
+    using Super = Actor;
+    BenchActor(World* world, const std::string& name) : Actor(world, name) {
+        SetTickOnGameThreadOnly(false);
+        CreateComponent<BenchMoverComponent>();
+        CreateComponent<BenchTagComponent>();
+    }
+    static std::string StaticClass() { return "BenchActor"; }
+
+    void Tick(float deltaTime) override { age += deltaTime; }
+
+    float age = 0.0f;
+};
+
+// What World::Tick did before the registry: every actor, then a walk over its
+// type_index -> component hash map, testing IsTickEnabled() on each entry
+struct LegacyTickPath {
+    std::vector<std::unordered_map<std::type_index, ActorComponent*>> componentMaps;
+
+    explicit LegacyTickPath(World& world) {
+        componentMaps.reserve(world.GetActorCount());
+        for (const auto& actor : world.GetAllActors()) {
+            std::unordered_map<std::type_index, ActorComponent*> map;
+            map.emplace(std::type_index(typeid(BenchMoverComponent)), actor->GetComponent<BenchMoverComponent>());
+            map.emplace(std::type_index(typeid(BenchTagComponent)), actor->GetComponent<BenchTagComponent>());
+            componentMaps.push_back(std::move(map));
+        }
+    }
+
+    void Tick(World& world, float deltaTime) {
+        const auto& actors = world.GetAllActors();
+        for (size_t i = 0; i < actors.size(); ++i) {
+            Actor* actor = actors[i].get();
+            if (actor->IsPendingDestroy()) continue;
+            actor->Tick(deltaTime);
+            for (const auto& [type, component] : componentMaps[i]) {
+                if (component->IsTickEnabled()) {
+                    component->TickComponent(deltaTime);
+                }
+            }
+        }
+    }
+};
+
+void RunTickBench(size_t actorCount) {
+    World world("TickBench");
+    world.PrewarmActors<BenchActor>(actorCount);
+    for (size_t i = 0; i < actorCount; ++i) {
+        world.SpawnActor<BenchActor>("Bench");
+    }
+    world.BeginPlay();
+
+    const int iterations = actorCount >= 100000 ? 20 : 100;
+    const std::string count = std::to_string(actorCount / 1000) + "k";
+
+    LegacyTickPath legacy(world);
+    Bench::Report("legacy per-actor map walk, " + count,
+                  Bench::Measure(iterations, [&] { legacy.Tick(world, 0.016f); }), actorCount);
+
+    const unsigned workers = world.GetJobSystem().GetWorkerCount();
+    world.SetWorkerThreadCount(0);
+    Bench::Report("registry, 1 thread, " + count,
+                  Bench::Measure(iterations, [&] { world.Tick(0.016f); }), actorCount);
+
+    if (workers > 0) {
+        world.SetWorkerThreadCount(workers);
+        Bench::Report("registry, " + std::to_string(workers + 1) + " threads, " + count,
+                      Bench::Measure(iterations, [&] { world.Tick(0.016f); }), actorCount);
+    }
+
+    Bench::Consume(world.GetAllActors().front().get());
+}
+
+} // namespace
+
+SPROUT_BENCH(WorldTick) {
+    for (size_t actorCount : {1000u, 10000u, 100000u}) {
+        RunTickBench(actorCount);
+    }
+}
@@ -0,0 +1,59 @@
+#include "Bench.h"
+#include "Engine/TransformKernel.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// TransformKernel::ComposeTRS on one thread, per path: 100k matrices (6.4 MB out, past
+// L2 on most parts) and 4k (in L1/L2). Reports matrices per second per core.
+
+namespace {
+
+struct Batch {
+    std::vector<float> px, py, pz, rx, ry, rz, rw, sx, sy, sz;
+    std::vector<float> out;
+
+    explicit Batch(size_t count) : out(count * 16) {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+        for (size_t i = 0; i < count; ++i) {
+            float x = value(rng), y = value(rng), z = value(rng), w = value(rng);
+            const float length = std::sqrt(x * x + y * y + z * z + w * w) + 1e-6f;
+            rx.push_back(x / length); ry.push_back(y / length); rz.push_back(z / length); rw.push_back(w / length);
+            px.push_back(value(rng) * 50.0f); py.push_back(value(rng) * 50.0f); pz.push_back(value(rng) * 50.0f);
+            sx.push_back(1.0f + value(rng) * 0.5f); sy.push_back(1.0f); sz.push_back(1.0f + value(rng) * 0.5f);
+        }
+    }
+
+    TransformKernel::TRSArrays Arrays() const {
+        return {px.data(), py.data(), pz.data(), rx.data(), ry.data(), rz.data(), rw.data(),
+                sx.data(), sy.data(), sz.data()};
+    }
+};
+
+void RunPath(TransformKernel::Path path) {
+    if (!TransformKernel::IsPathSupported(path)) {
+        std::printf("  %s not supported on this CPU\n", TransformKernel::GetPathName(path));
+        return;
+    }
+
+    for (size_t count : {size_t(4096), size_t(100000)}) {
+        Batch batch(count);
+        const TransformKernel::TRSArrays arrays = batch.Arrays();
+        const Bench::Result result = Bench::Measure(count > 10000 ? 100 : 2000, [&] {
+            TransformKernel::ComposeTRS(arrays, batch.out.data(), count, path);
+            Bench::Consume(batch.out.data());
+        });
+        Bench::Report(std::string(TransformKernel::GetPathName(path)) + ", " + std::to_string(count) + " matrices",
+                      result, count);
+        std::printf("    %.1f M matrices/s/core\n", static_cast<double>(count) / (result.medianMs * 1000.0));
+    }
+}
+
+} // namespace
+
+SPROUT_BENCH(ComposeTRSScalar) { RunPath(TransformKernel::Path::Scalar); }
+SPROUT_BENCH(ComposeTRSSSE2) { RunPath(TransformKernel::Path::SSE2); }
+SPROUT_BENCH(ComposeTRSAVX2) { RunPath(TransformKernel::Path::AVX2); }
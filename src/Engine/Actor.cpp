@@ -26,76 +26,141 @@ Actor::~Actor() {
         child->DetachFromActor();
     }
 
-    // Clean up components (they'll be destroyed automatically by unique_ptr)
-    components.clear();
+    // Drop this actor and its components from the world's tick registry before they are freed
+    if (world) {
+        world->GetEventBus().UnsubscribeAll(this);
+        world->GetTickRegistry().UnregisterActor(this);
+        for (ActorComponent* component : components) {
+            world->GetTickRegistry().Unregister(component);
+        }
+    }
+
+    // Clean up components (owned by the storage)
+    components.Clear();
+
+    // Release the entity so its id and Transform slot are reused by the next spawn
+    if (world && world->GetRegistry().valid(entity)) {
+        world->GetRegistry().destroy(entity);
+    }
+}
+
+void Actor::operator delete(Actor* actor, std::destroying_delete_t) {
+    // Read before the destructor runs; the slot starts at the most-derived object
+    ObjectPool* pool = actor->sourcePool;
+    void* memory = dynamic_cast<void*>(actor);
+    actor->~Actor();
+    if (pool) {
+        pool->Free(memory);
+    } else {
+        ::operator delete(memory);
+    }
+}
+
+void Actor::SetName(const std::string& newName) {
+    if (newName == name) return;
+
+    std::string oldName = std::move(name);
+    name = newName;
+    if (world) {
+        world->OnActorRenamed(this, oldName);
+    }
 }
 
 glm::vec3 Actor::GetActorLocation() const {
     if (!IsValid()) return glm::vec3(0.0f);
 
     auto& transform = world->GetRegistry().get<Transform>(entity);
-    return transform.position;
+    return transform.GetPosition();
 }
 
 void Actor::SetActorLocation(const glm::vec3& location) {
     if (!IsValid()) return;
 
     auto& transform = world->GetRegistry().get<Transform>(entity);
-    transform.position = location;
+    transform.SetPosition(location);
 }
 
 glm::vec3 Actor::GetActorRotation() const {
     if (!IsValid()) return glm::vec3(0.0f);
 
     auto& transform = world->GetRegistry().get<Transform>(entity);
-    return transform.rotationEuler;
+    return transform.GetRotationEuler();
 }
 
 void Actor::SetActorRotation(const glm::vec3& rotation) {
     if (!IsValid()) return;
 
     auto& transform = world->GetRegistry().get<Transform>(entity);
-    transform.rotationEuler = rotation;
+    transform.SetRotationEuler(rotation);
+}
+
+glm::quat Actor::GetActorQuat() const {
+    if (!IsValid()) return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+    auto& transform = world->GetRegistry().get<Transform>(entity);
+    return transform.GetRotation();
+}
+
+void Actor::SetActorQuat(const glm::quat& rotation) {
+    if (!IsValid()) return;
+
+    auto& transform = world->GetRegistry().get<Transform>(entity);
+    transform.SetRotation(rotation);
+}
+
+void Actor::AddActorLocalRotation(const glm::quat& deltaRotation) {
+    if (!IsValid()) return;
+
+    auto& transform = world->GetRegistry().get<Transform>(entity);
+    transform.Rotate(deltaRotation);
 }
 
 glm::vec3 Actor::GetActorScale() const {
     if (!IsValid()) return glm::vec3(1.0f);
 
     auto& transform = world->GetRegistry().get<Transform>(entity);
-    return transform.scale;
+    return transform.GetScale();
 }
 
 void Actor::SetActorScale(const glm::vec3& scale) {
     if (!IsValid()) return;
 
     auto& transform = world->GetRegistry().get<Transform>(entity);
-    transform.scale = scale;
+    transform.SetScale(scale);
 }
 
 glm::vec3 Actor::GetForwardVector() const {
-    glm::vec3 rotation = GetActorRotation();
-
-    // Convert Euler angles to forward vector
-    float yaw = glm::radians(rotation.y);
-    float pitch = glm::radians(rotation.x);
-
-    return glm::vec3(
-        cos(pitch) * cos(yaw),
-        sin(pitch),
-        cos(pitch) * sin(yaw)
-    );
+    if (!IsValid()) return glm::vec3(0, 0, 1);
+    return world->GetRegistry().get<Transform>(entity).GetForward();
 }
 
 glm::vec3 Actor::GetRightVector() const {
-    glm::vec3 forward = GetForwardVector();
-    glm::vec3 up(0, 1, 0);
-    return glm::normalize(glm::cross(forward, up));
+    if (!IsValid()) return glm::vec3(1, 0, 0);
+    return world->GetRegistry().get<Transform>(entity).GetRight();
 }
 
 glm::vec3 Actor::GetUpVector() const {
-    glm::vec3 forward = GetForwardVector();
-    glm::vec3 right = GetRightVector();
-    return glm::normalize(glm::cross(right, forward));
+    if (!IsValid()) return glm::vec3(0, 1, 0);
+    return world->GetRegistry().get<Transform>(entity).GetUp();
+}
+
+void Actor::SetTickGroup(ETickGroup group) {
+    if (group == tickGroup) return;
+
+    // Re-bucket if already ticking
+    bool wasRegistered = world && tickRegistration.IsRegistered();
+    if (wasRegistered) world->GetTickRegistry().UnregisterActor(this);
+    tickGroup = group;
+    if (wasRegistered) world->GetTickRegistry().RegisterActor(this);
+}
+
+void Actor::SetTickOnGameThreadOnly(bool gameThreadOnly) {
+    if (gameThreadOnly == bTickOnGameThreadOnly) return;
+
+    bool wasRegistered = world && tickRegistration.IsRegistered();
+    if (wasRegistered) world->GetTickRegistry().UnregisterActor(this);
+    bTickOnGameThreadOnly = gameThreadOnly;
+    if (wasRegistered) world->GetTickRegistry().RegisterActor(this);
 }
 
 void Actor::AttachToActor(Actor* parent) {
@@ -120,6 +185,14 @@ void Actor::SetBlueprintClass(const std::string& blueprintPath) {
     blueprintClass = blueprintPath;
 }
 
+void Actor::Serialize(JsonWriter& writer) const {
+    // TODO: Implement serialization
+}
+
+void Actor::Deserialize(const JsonReader& reader) {
+    // TODO: Implement deserialization
+}
+
 void Actor::AddChild(Actor* child) {
     if (child && std::find(children.begin(), children.end(), child) == children.end()) {
         children.push_back(child);
@@ -137,6 +210,75 @@ ActorID Actor::GenerateActorID() {
     return s_rng();
 }
 
+EventBus* Actor::GetEventBus() const {
+    return world ? &world->GetEventBus() : nullptr;
+}
+
+void Actor::OnComponentCreated(ActorComponent* component) {
+    // Components added after BeginPlay still get BeginPlay before their first tick
+    if (!world || !hasBegunPlay) return;
+
+    component->BeginPlay();
+    if (component->IsTickEnabled() && !pendingDestroy) {
+        world->GetTickRegistry().Register(component, component->componentTypeId);
+    }
+}
+
+void Actor::OnComponentRemoving(ActorComponent* component) {
+    if (!world) return;
+
+    world->GetTickRegistry().Unregister(component);
+    if (hasBegunPlay) {
+        component->EndPlay();
+    }
+}
+
+// ActorComponent Implementation
+
+void ActorComponent::operator delete(ActorComponent* component, std::destroying_delete_t) {
+    ObjectPool* pool = component->sourcePool;
+    void* memory = dynamic_cast<void*>(component);
+    component->~ActorComponent();
+    if (pool) {
+        pool->Free(memory);
+    } else {
+        ::operator delete(memory);
+    }
+}
+
+void ActorComponent::SetTickEnabled(bool enabled) {
+    bCanTick = enabled;
+
+    World* ownerWorld = GetWorld();
+    if (!ownerWorld) return;
+
+    if (!enabled) {
+        ownerWorld->GetTickRegistry().Unregister(this);
+    } else if (componentTypeId != InvalidComponentTypeId && owner->HasActorBegunPlay() && !owner->IsPendingDestroy()) {
+        ownerWorld->GetTickRegistry().Register(this, componentTypeId);
+    }
+}
+
+void ActorComponent::SetTickGroup(ETickGroup group) {
+    if (group == tickGroup) return;
+
+    World* ownerWorld = GetWorld();
+    bool wasRegistered = ownerWorld && tickRegistration.IsRegistered();
+    if (wasRegistered) ownerWorld->GetTickRegistry().Unregister(this);
+    tickGroup = group;
+    if (wasRegistered) ownerWorld->GetTickRegistry().Register(this, componentTypeId);
+}
+
+void ActorComponent::SetTickOnGameThreadOnly(bool gameThreadOnly) {
+    if (gameThreadOnly == bTickOnGameThreadOnly) return;
+
+    World* ownerWorld = GetWorld();
+    bool wasRegistered = ownerWorld && tickRegistration.IsRegistered();
+    if (wasRegistered) ownerWorld->GetTickRegistry().Unregister(this);
+    bTickOnGameThreadOnly = gameThreadOnly;
+    if (wasRegistered) ownerWorld->GetTickRegistry().Register(this, componentTypeId);
+}
+
 // SceneComponent Implementation
 
 glm::vec3 SceneComponent::GetWorldLocation() const {
@@ -1,12 +1,17 @@
 #pragma once
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <memory>
 #include <vector>
 #include <string>
-#include <unordered_map>
-#include <typeindex>
 #include <functional>
+#include <atomic>
+#include <new>
+#include "TickRegistry.h"
+#include "EventBus.h"
+#include "ObjectPool.h"
+#include "ComponentStorage.h"
 
 // Forward declarations
 class World;
@@ -16,19 +21,46 @@ class ActorComponent;
 // UUID system for stable references
 using ActorID = uint64_t;
 
+/**
+ * Generational handle to an actor slot in its World
+ * Resolves to null once the actor is destroyed, even if the slot is reused
+ */
+struct ActorHandle {
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsNull() const { return index == InvalidIndex; }
+    bool operator==(const ActorHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const ActorHandle& other) const { return !(*this == other); }
+};
+
 /**
  * Core Actor class - similar to Unreal's AActor
  * Actors are the primary objects in the world that can have components attached
+ *
+ * Every subclass World spawns or queries declares its own `using ThisClass = Class;`,
+ * `using Super = ParentClass;` and StaticClass(), so the World can index it under every
+ * class in its chain (FindActorsOfClass). Inheriting them would file the subclass under
+ * its parent's name; World static_asserts on ThisClass to catch that.
  */
 class Actor {
 public:
     Actor(World* world, const std::string& name = "Actor");
     virtual ~Actor();
 
+    // World::SpawnActor constructs actors in ObjectPools::GetPool<T>() and records the pool;
+    // delete hands the memory back to it. Actors created with a plain new use the heap.
+    static void* operator new(size_t size) { return ::operator new(size); }
+    static void operator delete(void* ptr) { ::operator delete(ptr); }
+    static void operator delete(Actor* actor, std::destroying_delete_t);
+
     // Core properties
     ActorID GetActorID() const { return actorId; }
+    ActorHandle GetHandle() const { return handle; }
     const std::string& GetName() const { return name; }
-    void SetName(const std::string& newName) { name = newName; }
+    void SetName(const std::string& newName);
 
     World* GetWorld() const { return world; }
     entt::entity GetEntity() const { return entity; }
@@ -36,12 +68,16 @@ public:
     // Transform operations
     glm::vec3 GetActorLocation() const;
     void SetActorLocation(const glm::vec3& location);
+    // Euler angles in degrees (as last set, or derived from the stored quaternion)
     glm::vec3 GetActorRotation() const;
     void SetActorRotation(const glm::vec3& rotation);
+    glm::quat GetActorQuat() const;
+    void SetActorQuat(const glm::quat& rotation);
+    void AddActorLocalRotation(const glm::quat& deltaRotation);
     glm::vec3 GetActorScale() const;
     void SetActorScale(const glm::vec3& scale);
 
-    // Transform helpers
+    // Transform helpers (local +Z, +X and +Y of the actor's rotation)
     glm::vec3 GetForwardVector() const;
     glm::vec3 GetRightVector() const;
     glm::vec3 GetUpVector() const;
@@ -71,7 +107,16 @@ public:
     virtual void Tick(float deltaTime) {}
     virtual void Destroyed() {}
 
-    // Event system
+    // Tick scheduling. Ticks run on the game thread unless the actor opts in with
+    // SetTickOnGameThreadOnly(false); a parallel Tick may only touch this actor's own
+    // state and entity, and may destroy actors but not spawn them.
+    ETickGroup GetTickGroup() const { return tickGroup; }
+    void SetTickGroup(ETickGroup group);
+    bool IsTickOnGameThreadOnly() const { return bTickOnGameThreadOnly; }
+    void SetTickOnGameThreadOnly(bool gameThreadOnly);
+
+    // Event system. Bindings live on the world's EventBus until the actor is destroyed;
+    // TriggerEvent delivers immediately to this actor's bindings only.
     template<typename EventType>
     void BindEvent(std::function<void(const EventType&)> callback);
 
@@ -89,15 +134,18 @@ public:
     // Utility
     bool IsValid() const { return world != nullptr && entity != entt::null; }
     void MarkForDestroy() { pendingDestroy = true; }
-    bool IsPendingDestroy() const { return pendingDestroy; }
+    bool IsPendingDestroy() const { return pendingDestroy.load(std::memory_order_relaxed); }
+    bool HasActorBegunPlay() const { return hasBegunPlay; }
 
     // Static class info (for blueprint system)
+    using ThisClass = Actor;
     static std::string StaticClass() { return "Actor"; }
 
 protected:
     World* world;
     entt::entity entity;
     ActorID actorId;
+    ActorHandle handle;
     std::string name;
     std::string blueprintClass;
 
@@ -105,22 +153,45 @@ protected:
     Actor* parent = nullptr;
     std::vector<Actor*> children;
 
-    // Component management
-    std::unordered_map<std::type_index, std::unique_ptr<ActorComponent>> components;
+    // World class-index buckets this actor lives in (one per class in its Super chain).
+    // Stored inline so spawning does not allocate; SpawnActor checks the chain depth.
+    static constexpr size_t MaxClassDepth = 8;
+    struct ClassBucketEntry {
+        std::vector<Actor*>* bucket;
+        uint32_t slot;
+    };
+    ClassBucketEntry classBuckets[MaxClassDepth];
+    uint32_t classBucketCount = 0;
 
-    // Event bindings
-    std::unordered_map<std::type_index, std::vector<std::function<void(const void*)>>> eventBindings;
+    // Component management (inline, keyed by ComponentTypeId)
+    ComponentStorage components;
 
     // State
-    bool pendingDestroy = false;
+    std::atomic<bool> pendingDestroy{false};
     bool hasBegunPlay = false;
 
+    // Tick scheduling
+    ETickGroup tickGroup = ETickGroup::PrePhysics;
+    bool bTickOnGameThreadOnly = true;
+    TickRegistration tickRegistration;
+
+    // Pool this actor's memory came from (null: heap)
+    ObjectPool* sourcePool = nullptr;
+
     // Internal methods
     void AddChild(Actor* child);
     void RemoveChild(Actor* child);
     static ActorID GenerateActorID();
 
+    // Keeps late-added/removed components in step with BeginPlay/EndPlay and the tick registry
+    void OnComponentCreated(ActorComponent* component);
+    void OnComponentRemoving(ActorComponent* component);
+
+    // The owning world's bus (World is incomplete here, so the templates go through this)
+    EventBus* GetEventBus() const;
+
     friend class World;
+    friend class TickRegistry;
 };
 
 /**
@@ -131,6 +202,11 @@ public:
     ActorComponent(Actor* owner) : owner(owner) {}
     virtual ~ActorComponent() = default;
 
+    // Pooled like actors: Actor::CreateComponent uses ObjectPools::GetPool<T>()
+    static void* operator new(size_t size) { return ::operator new(size); }
+    static void operator delete(void* ptr) { ::operator delete(ptr); }
+    static void operator delete(ActorComponent* component, std::destroying_delete_t);
+
     Actor* GetOwner() const { return owner; }
     World* GetWorld() const { return owner ? owner->GetWorld() : nullptr; }
 
@@ -145,11 +221,30 @@ public:
 
     // Component properties
     bool IsTickEnabled() const { return bCanTick; }
-    void SetTickEnabled(bool enabled) { bCanTick = enabled; }
+    void SetTickEnabled(bool enabled);
+
+    // Same contract as the Actor tick settings (game thread unless opted in)
+    ETickGroup GetTickGroup() const { return tickGroup; }
+    void SetTickGroup(ETickGroup group);
+    bool IsTickOnGameThreadOnly() const { return bTickOnGameThreadOnly; }
+    void SetTickOnGameThreadOnly(bool gameThreadOnly);
 
 protected:
     Actor* owner;
     bool bCanTick = false;
+    ETickGroup tickGroup = ETickGroup::PrePhysics;
+    bool bTickOnGameThreadOnly = true;
+
+private:
+    // Tick registry bookkeeping
+    ComponentTypeId componentTypeId = InvalidComponentTypeId;
+    TickRegistration tickRegistration;
+
+    ObjectPool* sourcePool = nullptr;
+
+    friend class Actor;
+    friend class World;
+    friend class TickRegistry;
 };
 
 /**
@@ -201,54 +296,51 @@ template<typename T, typename... Args>
 T* Actor::CreateComponent(Args&&... args) {
     static_assert(std::is_base_of_v<ActorComponent, T>, "T must derive from ActorComponent");
 
-    auto component = std::make_unique<T>(this, std::forward<Args>(args)...);
+    std::unique_ptr<T> component(ObjectPools::New<T>(this, std::forward<Args>(args)...));
     T* ptr = component.get();
+    ptr->sourcePool = &ObjectPools::GetPool<T>();
+    const ComponentTypeId typeId = GetComponentTypeId<T>();
+    ptr->componentTypeId = typeId;
 
-    std::type_index typeIndex(typeid(T));
-    components[typeIndex] = std::move(component);
+    if (ActorComponent* existing = components.Find(typeId)) {
+        OnComponentRemoving(existing);
+    }
+    components.Set(typeId, std::move(component));
 
+    OnComponentCreated(ptr);
     return ptr;
 }
 
 template<typename T>
 T* Actor::GetComponent() const {
     static_assert(std::is_base_of_v<ActorComponent, T>, "T must derive from ActorComponent");
-
-    std::type_index typeIndex(typeid(T));
-    auto it = components.find(typeIndex);
-    if (it != components.end()) {
-        return static_cast<T*>(it->second.get());
-    }
-    return nullptr;
+    return static_cast<T*>(components.Find(GetComponentTypeId<T>()));
 }
 
 template<typename T>
 bool Actor::HasComponent() const {
-    std::type_index typeIndex(typeid(T));
-    return components.find(typeIndex) != components.end();
+    return components.Find(GetComponentTypeId<T>()) != nullptr;
 }
 
 template<typename T>
 void Actor::RemoveComponent() {
-    std::type_index typeIndex(typeid(T));
-    components.erase(typeIndex);
+    const ComponentTypeId typeId = GetComponentTypeId<T>();
+    if (ActorComponent* existing = components.Find(typeId)) {
+        OnComponentRemoving(existing);
+        components.Remove(typeId);
+    }
 }
 
 template<typename EventType>
 void Actor::BindEvent(std::function<void(const EventType&)> callback) {
-    std::type_index typeIndex(typeid(EventType));
-    eventBindings[typeIndex].push_back([callback](const void* eventPtr) {
-        callback(*static_cast<const EventType*>(eventPtr));
-    });
+    if (EventBus* bus = GetEventBus()) {
+        bus->Subscribe<EventType>(this, std::move(callback));
+    }
 }
 
 template<typename EventType>
 void Actor::TriggerEvent(const EventType& event) {
-    std::type_index typeIndex(typeid(EventType));
-    auto it = eventBindings.find(typeIndex);
-    if (it != eventBindings.end()) {
-        for (auto& binding : it->second) {
-            binding(&event);
-        }
+    if (EventBus* bus = GetEventBus()) {
+        bus->DispatchTo<EventType>(this, event);
     }
 }
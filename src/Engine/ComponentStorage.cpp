@@ -0,0 +1,132 @@
+#include "ComponentStorage.h"
+#include "Actor.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+    std::atomic<ComponentTypeId> s_componentTypeCount{0};
+}
+
+ComponentTypeId AllocateComponentTypeId() {
+    return s_componentTypeCount.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+ComponentTypeId GetComponentTypeCount() {
+    return s_componentTypeCount.load(std::memory_order_relaxed);
+}
+
+std::unique_ptr<ActorComponent> ComponentStorage::Set(ComponentTypeId id, std::unique_ptr<ActorComponent> component) {
+    if (id == InvalidComponentTypeId || !component) return component;
+
+    if (IsInline()) {
+        int index = FindInline(id);
+        if (index >= 0) {
+            std::unique_ptr<ActorComponent> previous(inlineComponents[index]);
+            inlineComponents[index] = component.release();
+            return previous;
+        }
+        if (count < InlineCapacity) {
+            inlineIds[count] = id;
+            inlineComponents[count] = component.release();
+            ++count;
+            return nullptr;
+        }
+        MoveToSorted();
+    }
+
+    size_t index = LowerBound(id);
+    if (index < sortedIds.size() && sortedIds[index] == id) {
+        std::unique_ptr<ActorComponent> previous(sortedComponents[index]);
+        sortedComponents[index] = component.release();
+        return previous;
+    }
+    sortedIds.insert(sortedIds.begin() + index, id);
+    sortedComponents.insert(sortedComponents.begin() + index, component.release());
+    ++count;
+    return nullptr;
+}
+
+std::unique_ptr<ActorComponent> ComponentStorage::Remove(ComponentTypeId id) {
+    if (id == InvalidComponentTypeId) return nullptr;
+
+    if (IsInline()) {
+        int index = FindInline(id);
+        if (index < 0) return nullptr;
+
+        // Swap-and-pop, keeping unused id slots invalid for the SIMD search
+        std::unique_ptr<ActorComponent> removed(inlineComponents[index]);
+        size_t last = count - 1;
+        inlineIds[index] = inlineIds[last];
+        inlineComponents[index] = inlineComponents[last];
+        inlineIds[last] = InvalidComponentTypeId;
+        inlineComponents[last] = nullptr;
+        --count;
+        return removed;
+    }
+
+    size_t index = LowerBound(id);
+    if (index >= sortedIds.size() || sortedIds[index] != id) return nullptr;
+
+    std::unique_ptr<ActorComponent> removed(sortedComponents[index]);
+    sortedIds.erase(sortedIds.begin() + index);
+    sortedComponents.erase(sortedComponents.begin() + index);
+    --count;
+    if (count <= InlineCapacity) {
+        MoveToInline();
+    }
+    return removed;
+}
+
+void ComponentStorage::Clear() {
+    // Detach everything first so a component destructor never sees a half-cleared storage
+    ActorComponent* inlineOwned[InlineCapacity] = {};
+    std::vector<ActorComponent*> sortedOwned;
+    if (IsInline()) {
+        std::copy(inlineComponents, inlineComponents + count, inlineOwned);
+        std::fill(std::begin(inlineIds), std::end(inlineIds), InvalidComponentTypeId);
+        std::fill(std::begin(inlineComponents), std::end(inlineComponents), nullptr);
+    } else {
+        sortedOwned.swap(sortedComponents);
+        std::vector<ComponentTypeId>().swap(sortedIds);
+    }
+    count = 0;
+
+    for (ActorComponent* component : inlineOwned) {
+        delete component;
+    }
+    for (ActorComponent* component : sortedOwned) {
+        delete component;
+    }
+}
+
+size_t ComponentStorage::LowerBound(ComponentTypeId id) const {
+    return static_cast<size_t>(std::lower_bound(sortedIds.begin(), sortedIds.end(), id) - sortedIds.begin());
+}
+
+void ComponentStorage::MoveToSorted() {
+    std::vector<std::pair<ComponentTypeId, ActorComponent*>> entries;
+    entries.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        entries.emplace_back(inlineIds[i], inlineComponents[i]);
+        inlineIds[i] = InvalidComponentTypeId;
+        inlineComponents[i] = nullptr;
+    }
+    std::sort(entries.begin(), entries.end());
+
+    sortedIds.reserve(InlineCapacity * 2);
+    sortedComponents.reserve(InlineCapacity * 2);
+    for (const auto& [id, component] : entries) {
+        sortedIds.push_back(id);
+        sortedComponents.push_back(component);
+    }
+}
+
+void ComponentStorage::MoveToInline() {
+    for (size_t i = 0; i < sortedIds.size(); ++i) {
+        inlineIds[i] = sortedIds[i];
+        inlineComponents[i] = sortedComponents[i];
+    }
+    // Releases the memory too; the vectors being empty is what marks inline mode
+    std::vector<ComponentTypeId>().swap(sortedIds);
+    std::vector<ActorComponent*>().swap(sortedComponents);
+}
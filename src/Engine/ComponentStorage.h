@@ -0,0 +1,112 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPROUT_COMPONENT_SEARCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+class ActorComponent;
+
+// Dense per-class component id, assigned on first use (0 is never a valid id)
+using ComponentTypeId = uint32_t;
+constexpr ComponentTypeId InvalidComponentTypeId = 0;
+
+ComponentTypeId AllocateComponentTypeId();
+
+template<typename ComponentType>
+ComponentTypeId GetComponentTypeId() {
+    static const ComponentTypeId id = AllocateComponentTypeId();
+    return id;
+}
+
+// Number of ids handed out so far (valid ids are 1..count)
+ComponentTypeId GetComponentTypeCount();
+
+/**
+ * ComponentStorage - an actor's components keyed by ComponentTypeId
+ * Up to InlineCapacity components live in an inline array of ids that is searched
+ * 8 at a time with a SIMD compare; past that everything moves to a vector sorted by id
+ * and searched by binary search. Owns the components. Iteration order is unspecified.
+ */
+class ComponentStorage {
+public:
+    static constexpr size_t InlineCapacity = 8;
+
+    ComponentStorage() = default;
+    ~ComponentStorage() { Clear(); }
+
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    ActorComponent* Find(ComponentTypeId id) const;
+
+    // Stores component under id and returns whatever was there before (null if nothing)
+    std::unique_ptr<ActorComponent> Set(ComponentTypeId id, std::unique_ptr<ActorComponent> component);
+
+    // Takes the component stored under id out of the storage (null if none)
+    std::unique_ptr<ActorComponent> Remove(ComponentTypeId id);
+
+    void Clear();
+
+    size_t Size() const { return count; }
+    bool Empty() const { return count == 0; }
+
+    // Contiguous over all stored components
+    ActorComponent* const* begin() const { return IsInline() ? inlineComponents : sortedComponents.data(); }
+    ActorComponent* const* end() const { return begin() + count; }
+
+private:
+    bool IsInline() const { return sortedIds.empty(); }
+
+    // Index in the inline array, or -1
+    int FindInline(ComponentTypeId id) const;
+    // Index of the first sorted id >= id
+    size_t LowerBound(ComponentTypeId id) const;
+
+    void MoveToSorted();
+    void MoveToInline();
+
+    // Inline mode: unused id slots hold InvalidComponentTypeId
+    alignas(16) ComponentTypeId inlineIds[InlineCapacity] = {};
+    ActorComponent* inlineComponents[InlineCapacity] = {};
+
+    // Sorted mode (more than InlineCapacity components): parallel arrays ordered by id
+    std::vector<ComponentTypeId> sortedIds;
+    std::vector<ActorComponent*> sortedComponents;
+
+    size_t count = 0;
+};
+
+inline int ComponentStorage::FindInline(ComponentTypeId id) const {
+#if SPROUT_COMPONENT_SEARCH_SSE2
+    static_assert(InlineCapacity == 8 && sizeof(ComponentTypeId) == 4, "SIMD search expects 8 x 32-bit ids");
+    const __m128i key = _mm_set1_epi32(static_cast<int>(id));
+    const __m128i lo = _mm_cmpeq_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(inlineIds)), key);
+    const __m128i hi = _mm_cmpeq_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(inlineIds + 4)), key);
+    const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(lo))) |
+                          (static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(hi))) << 4);
+    return mask ? std::countr_zero(mask) : -1;
+#else
+    for (size_t i = 0; i < count; ++i) {
+        if (inlineIds[i] == id) return static_cast<int>(i);
+    }
+    return -1;
+#endif
+}
+
+inline ActorComponent* ComponentStorage::Find(ComponentTypeId id) const {
+    if (id == InvalidComponentTypeId) return nullptr;
+
+    if (IsInline()) {
+        int index = FindInline(id);
+        return index >= 0 ? inlineComponents[index] : nullptr;
+    }
+
+    size_t index = LowerBound(id);
+    return (index < sortedIds.size() && sortedIds[index] == id) ? sortedComponents[index] : nullptr;
+}
@@ -1,12 +1,9 @@
 #pragma once
 #include <string>
 #include <glm/glm.hpp>
+#include "Transform.h"
 
-struct Transform {
-    glm::vec3 position{0.0f};
-    glm::vec3 rotationEuler{0.0f}; // degrees
-    glm::vec3 scale{1.0f};
-};
+struct LoadedScript;
 
 struct NameComponent {
     std::string name{"Entity"};
@@ -22,8 +19,13 @@ struct Script {
     std::string filePath;        // e.g. assets/scripts/Rotate.lua
     double      lastUpdateTime{0.0}; // hot-reload tracking
     bool needsUpdate{false};
+    LoadedScript* loaded{nullptr}; // set by Scripting; shared by every entity running filePath
 };
 
+// Tag: Scripting skips this entity's OnTick/OnTickBatch. Set for scripts without a tick
+// function and by SetTickEnabled(id, false) (entities driven only by latent actions).
+struct ScriptTickDisabled {};
+
 // Blueprint asset component - stores path to generated blueprint/script
 struct BlueprintComponent {
     std::string filePath; // e.g. assets/scripts/generated/my_blueprint.lua
@@ -0,0 +1,50 @@
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+    CpuFeatures Detect() {
+        CpuFeatures features;
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4] = {};
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        features.sse2 = (info[3] & (1 << 26)) != 0;
+        features.sse41 = (info[2] & (1 << 19)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool cpuAvx = (info[2] & (1 << 28)) != 0;
+        const bool cpuFma = (info[2] & (1 << 12)) != 0;
+
+        // XMM and YMM state must both be enabled by the OS
+        const bool osYmm = osxsave && (_xgetbv(0) & 0x6) == 0x6;
+        features.avx = cpuAvx && osYmm;
+        features.fma = cpuFma && osYmm;
+
+        if (maxLeaf >= 7) {
+            __cpuidex(info, 7, 0);
+            features.avx2 = features.avx && (info[1] & (1 << 5)) != 0;
+        }
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        // libgcc's checks include the OS XSAVE support for AVX
+        __builtin_cpu_init();
+        features.sse2 = __builtin_cpu_supports("sse2");
+        features.sse41 = __builtin_cpu_supports("sse4.1");
+        features.avx = __builtin_cpu_supports("avx");
+        features.avx2 = __builtin_cpu_supports("avx2");
+        features.fma = __builtin_cpu_supports("fma");
+#endif
+
+        return features;
+    }
+}
+
+const CpuFeatures& CpuFeatures::Get() {
+    static const CpuFeatures features = Detect();
+    return features;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * CpuFeatures - instruction set extensions usable on this machine
+ * Detected once on first use. AVX/AVX2 also require the OS to save YMM state.
+ */
+struct CpuFeatures {
+    bool sse2 = false;
+    bool sse41 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+
+    static const CpuFeatures& Get();
+};
@@ -33,9 +33,10 @@ void Editor::drawDockspace(){
     ImGui::DockSpaceOverViewport(0, ImGui::GetMainViewport());
 }
 
-static void Vec3Control(const char* label, glm::vec3& v){
+static bool Vec3Control(const char* label, glm::vec3& v){
     float arr[3] = {v.x, v.y, v.z};
-    if(ImGui::DragFloat3(label, arr, 0.1f)) { v = {arr[0],arr[1],arr[2]}; }
+    if(ImGui::DragFloat3(label, arr, 0.1f)) { v = {arr[0],arr[1],arr[2]}; return true; }
+    return false;
 }
 
 void Editor::drawPanels(entt::registry& reg, Renderer& renderer, Scripting& scripting, bool& playMode){
@@ -78,9 +79,12 @@ void Editor::drawPanels(entt::registry& reg, Renderer& renderer, Scripting& scri
             if(ImGui::InputText("Name", buf, sizeof(buf))) tag->name = buf;
         }
         if(auto* tr = reg.try_get<Transform>(selected)){
-            Vec3Control("Position", tr->position);
-            Vec3Control("Rotation (deg)", tr->rotationEuler);
-            Vec3Control("Scale", tr->scale);
+            glm::vec3 position = tr->GetPosition();
+            if(Vec3Control("Position", position)) tr->SetPosition(position);
+            glm::vec3 euler = tr->GetRotationEuler();
+            if(Vec3Control("Rotation (deg)", euler)) tr->SetRotationEuler(euler);
+            glm::vec3 scale = tr->GetScale();
+            if(Vec3Control("Scale", scale)) tr->SetScale(scale);
         }
         if(auto* sc = reg.try_get<Script>(selected)){
             char pathBuf[256]; std::snprintf(pathBuf, sizeof(pathBuf), "%s", sc->filePath.c_str());
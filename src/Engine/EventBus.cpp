@@ -0,0 +1,144 @@
+#include "EventBus.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+    // Guards against handlers that re-post the event they are handling forever
+    constexpr int MaxFlushPasses = 16;
+}
+
+EventTypeId EventBus::AllocateEventTypeId() {
+    static std::atomic<EventTypeId> nextId{0};
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+EventBus::~EventBus() {
+    Clear();
+}
+
+void EventBus::UnsubscribeAll(Owner owner) {
+    if (dispatchDepth > 0) {
+        // Stop delivery right away, remove once the dispatch in flight returns
+        deferredSubscribes.erase(std::remove_if(deferredSubscribes.begin(), deferredSubscribes.end(),
+                                                [owner](const DeferredSubscribe& pending) {
+                                                    return pending.owner == owner;
+                                                }),
+                                 deferredSubscribes.end());
+
+        auto it = ownerSubscriptions.find(owner);
+        if (it == ownerSubscriptions.end()) return;
+        for (const SubscriptionRef& ref : it->second) {
+            channels[ref.type]->MarkDead(ref.slot);
+        }
+        deferredUnsubscribes.push_back(owner);
+        return;
+    }
+
+    RemoveOwner(owner);
+}
+
+void EventBus::RemoveOwner(Owner owner) {
+    auto it = ownerSubscriptions.find(owner);
+    if (it == ownerSubscriptions.end()) return;
+
+    std::vector<SubscriptionRef> refs = std::move(it->second);
+    ownerSubscriptions.erase(it);
+
+    // Highest slots first so a swap-and-pop never moves one of our own entries
+    std::sort(refs.begin(), refs.end(), [](const SubscriptionRef& a, const SubscriptionRef& b) {
+        return a.slot > b.slot;
+    });
+
+    for (const SubscriptionRef& ref : refs) {
+        ChannelBase& channel = *channels[ref.type];
+        uint32_t movedFrom = static_cast<uint32_t>(channel.Size() - 1);
+        Owner moved = channel.RemoveAt(ref.slot);
+        if (!moved) continue;
+
+        // Point the moved subscriber's owner at its new slot
+        auto movedIt = ownerSubscriptions.find(moved);
+        if (movedIt == ownerSubscriptions.end()) continue;
+        for (SubscriptionRef& movedRef : movedIt->second) {
+            if (movedRef.type == ref.type && movedRef.slot == movedFrom) {
+                movedRef.slot = ref.slot;
+                break;
+            }
+        }
+    }
+}
+
+void EventBus::Enqueue(EventTypeId type, size_t size, size_t alignment,
+                       void (*construct)(void*, const void*), void (*destroy)(void*), const void* event) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    void* payload = arena.Allocate(size, alignment);
+    construct(payload, event);
+    queue.push_back(QueuedEvent{type, payload, destroy});
+}
+
+void EventBus::Flush() {
+    std::vector<QueuedEvent> batch;
+
+    for (int pass = 0; pass < MaxFlushPasses; ++pass) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (queue.empty()) break;
+            batch.swap(queue);
+        }
+
+        ++dispatchDepth;
+        for (const QueuedEvent& queued : batch) {
+            if (ChannelBase* channel = channels[queued.type].get()) {
+                channel->DispatchErased(queued.payload);
+            }
+        }
+        EndDispatch();
+
+        for (const QueuedEvent& queued : batch) {
+            if (queued.destroy) queued.destroy(queued.payload);
+        }
+        batch.clear();
+    }
+
+    // Anything still queued is left for the next flush and keeps its arena storage
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (queue.empty()) {
+        arena.Reset();
+    }
+}
+
+void EventBus::Clear() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (const QueuedEvent& queued : queue) {
+            if (queued.destroy) queued.destroy(queued.payload);
+        }
+        queue.clear();
+        arena.Reset();
+    }
+
+    channels.clear();
+    ownerSubscriptions.clear();
+    deferredSubscribes.clear();
+    deferredUnsubscribes.clear();
+}
+
+size_t EventBus::GetQueuedCount() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return queue.size();
+}
+
+void EventBus::EndDispatch() {
+    if (--dispatchDepth > 0) return;
+
+    std::vector<Owner> unsubscribes;
+    unsubscribes.swap(deferredUnsubscribes);
+    for (Owner owner : unsubscribes) {
+        RemoveOwner(owner);
+    }
+
+    std::vector<DeferredSubscribe> subscribes;
+    subscribes.swap(deferredSubscribes);
+    for (DeferredSubscribe& subscribe : subscribes) {
+        subscribe.apply();
+    }
+}
@@ -0,0 +1,254 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "FrameArena.h"
+
+// Dense per-process id for each event type, assigned on first use
+using EventTypeId = uint32_t;
+
+/**
+ * EventBus - typed publish/subscribe with per-event-type subscriber lists
+ * Each event type gets its own channel holding only the handlers bound to that type,
+ * so a dispatch walks exactly its subscribers and nothing else.
+ *
+ * Post() copies the event into frame-local arena storage and queues it; queued events
+ * are dispatched in post order by Flush(), which the World calls at fixed points in its
+ * tick. Dispatch()/DispatchTo() deliver immediately instead.
+ *
+ * Post() may be called from any thread. Subscribing, unsubscribing, Flush() and the
+ * immediate dispatch calls are game-thread only.
+ */
+class EventBus {
+public:
+    // Subscriptions are keyed by owner so they can be dropped together (e.g. on actor destroy)
+    using Owner = const void*;
+
+    EventBus() = default;
+    ~EventBus();
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    template<typename EventType>
+    void Subscribe(Owner owner, std::function<void(const EventType&)> handler);
+
+    // Removes every handler registered by owner, across all event types
+    void UnsubscribeAll(Owner owner);
+
+    // Queued: copied now, dispatched at the next Flush()
+    template<typename EventType>
+    void Post(const EventType& event);
+
+    // Immediate: runs every subscriber of EventType before returning
+    template<typename EventType>
+    void Dispatch(const EventType& event);
+
+    // Immediate, but only to the handlers registered by owner
+    template<typename EventType>
+    void DispatchTo(Owner owner, const EventType& event);
+
+    // Dispatches everything queued, including events posted by handlers during the flush
+    void Flush();
+
+    // Drops all subscriptions and queued events
+    void Clear();
+
+    template<typename EventType>
+    size_t GetSubscriberCount() const;
+    size_t GetQueuedCount() const;
+
+    template<typename EventType>
+    static EventTypeId GetEventTypeId() {
+        static const EventTypeId id = AllocateEventTypeId();
+        return id;
+    }
+
+private:
+    class ChannelBase {
+    public:
+        virtual ~ChannelBase() = default;
+        virtual void DispatchErased(const void* event) = 0;
+        virtual void DispatchSlotErased(uint32_t slot, const void* event) = 0;
+        virtual void MarkDead(uint32_t slot) = 0;
+        // Swap-and-pop; returns the owner of the subscriber moved into slot (null if none moved)
+        virtual Owner RemoveAt(uint32_t slot) = 0;
+        virtual size_t Size() const = 0;
+    };
+
+    template<typename EventType>
+    class Channel final : public ChannelBase {
+    public:
+        struct Subscriber {
+            Owner owner;
+            bool alive;
+            std::function<void(const EventType&)> handler;
+        };
+        std::vector<Subscriber> subscribers;
+
+        void Dispatch(const EventType& event) {
+            // Subscriber changes are deferred while dispatching, so the vector stays put
+            for (Subscriber& subscriber : subscribers) {
+                if (subscriber.alive) subscriber.handler(event);
+            }
+        }
+
+        void DispatchErased(const void* event) override {
+            Dispatch(*static_cast<const EventType*>(event));
+        }
+
+        void DispatchSlotErased(uint32_t slot, const void* event) override {
+            if (subscribers[slot].alive) subscribers[slot].handler(*static_cast<const EventType*>(event));
+        }
+
+        void MarkDead(uint32_t slot) override { subscribers[slot].alive = false; }
+
+        Owner RemoveAt(uint32_t slot) override {
+            Owner moved = nullptr;
+            if (slot + 1 != subscribers.size()) {
+                subscribers[slot] = std::move(subscribers.back());
+                moved = subscribers[slot].owner;
+            }
+            subscribers.pop_back();
+            return moved;
+        }
+
+        size_t Size() const override { return subscribers.size(); }
+    };
+
+    // Where one of an owner's handlers lives
+    struct SubscriptionRef {
+        EventTypeId type;
+        uint32_t slot;
+    };
+
+    struct QueuedEvent {
+        EventTypeId type;
+        void* payload;
+        void (*destroy)(void*);
+    };
+
+    // Indexed by EventTypeId; null until the first subscription of that type
+    std::vector<std::unique_ptr<ChannelBase>> channels;
+    std::unordered_map<Owner, std::vector<SubscriptionRef>> ownerSubscriptions;
+
+    // Handlers may subscribe/unsubscribe while we dispatch; applied once the outermost dispatch returns
+    int dispatchDepth = 0;
+    struct DeferredSubscribe {
+        Owner owner;
+        std::function<void()> apply;
+    };
+    std::vector<DeferredSubscribe> deferredSubscribes;
+    std::vector<Owner> deferredUnsubscribes;
+
+    mutable std::mutex queueMutex;
+    std::vector<QueuedEvent> queue;
+    FrameArena arena;
+
+    static EventTypeId AllocateEventTypeId();
+
+    template<typename EventType>
+    Channel<EventType>& GetOrCreateChannel();
+    template<typename EventType>
+    Channel<EventType>* FindChannel() const;
+
+    void Enqueue(EventTypeId type, size_t size, size_t alignment,
+                 void (*construct)(void*, const void*), void (*destroy)(void*), const void* event);
+    void RemoveOwner(Owner owner);
+    void EndDispatch();
+};
+
+// Template implementations
+template<typename EventType>
+EventBus::Channel<EventType>& EventBus::GetOrCreateChannel() {
+    EventTypeId id = GetEventTypeId<EventType>();
+    if (id >= channels.size()) {
+        channels.resize(id + 1);
+    }
+    if (!channels[id]) {
+        channels[id] = std::make_unique<Channel<EventType>>();
+    }
+    return static_cast<Channel<EventType>&>(*channels[id]);
+}
+
+template<typename EventType>
+EventBus::Channel<EventType>* EventBus::FindChannel() const {
+    EventTypeId id = GetEventTypeId<EventType>();
+    if (id >= channels.size()) return nullptr;
+    return static_cast<Channel<EventType>*>(channels[id].get());
+}
+
+template<typename EventType>
+void EventBus::Subscribe(Owner owner, std::function<void(const EventType&)> handler) {
+    if (!handler) return;
+
+    if (dispatchDepth > 0) {
+        deferredSubscribes.push_back({owner, [this, owner, handler = std::move(handler)]() mutable {
+            Subscribe<EventType>(owner, std::move(handler));
+        }});
+        return;
+    }
+
+    Channel<EventType>& channel = GetOrCreateChannel<EventType>();
+    uint32_t slot = static_cast<uint32_t>(channel.subscribers.size());
+    channel.subscribers.push_back({owner, true, std::move(handler)});
+    ownerSubscriptions[owner].push_back({GetEventTypeId<EventType>(), slot});
+}
+
+template<typename EventType>
+void EventBus::Post(const EventType& event) {
+    static_assert(std::is_copy_constructible_v<EventType>, "Posted events are copied into the queue");
+
+    // Nobody listening: nothing to store
+    Channel<EventType>* channel = FindChannel<EventType>();
+    if (!channel || channel->subscribers.empty()) return;
+
+    void (*destroy)(void*) = nullptr;
+    if constexpr (!std::is_trivially_destructible_v<EventType>) {
+        destroy = [](void* payload) { static_cast<EventType*>(payload)->~EventType(); };
+    }
+
+    Enqueue(GetEventTypeId<EventType>(), sizeof(EventType), alignof(EventType),
+            [](void* storage, const void* source) {
+                new (storage) EventType(*static_cast<const EventType*>(source));
+            },
+            destroy, &event);
+}
+
+template<typename EventType>
+void EventBus::Dispatch(const EventType& event) {
+    Channel<EventType>* channel = FindChannel<EventType>();
+    if (!channel) return;
+
+    ++dispatchDepth;
+    channel->Dispatch(event);
+    EndDispatch();
+}
+
+template<typename EventType>
+void EventBus::DispatchTo(Owner owner, const EventType& event) {
+    auto it = ownerSubscriptions.find(owner);
+    if (it == ownerSubscriptions.end()) return;
+
+    const EventTypeId id = GetEventTypeId<EventType>();
+    Channel<EventType>* channel = FindChannel<EventType>();
+    if (!channel) return;
+
+    ++dispatchDepth;
+    for (const SubscriptionRef& ref : it->second) {
+        if (ref.type == id) channel->DispatchSlotErased(ref.slot, &event);
+    }
+    EndDispatch();
+}
+
+template<typename EventType>
+size_t EventBus::GetSubscriberCount() const {
+    Channel<EventType>* channel = FindChannel<EventType>();
+    return channel ? channel->subscribers.size() : 0;
+}
@@ -0,0 +1,193 @@
+#include "FileWatcher.h"
+#include "FileUtil.h"
+#include <filesystem>
+
+#if defined(__linux__)
+#define SPROUT_FILE_WATCHER_INOTIFY 1
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::string GetDirectoryOf(const std::string& normalizedPath) {
+        std::string directory = fs::path(normalizedPath).parent_path().generic_string();
+        return directory.empty() ? "." : directory;
+    }
+
+    std::string JoinPath(const std::string& directory, const std::string& name) {
+        return directory == "." ? name : directory + "/" + name;
+    }
+
+#if SPROUT_FILE_WATCHER_INOTIFY
+    constexpr uint32_t WatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MODIFY;
+#endif
+}
+
+FileWatcher::FileWatcher(double debounceSeconds, double pollIntervalSeconds)
+    : debounce(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(debounceSeconds))),
+      pollInterval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(pollIntervalSeconds))),
+      lastPoll(Clock::now()) {
+#if SPROUT_FILE_WATCHER_INOTIFY
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#if SPROUT_FILE_WATCHER_INOTIFY
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+    }
+#endif
+}
+
+std::string FileWatcher::NormalizePath(const std::string& path) {
+    return fs::path(path).lexically_normal().generic_string();
+}
+
+void FileWatcher::Watch(const std::string& path) {
+    if (path.empty()) return;
+
+    std::string key = NormalizePath(path);
+    auto [it, inserted] = files.try_emplace(key);
+    if (!inserted) return;
+
+    WatchedFile& file = it->second;
+    file.directory = GetDirectoryOf(key);
+    file.lastWriteTime = GetFileWriteTime(key);
+
+    WatchedDirectory& directory = directories[file.directory];
+    ++directory.fileCount;
+#if SPROUT_FILE_WATCHER_INOTIFY
+    if (inotifyFd >= 0 && directory.descriptor < 0) {
+        directory.descriptor = inotify_add_watch(inotifyFd, file.directory.c_str(), WatchMask);
+        if (directory.descriptor >= 0) {
+            directoryByDescriptor[directory.descriptor] = file.directory;
+        }
+    }
+#endif
+}
+
+void FileWatcher::Unwatch(const std::string& path) {
+    auto it = files.find(NormalizePath(path));
+    if (it == files.end()) return;
+
+    auto dirIt = directories.find(it->second.directory);
+    if (dirIt != directories.end() && --dirIt->second.fileCount == 0) {
+#if SPROUT_FILE_WATCHER_INOTIFY
+        if (dirIt->second.descriptor >= 0) {
+            inotify_rm_watch(inotifyFd, dirIt->second.descriptor);
+            directoryByDescriptor.erase(dirIt->second.descriptor);
+        }
+#endif
+        directories.erase(dirIt);
+    }
+    files.erase(it);
+}
+
+bool FileWatcher::IsWatching(const std::string& path) const {
+    return files.count(NormalizePath(path)) != 0;
+}
+
+void FileWatcher::Poll(std::vector<std::string>& changedPaths) {
+    const Clock::time_point now = Clock::now();
+
+    ReadNativeEvents(now);
+    if (now - lastPoll >= pollInterval) {
+        lastPoll = now;
+        PollWriteTimes(now);
+    }
+
+    // Report files that have been quiet for the debounce time
+    for (auto& [path, file] : files) {
+        if (file.dirty && now - file.lastChange >= debounce) {
+            file.dirty = false;
+            changedPaths.push_back(path);
+        }
+    }
+}
+
+void FileWatcher::MarkDirty(WatchedFile& file, Clock::time_point now) {
+    file.dirty = true;
+    file.lastChange = now;
+}
+
+void FileWatcher::ReadNativeEvents(Clock::time_point now) {
+#if SPROUT_FILE_WATCHER_INOTIFY
+    if (inotifyFd < 0) return;
+
+    alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+    for (;;) {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break; // EAGAIN: nothing more queued
+
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Events were dropped; assume everything changed
+                for (auto& [path, file] : files) {
+                    MarkDirty(file, now);
+                }
+                continue;
+            }
+
+            auto dirIt = directoryByDescriptor.find(event->wd);
+            if (dirIt == directoryByDescriptor.end()) continue;
+
+            if (event->mask & IN_IGNORED) {
+                // The directory went away; the poll pass re-adds the watch if it comes back
+                auto watched = directories.find(dirIt->second);
+                if (watched != directories.end()) watched->second.descriptor = -1;
+                directoryByDescriptor.erase(dirIt);
+                continue;
+            }
+
+            if (event->len == 0) continue;
+            auto fileIt = files.find(JoinPath(dirIt->second, event->name));
+            if (fileIt != files.end()) {
+                MarkDirty(fileIt->second, now);
+            }
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+void FileWatcher::PollWriteTimes(Clock::time_point now) {
+#if SPROUT_FILE_WATCHER_INOTIFY
+    if (inotifyFd >= 0) {
+        // Retry directories whose watch could not be added or was dropped
+        for (auto& [path, directory] : directories) {
+            if (directory.descriptor >= 0) continue;
+            directory.descriptor = inotify_add_watch(inotifyFd, path.c_str(), WatchMask);
+            if (directory.descriptor < 0) continue;
+            directoryByDescriptor[directory.descriptor] = path;
+
+            // Anything written while unwatched was missed
+            for (auto& [filePath, file] : files) {
+                if (file.directory == path) MarkDirty(file, now);
+            }
+        }
+    }
+#endif
+
+    // Only files not covered by a native watch need a stat
+    for (auto& [path, file] : files) {
+        if (inotifyFd >= 0) {
+            auto dirIt = directories.find(file.directory);
+            if (dirIt != directories.end() && dirIt->second.descriptor >= 0) continue;
+        }
+
+        double writeTime = GetFileWriteTime(path);
+        if (writeTime != file.lastWriteTime) {
+            file.lastWriteTime = writeTime;
+            MarkDirty(file, now);
+        }
+    }
+}
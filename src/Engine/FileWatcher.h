@@ -0,0 +1,64 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * FileWatcher - reports files that changed on disk, once per burst of writes
+ * Uses inotify on Linux (one watch per directory, so editors that save by renaming a
+ * temp file over the original are still seen); elsewhere, or if inotify is unavailable,
+ * watched files are stat'ed every poll interval instead. A file is reported after it
+ * has been quiet for the debounce time, so a save that touches it several times yields
+ * a single change. Not thread-safe; call Poll() from the thread that owns the watcher.
+ */
+class FileWatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FileWatcher(double debounceSeconds = 0.1, double pollIntervalSeconds = 0.5);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Starts watching path; paths naming the same file are watched once
+    void Watch(const std::string& path);
+    void Unwatch(const std::string& path);
+    bool IsWatching(const std::string& path) const;
+
+    // Appends the (normalized) paths whose changes have settled since the last call
+    void Poll(std::vector<std::string>& changedPaths);
+
+    bool IsUsingNativeEvents() const { return inotifyFd >= 0; }
+    size_t GetWatchCount() const { return files.size(); }
+
+    // Key under which a path is watched and reported (lexically normalized, '/' separators)
+    static std::string NormalizePath(const std::string& path);
+
+private:
+    struct WatchedFile {
+        std::string directory;
+        double lastWriteTime = 0.0;   // polling fallback only
+        bool dirty = false;
+        Clock::time_point lastChange;
+    };
+
+    struct WatchedDirectory {
+        int descriptor = -1;
+        size_t fileCount = 0;
+    };
+
+    void ReadNativeEvents(Clock::time_point now);
+    void PollWriteTimes(Clock::time_point now);
+    void MarkDirty(WatchedFile& file, Clock::time_point now);
+
+    Clock::duration debounce;
+    Clock::duration pollInterval;
+    Clock::time_point lastPoll;
+
+    std::unordered_map<std::string, WatchedFile> files;
+    std::unordered_map<std::string, WatchedDirectory> directories;
+    std::unordered_map<int, std::string> directoryByDescriptor;
+    int inotifyFd = -1;
+};
@@ -0,0 +1,44 @@
+#include "FrameArena.h"
+#include <cstdint>
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    bytesUsed += size;
+
+    // Worst case padding still has to fit in one block
+    if (size + alignment > blockSize) {
+        oversized.push_back(std::make_unique<std::byte[]>(size + alignment));
+        oversizedBytes += size + alignment;
+        auto address = reinterpret_cast<uintptr_t>(oversized.back().get());
+        return reinterpret_cast<void*>(AlignUp(address, alignment));
+    }
+
+    while (currentBlock < blocks.size()) {
+        Block& block = blocks[currentBlock];
+        auto base = reinterpret_cast<uintptr_t>(block.memory.get());
+        size_t offset = AlignUp(base + currentOffset, alignment) - base;
+        if (offset + size <= block.size) {
+            currentOffset = offset + size;
+            return block.memory.get() + offset;
+        }
+        ++currentBlock;
+        currentOffset = 0;
+    }
+
+    blocks.push_back(Block{std::make_unique<std::byte[]>(blockSize), blockSize});
+    auto base = reinterpret_cast<uintptr_t>(blocks.back().memory.get());
+    size_t offset = AlignUp(base, alignment) - base;
+    currentOffset = offset + size;
+    return blocks.back().memory.get() + offset;
+}
+
+void FrameArena::Reset() {
+    currentBlock = 0;
+    currentOffset = 0;
+    bytesUsed = 0;
+    oversized.clear();
+    oversizedBytes = 0;
+}
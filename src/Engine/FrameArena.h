@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * FrameArena - bump allocator for data that lives until the next Reset()
+ * Memory is kept in fixed-size blocks that are reused across frames, so steady-state
+ * allocation never reaches the heap. Nothing is destructed on Reset(); callers that
+ * store non-trivial types must run their destructors first.
+ */
+class FrameArena {
+public:
+    explicit FrameArena(size_t blockSize = 64 * 1024) : blockSize(blockSize) {}
+
+    void* Allocate(size_t size, size_t alignment);
+    void Reset();
+
+    size_t GetBytesUsed() const { return bytesUsed; }
+    size_t GetCapacity() const { return blocks.size() * blockSize + oversizedBytes; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size;
+    };
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    size_t currentBlock = 0;
+    size_t currentOffset = 0;
+    size_t bytesUsed = 0;
+
+    // Allocations larger than a block get their own block, freed on Reset()
+    std::vector<std::unique_ptr<std::byte[]>> oversized;
+    size_t oversizedBytes = 0;
+};
@@ -0,0 +1,196 @@
+#include "FrustumCulling.h"
+#include "FrustumCullingSimd.h"
+#include "CpuFeatures.h"
+#include "JobSystem.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPROUT_FRUSTUM_CULLING_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SPROUT_FRUSTUM_CULLING_AVX2 1
+#endif
+
+namespace {
+    size_t CullScalar(const FrustumCulling::Frustum& frustum, const FrustumCulling::AABBArrays& in,
+                      size_t begin, size_t end, uint32_t* visible) {
+        size_t written = 0;
+        for (size_t i = begin; i < end; ++i) {
+            bool outside = false;
+            for (const glm::vec4& plane : frustum.planes) {
+                const float distance = plane.x * in.centerX[i] + plane.y * in.centerY[i] + plane.z * in.centerZ[i] + plane.w;
+                const float radius = std::fabs(plane.x) * in.extentX[i] + std::fabs(plane.y) * in.extentY[i] +
+                                     std::fabs(plane.z) * in.extentZ[i];
+                outside = outside || distance + radius < 0.0f;
+            }
+            if (!outside) visible[written++] = static_cast<uint32_t>(i);
+        }
+        return written;
+    }
+
+#if SPROUT_FRUSTUM_CULLING_SSE2
+    struct SSE2Ops {
+        using F = __m128;
+        static constexpr size_t Width = 4;
+        static constexpr unsigned FullMask = 0xF;
+
+        static F Load(const float* p) { return _mm_loadu_ps(p); }
+        static F Set(float v) { return _mm_set1_ps(v); }
+        static F Add(F a, F b) { return _mm_add_ps(a, b); }
+        static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+        static F Or(F a, F b) { return _mm_or_ps(a, b); }
+        static F CmpLt(F a, F b) { return _mm_cmplt_ps(a, b); }
+        static int MoveMask(F a) { return _mm_movemask_ps(a); }
+    };
+#endif
+
+    // Boxes [begin, end) with the given path; indices are absolute
+    size_t CullRange(const FrustumCulling::Frustum& frustum, const FrustumCulling::AABBArrays& in,
+                     size_t begin, size_t end, uint32_t* visible, FrustumCulling::Path path) {
+        using FrustumCulling::Path;
+
+        size_t written = 0;
+        size_t next = begin;
+        switch (path) {
+            case Path::AVX2:
+#if SPROUT_FRUSTUM_CULLING_AVX2
+                written = FrustumCulling::CullBatchesAVX2(frustum, in, begin, end, visible, next);
+#endif
+                break;
+            case Path::SSE2:
+#if SPROUT_FRUSTUM_CULLING_SSE2
+                written = FrustumCullingDetail::CullBatches<SSE2Ops>(frustum, in, begin, end, visible, next);
+#endif
+                break;
+            case Path::Scalar:
+                break;
+        }
+
+        // Remainder that does not fill a whole vector
+        return written + CullScalar(frustum, in, next, end, visible + written);
+    }
+}
+
+namespace FrustumCulling {
+    Frustum ExtractFrustum(const glm::mat4& m) {
+        // Rows of the column-major matrix
+        const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        Frustum frustum;
+        frustum.planes[0] = row3 + row0;
+        frustum.planes[1] = row3 - row0;
+        frustum.planes[2] = row3 + row1;
+        frustum.planes[3] = row3 - row1;
+        frustum.planes[4] = row3 + row2;
+        frustum.planes[5] = row3 - row2;
+        for (glm::vec4& plane : frustum.planes) {
+            const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f) plane /= length;
+        }
+        return frustum;
+    }
+
+    void BoxList::Clear() {
+        centerX.clear(); centerY.clear(); centerZ.clear();
+        extentX.clear(); extentY.clear(); extentZ.clear();
+    }
+
+    void BoxList::Reserve(size_t count) {
+        centerX.reserve(count); centerY.reserve(count); centerZ.reserve(count);
+        extentX.reserve(count); extentY.reserve(count); extentZ.reserve(count);
+    }
+
+    void BoxList::Add(const glm::vec3& center, const glm::vec3& extent) {
+        centerX.push_back(center.x); centerY.push_back(center.y); centerZ.push_back(center.z);
+        extentX.push_back(extent.x); extentY.push_back(extent.y); extentZ.push_back(extent.z);
+    }
+
+    void BoxList::AddTransformed(const glm::mat4& world, const glm::vec3& localCenter, const glm::vec3& localExtent) {
+        glm::vec3 center, extent;
+        for (int r = 0; r < 3; ++r) {
+            center[r] = world[0][r] * localCenter.x + world[1][r] * localCenter.y + world[2][r] * localCenter.z + world[3][r];
+            extent[r] = std::fabs(world[0][r]) * localExtent.x + std::fabs(world[1][r]) * localExtent.y +
+                        std::fabs(world[2][r]) * localExtent.z;
+        }
+        Add(center, extent);
+    }
+
+    AABBArrays BoxList::GetArrays() const {
+        return AABBArrays{centerX.data(), centerY.data(), centerZ.data(),
+                          extentX.data(), extentY.data(), extentZ.data()};
+    }
+
+    bool IsPathSupported(Path path) {
+        switch (path) {
+            case Path::Scalar:
+                return true;
+            case Path::SSE2:
+#if SPROUT_FRUSTUM_CULLING_SSE2
+                return CpuFeatures::Get().sse2;
+#else
+                return false;
+#endif
+            case Path::AVX2:
+#if SPROUT_FRUSTUM_CULLING_AVX2
+                return CpuFeatures::Get().avx2;
+#else
+                return false;
+#endif
+        }
+        return false;
+    }
+
+    Path GetBestPath() {
+        static const Path best = IsPathSupported(Path::AVX2) ? Path::AVX2
+                               : IsPathSupported(Path::SSE2) ? Path::SSE2
+                               : Path::Scalar;
+        return best;
+    }
+
+    const char* GetPathName(Path path) {
+        switch (path) {
+            case Path::Scalar: return "Scalar";
+            case Path::SSE2: return "SSE2";
+            case Path::AVX2: return "AVX2";
+        }
+        return "Unknown";
+    }
+
+    size_t Cull(const Frustum& frustum, const AABBArrays& boxes, size_t count, uint32_t* visible) {
+        return Cull(frustum, boxes, count, visible, GetBestPath());
+    }
+
+    size_t Cull(const Frustum& frustum, const AABBArrays& boxes, size_t count, uint32_t* visible, Path path) {
+        if (!IsPathSupported(path)) {
+            path = Path::Scalar;
+        }
+        return CullRange(frustum, boxes, 0, count, visible, path);
+    }
+
+    size_t CullParallel(JobSystem& jobs, const Frustum& frustum, const AABBArrays& boxes, size_t count,
+                        uint32_t* visible, size_t chunkSize) {
+        if (chunkSize == 0) chunkSize = 16384;
+        if (count <= chunkSize || jobs.GetWorkerCount() == 0) {
+            return Cull(frustum, boxes, count, visible);
+        }
+
+        // Each chunk compacts into its own slice of visible, then the slices are closed up
+        const Path path = GetBestPath();
+        std::vector<size_t> chunkVisible((count + chunkSize - 1) / chunkSize);
+        jobs.ParallelFor(count, chunkSize, [&](size_t begin, size_t end) {
+            chunkVisible[begin / chunkSize] = CullRange(frustum, boxes, begin, end, visible + begin, path);
+        });
+
+        size_t total = chunkVisible[0];
+        for (size_t chunk = 1; chunk < chunkVisible.size(); ++chunk) {
+            std::memmove(visible + total, visible + chunk * chunkSize, chunkVisible[chunk] * sizeof(uint32_t));
+            total += chunkVisible[chunk];
+        }
+        return total;
+    }
+}
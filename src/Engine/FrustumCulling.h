@@ -0,0 +1,70 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * FrustumCulling - view frustum tests for world-space AABBs stored as SoA
+ * Boxes are center/half-extent; a box is culled when it lies completely behind one of
+ * the six planes (conservative: boxes near frustum corners may be kept). 4 (SSE2) or 8
+ * (AVX2) boxes per iteration, with a scalar fallback; the best path supported by the
+ * CPU is picked at runtime, as in TransformKernel.
+ */
+namespace FrustumCulling {
+    enum class Path {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    // Planes (n, d), normalized, inside where dot(n, p) + d >= 0: left, right, bottom, top, near, far
+    struct Frustum {
+        glm::vec4 planes[6];
+    };
+
+    // From any view-projection (CameraComponent::GetViewProjectionMatrix, the editor camera, ...)
+    // with OpenGL clip space (-w <= z <= w)
+    Frustum ExtractFrustum(const glm::mat4& viewProj);
+
+    // All arrays hold at least count values
+    struct AABBArrays {
+        const float* centerX;
+        const float* centerY;
+        const float* centerZ;
+        const float* extentX;
+        const float* extentY;
+        const float* extentZ;
+    };
+
+    // Owning SoA storage, refilled every frame; keeps its capacity across Clear()
+    class BoxList {
+    public:
+        void Clear();
+        void Reserve(size_t count);
+        void Add(const glm::vec3& center, const glm::vec3& extent);
+        // World AABB of a local box under world (center moved, extent through |M|)
+        void AddTransformed(const glm::mat4& world, const glm::vec3& localCenter, const glm::vec3& localExtent);
+
+        size_t Size() const { return centerX.size(); }
+        AABBArrays GetArrays() const;
+
+    private:
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> extentX, extentY, extentZ;
+    };
+
+    // Writes the indices of boxes not culled to visible (room for count) in ascending order; returns how many
+    size_t Cull(const Frustum& frustum, const AABBArrays& boxes, size_t count, uint32_t* visible);
+    size_t Cull(const Frustum& frustum, const AABBArrays& boxes, size_t count, uint32_t* visible, Path path);
+
+    // Same result as Cull, split into chunks of chunkSize boxes over jobs
+    size_t CullParallel(JobSystem& jobs, const Frustum& frustum, const AABBArrays& boxes, size_t count,
+                        uint32_t* visible, size_t chunkSize = 16384);
+
+    Path GetBestPath();
+    bool IsPathSupported(Path path);
+    const char* GetPathName(Path path);
+}
@@ -0,0 +1,29 @@
+// Compiled with AVX2 enabled (see CMakeLists.txt); only called after a runtime CPU check
+#include "FrustumCullingSimd.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+
+namespace {
+    struct AVX2Ops {
+        using F = __m256;
+        static constexpr size_t Width = 8;
+        static constexpr unsigned FullMask = 0xFF;
+
+        static F Load(const float* p) { return _mm256_loadu_ps(p); }
+        static F Set(float v) { return _mm256_set1_ps(v); }
+        static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+        static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+        static F Or(F a, F b) { return _mm256_or_ps(a, b); }
+        static F CmpLt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static int MoveMask(F a) { return _mm256_movemask_ps(a); }
+    };
+}
+
+namespace FrustumCulling {
+    size_t CullBatchesAVX2(const Frustum& frustum, const AABBArrays& in, size_t begin, size_t end,
+                           uint32_t* visible, size_t& next) {
+        return FrustumCullingDetail::CullBatches<AVX2Ops>(frustum, in, begin, end, visible, next);
+    }
+}
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+// Internal to the FrustumCulling translation units. Everything here is in an anonymous
+// namespace on purpose: the AVX2 unit is compiled with different target flags, so no
+// inline function may be shared (and deduplicated by the linker) across units.
+#include "FrustumCulling.h"
+#include <bit>
+#include <cmath>
+
+namespace FrustumCulling {
+    // Defined in FrustumCullingAVX2.cpp (only built for x86). Tests whole groups of 8 boxes
+    // in [begin, end), sets next to the first box it did not test and returns how many it wrote
+    size_t CullBatchesAVX2(const Frustum& frustum, const AABBArrays& in, size_t begin, size_t end,
+                           uint32_t* visible, size_t& next);
+}
+
+namespace {
+    namespace FrustumCullingDetail {
+        template<typename V>
+        inline size_t CullBatches(const FrustumCulling::Frustum& frustum, const FrustumCulling::AABBArrays& in,
+                                  size_t begin, size_t end, uint32_t* visible, size_t& next) {
+            using F = typename V::F;
+
+            // Broadcast planes; |n| gives the box's projected radius on each plane
+            F nx[6], ny[6], nz[6], nd[6], ax[6], ay[6], az[6];
+            for (int p = 0; p < 6; ++p) {
+                const glm::vec4& plane = frustum.planes[p];
+                nx[p] = V::Set(plane.x);
+                ny[p] = V::Set(plane.y);
+                nz[p] = V::Set(plane.z);
+                nd[p] = V::Set(plane.w);
+                ax[p] = V::Set(std::fabs(plane.x));
+                ay[p] = V::Set(std::fabs(plane.y));
+                az[p] = V::Set(std::fabs(plane.z));
+            }
+            const F zero = V::Set(0.0f);
+
+            size_t written = 0;
+            size_t i = begin;
+            for (; i + V::Width <= end; i += V::Width) {
+                const F cx = V::Load(in.centerX + i);
+                const F cy = V::Load(in.centerY + i);
+                const F cz = V::Load(in.centerZ + i);
+                const F ex = V::Load(in.extentX + i);
+                const F ey = V::Load(in.extentY + i);
+                const F ez = V::Load(in.extentZ + i);
+
+                F outside = V::CmpLt(zero, zero);
+                for (int p = 0; p < 6; ++p) {
+                    const F distance = V::Add(V::Add(V::Mul(nx[p], cx), V::Mul(ny[p], cy)),
+                                              V::Add(V::Mul(nz[p], cz), nd[p]));
+                    const F radius = V::Add(V::Add(V::Mul(ax[p], ex), V::Mul(ay[p], ey)), V::Mul(az[p], ez));
+                    outside = V::Or(outside, V::CmpLt(V::Add(distance, radius), zero));
+                }
+
+                unsigned mask = ~static_cast<unsigned>(V::MoveMask(outside)) & V::FullMask;
+                while (mask) {
+                    visible[written++] = static_cast<uint32_t>(i + std::countr_zero(mask));
+                    mask &= mask - 1;
+                }
+            }
+
+            next = i;
+            return written;
+        }
+    }
+}
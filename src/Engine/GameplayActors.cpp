@@ -6,13 +6,17 @@
 Pawn::Pawn(World* world, const std::string& name) : Actor(world, name) {
 }
 
+Controller* Pawn::GetController() const {
+    return world ? static_cast<Controller*>(world->ResolveActor(controller)) : nullptr;
+}
+
 void Pawn::PossessedBy(Controller* newController) {
-    controller = newController;
+    controller = newController ? newController->GetHandle() : ActorHandle{};
     SetupPlayerInputComponent();
 }
 
 void Pawn::UnPossessed() {
-    controller = nullptr;
+    controller = ActorHandle{};
 }
 
 void Pawn::AddMovementInput(const glm::vec3& direction, float scaleValue) {
@@ -86,24 +90,29 @@ void Character::SetupComponents() {
 
 // Controller Implementation
 Controller::Controller(World* world, const std::string& name) : Actor(world, name) {
+    // Controllers drive other actors (their pawn), so they keep the game-thread default
+}
+
+Pawn* Controller::GetPawn() const {
+    return world ? static_cast<Pawn*>(world->ResolveActor(possessedPawn)) : nullptr;
 }
 
 void Controller::Possess(Pawn* inPawn) {
-    if (possessedPawn) {
+    if (GetPawn()) {
         UnPossess();
     }
 
-    possessedPawn = inPawn;
-    if (possessedPawn) {
-        possessedPawn->PossessedBy(this);
+    possessedPawn = inPawn ? inPawn->GetHandle() : ActorHandle{};
+    if (inPawn) {
+        inPawn->PossessedBy(this);
     }
 }
 
 void Controller::UnPossess() {
-    if (possessedPawn) {
-        possessedPawn->UnPossessed();
-        possessedPawn = nullptr;
+    if (Pawn* pawn = GetPawn()) {
+        pawn->UnPossessed();
     }
+    possessedPawn = ActorHandle{};
 }
 
 // PlayerController Implementation
@@ -165,6 +174,7 @@ void PlayerController::OnMouseMove(float deltaX, float deltaY) {
 
 // GameMode Implementation
 GameMode::GameMode(World* world, const std::string& name) : Actor(world, name) {
+    // Game flow spawns and possesses actors, so it keeps the game-thread default
 }
 
 void GameMode::BeginPlay() {
@@ -225,6 +235,9 @@ RotatingCube::RotatingCube(World* world, const std::string& name) : Actor(world,
     meshComponent = CreateComponent<MeshRendererComponent>();
     meshComponent->SetMesh("assets/meshes/cube.obj");
     meshComponent->SetMaterial("assets/materials/default_mat.json");
+
+    // Tick only rotates this actor's own transform
+    SetTickOnGameThreadOnly(false);
 }
 
 void RotatingCube::BeginPlay() {
@@ -235,7 +248,7 @@ void RotatingCube::BeginPlay() {
 void RotatingCube::Tick(float deltaTime) {
     Actor::Tick(deltaTime);
 
-    // Rotate the cube
+    // Rotate the cube: RotationAxis scales the Euler rate of each axis
     glm::vec3 currentRotation = GetActorRotation();
     glm::vec3 rotationDelta = RotationAxis * RotationSpeed * deltaTime;
     SetActorRotation(currentRotation + rotationDelta);
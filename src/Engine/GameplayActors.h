@@ -16,16 +16,18 @@ public:
     virtual void PossessedBy(class Controller* newController);
     virtual void UnPossessed();
 
-    class Controller* GetController() const { return controller; }
+    class Controller* GetController() const;
 
     // Movement
     virtual void AddMovementInput(const glm::vec3& direction, float scaleValue = 1.0f);
 
     // Static class info (for blueprint system)
+    using ThisClass = Pawn;
+    using Super = Actor;
     static std::string StaticClass() { return "Pawn"; }
 
 protected:
-    class Controller* controller = nullptr;
+    ActorHandle controller;
     glm::vec3 pendingMovementInput{0.0f};
 
     void TickMovement(float deltaTime);
@@ -59,6 +61,8 @@ public:
     bool bCanJump = true;
 
     // Static class info
+    using ThisClass = Character;
+    using Super = Pawn;
     static std::string StaticClass() { return "Character"; }
 
 protected:
@@ -80,12 +84,15 @@ public:
     virtual void Possess(Pawn* inPawn);
     virtual void UnPossess();
 
-    Pawn* GetPawn() const { return possessedPawn; }
+    Pawn* GetPawn() const;
 
+    using ThisClass = Controller;
+    using Super = Actor;
     static std::string StaticClass() { return "Controller"; }
 
 protected:
-    Pawn* possessedPawn = nullptr;
+    // Handle so a destroyed pawn resolves to null instead of dangling
+    ActorHandle possessedPawn;
 };
 
 /**
@@ -102,6 +109,8 @@ public:
     virtual void SetupInputComponent();
     void ProcessInput(float deltaTime);
 
+    using ThisClass = PlayerController;
+    using Super = Controller;
     static std::string StaticClass() { return "PlayerController"; }
 
 private:
@@ -142,6 +151,8 @@ public:
     bool HasMatchStarted() const { return bMatchStarted; }
     bool HasMatchEnded() const { return bMatchEnded; }
 
+    using ThisClass = GameMode;
+    using Super = Actor;
     static std::string StaticClass() { return "GameMode"; }
 
 protected:
@@ -170,6 +181,8 @@ public:
     float RotationSpeed = 90.0f; // degrees per second
     glm::vec3 RotationAxis{0.0f, 1.0f, 0.0f};
 
+    using ThisClass = RotatingCube;
+    using Super = Actor;
     static std::string StaticClass() { return "RotatingCube"; }
 
 private:
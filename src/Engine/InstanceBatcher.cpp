@@ -0,0 +1,45 @@
+#include "InstanceBatcher.h"
+#include <algorithm>
+#include <cstring>
+
+InstanceBatcher::Bucket& InstanceBatcher::GetBucket(uint64_t key) {
+    if (lastBucket < buckets.size() && buckets[lastBucket].key == key) {
+        return buckets[lastBucket];
+    }
+
+    auto it = std::lower_bound(buckets.begin(), buckets.end(), key,
+                               [](const Bucket& bucket, uint64_t k) { return bucket.key < k; });
+    if (it == buckets.end() || it->key != key) {
+        it = buckets.insert(it, Bucket{key, {}});
+    }
+    lastBucket = static_cast<size_t>(it - buckets.begin());
+    return *it;
+}
+
+void InstanceBatcher::Add(uint32_t mesh, uint32_t material, const glm::mat4& model, const glm::vec4& tint) {
+    GetBucket(MakeKey(mesh, material)).instances.push_back(InstanceData{model, tint});
+    ++instanceCount;
+}
+
+const std::vector<InstanceBatcher::Batch>& InstanceBatcher::Pack(InstanceData* out) {
+    batches.clear();
+    uint32_t offset = 0;
+    for (const Bucket& bucket : buckets) {
+        if (bucket.instances.empty()) continue;
+
+        const uint32_t count = static_cast<uint32_t>(bucket.instances.size());
+        // Sequential bulk copy: out is usually write-combined mapped memory
+        std::memcpy(out + offset, bucket.instances.data(), count * sizeof(InstanceData));
+        batches.push_back(Batch{static_cast<uint32_t>(bucket.key >> 32), static_cast<uint32_t>(bucket.key),
+                                offset, count});
+        offset += count;
+    }
+    return batches;
+}
+
+void InstanceBatcher::Clear() {
+    for (Bucket& bucket : buckets) {
+        bucket.instances.clear();
+    }
+    instanceCount = 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-instance vertex data for the instanced shaders (locations 2-5 model, 6 tint)
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 tint;   // rgb multiplies the material color, a is unused
+};
+static_assert(sizeof(InstanceData) == 80, "InstanceData is uploaded as-is");
+
+/**
+ * InstanceBatcher - collects instances per mesh/material and packs them for upload
+ * Add() appends to the bucket of its mesh/material; Pack() writes every bucket back to
+ * back into one array (typically the mapped instance buffer) and returns one Batch per
+ * bucket, ordered by mesh then material, so each becomes a single instanced draw.
+ * Buckets keep their capacity across Clear(), so a steady scene does not allocate.
+ * No GL in here; Renderer does the upload.
+ */
+class InstanceBatcher {
+public:
+    struct Batch {
+        uint32_t mesh;
+        uint32_t material;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+    };
+
+    void Add(uint32_t mesh, uint32_t material, const glm::mat4& model, const glm::vec4& tint);
+
+    // out must hold GetInstanceCount() instances
+    const std::vector<Batch>& Pack(InstanceData* out);
+
+    size_t GetInstanceCount() const { return instanceCount; }
+    void Clear();
+
+private:
+    struct Bucket {
+        uint64_t key;
+        std::vector<InstanceData> instances;
+    };
+
+    static uint64_t MakeKey(uint32_t mesh, uint32_t material) {
+        return (static_cast<uint64_t>(mesh) << 32) | material;
+    }
+
+    Bucket& GetBucket(uint64_t key);
+
+    std::vector<Bucket> buckets;   // sorted by key; there are only ever a handful
+    size_t lastBucket = 0;         // consecutive adds usually hit the same bucket
+    size_t instanceCount = 0;
+    std::vector<Batch> batches;
+};
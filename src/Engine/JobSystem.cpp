@@ -0,0 +1,162 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+// The pool the current thread works for and its queue there (0 when not a worker)
+static thread_local const JobSystem* t_pool = nullptr;
+static thread_local unsigned t_threadIndex = 0;
+
+unsigned JobSystem::DefaultWorkerCount() {
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+unsigned JobSystem::GetCurrentThreadIndex() const {
+    return t_pool == this ? t_threadIndex : 0;
+}
+
+JobSystem& JobSystem::Shared() {
+    static JobSystem shared;
+    return shared;
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+    queues.reserve(workerCount + 1);
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers.reserve(workerCount);
+    for (unsigned i = 1; i <= workerCount; ++i) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    chunkSize = std::max<size_t>(chunkSize, 1);
+
+    // Nothing to split across: run inline
+    if (workers.empty() || count <= chunkSize) {
+        fn(0, count);
+        return;
+    }
+
+    const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    Batch batch;
+    batch.fn = &fn;
+    batch.remaining.store(chunkCount, std::memory_order_relaxed);
+
+    // Spread chunks round-robin so every worker has local work before it needs to steal
+    const unsigned self = GetCurrentThreadIndex();
+    const unsigned queueCount = static_cast<unsigned>(queues.size());
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        Job job;
+        job.batch = &batch;
+        job.begin = chunk * chunkSize;
+        job.end = std::min(count, job.begin + chunkSize);
+        Push(static_cast<unsigned>((self + chunk) % queueCount), job);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeCondition.notify_all();
+
+    // Help out until our chunks are done (may run other callers' jobs too)
+    Job job;
+    while (batch.remaining.load(std::memory_order_acquire) > 0) {
+        if (TryPop(self, job)) {
+            Execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (batch.exception) {
+        std::rethrow_exception(batch.exception);
+    }
+}
+
+void JobSystem::WorkerLoop(unsigned threadIndex) {
+    t_pool = this;
+    t_threadIndex = threadIndex;
+
+    Job job;
+    while (true) {
+        if (TryPop(threadIndex, job)) {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this] { return !running || queuedJobs.load() > 0; });
+        if (!running) return;
+    }
+}
+
+void JobSystem::Push(unsigned queueIndex, const Job& job) {
+    WorkQueue& queue = *queues[queueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+}
+
+bool JobSystem::TryPop(unsigned threadIndex, Job& out) {
+    if (queuedJobs.load(std::memory_order_acquire) == 0) return false;
+
+    // Own queue first (LIFO keeps recently pushed chunks hot in cache)
+    {
+        WorkQueue& own = *queues[threadIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            out = own.jobs.back();
+            own.jobs.pop_back();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Steal the oldest job from someone else
+    const unsigned queueCount = static_cast<unsigned>(queues.size());
+    for (unsigned offset = 1; offset < queueCount; ++offset) {
+        WorkQueue& victim = *queues[(threadIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            out = victim.jobs.front();
+            victim.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::Execute(const Job& job) {
+    Batch& batch = *job.batch;
+    if (!batch.failed.load(std::memory_order_relaxed)) {
+        try {
+            (*batch.fn)(job.begin, job.end);
+        } catch (...) {
+            if (!batch.failed.exchange(true, std::memory_order_relaxed)) {
+                batch.exception = std::current_exception();
+            }
+        }
+    }
+    // Release publishes the exception to the caller waiting on remaining
+    batch.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
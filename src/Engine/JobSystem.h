@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * JobSystem - small work-stealing thread pool
+ * Each thread owns a deque: it pops its own work from the back and steals from the
+ * front of the others. The thread that calls ParallelFor helps until its jobs finish,
+ * so nested ParallelFor calls from inside a job are fine.
+ *
+ * If a chunk throws, the chunks of that ParallelFor that have not started are skipped
+ * and the first exception is rethrown on the calling thread once the running ones end.
+ */
+class JobSystem {
+public:
+    // Defaults to hardware_concurrency - 1 workers; with 0 workers everything runs inline
+    explicit JobSystem(unsigned workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+    // Workers plus the calling thread
+    unsigned GetThreadCount() const { return GetWorkerCount() + 1; }
+
+    // Runs fn(begin, end) over [0, count) in chunks of chunkSize and blocks until all are done
+    void ParallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)>& fn);
+
+    // 1..N on this pool's workers; 0 on every other thread (the game thread, other pools' workers)
+    unsigned GetCurrentThreadIndex() const;
+
+    static unsigned DefaultWorkerCount();
+
+    // Process-wide pool with DefaultWorkerCount() workers, created on first use.
+    // Worlds, culling and script shards share it instead of each starting their own threads.
+    static JobSystem& Shared();
+
+private:
+    // One ParallelFor call; lives on the caller's stack until every chunk has finished
+    struct Batch {
+        const std::function<void(size_t, size_t)>* fn = nullptr;
+        std::atomic<size_t> remaining{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr exception;   // set once, by the chunk that flips failed
+    };
+
+    struct Job {
+        Batch* batch = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // queues[0] is shared by external threads, queues[i] belongs to worker i
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<size_t> queuedJobs{0};
+    std::atomic<bool> running{true};
+
+    void WorkerLoop(unsigned threadIndex);
+    void Push(unsigned queueIndex, const Job& job);
+    bool TryPop(unsigned threadIndex, Job& out);
+    static void Execute(const Job& job);
+};
@@ -0,0 +1,196 @@
+#include "LatentScheduler.h"
+#include "ScriptProfiler.h"
+#include "ScriptWatchdog.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+LatentScheduler::Handle LatentScheduler::Start(const sol::protected_function& fn, const std::vector<sol::object>& args) {
+    if (!L || !fn.valid()) return InvalidHandle;
+
+    const Handle handle = nextHandle++;
+    if (nextHandle == InvalidHandle) nextHandle = 1;
+
+    Action& action = actions[handle];
+    action.thread = sol::thread::create(L);
+    action.coroutine = sol::coroutine(action.thread.thread_state(), fn);
+    action.script = currentScript;
+    action.entity = currentEntity;
+
+    // Runs synchronously up to the first wait, like a direct call would
+    Resume(handle, &args);
+    return IsRunning(handle) ? handle : InvalidHandle;
+}
+
+void LatentScheduler::Stop(Handle handle) {
+    auto it = actions.find(handle);
+    if (it == actions.end()) return;
+
+    if (IsOnRunningStack(handle)) {
+        it->second.stopped = true;
+    } else {
+        // Any queued wake entry is skipped once it comes up
+        actions.erase(it);
+    }
+}
+
+bool LatentScheduler::IsRunning(Handle handle) const {
+    auto it = actions.find(handle);
+    return it != actions.end() && !it->second.stopped;
+}
+
+void LatentScheduler::StopScript(uint32_t script, Handle startedBefore) {
+    std::vector<Handle> owned;
+    for (const auto& [handle, action] : actions) {
+        if (action.script == script && handle < startedBefore) owned.push_back(handle);
+    }
+    for (Handle handle : owned) {
+        Stop(handle);
+    }
+}
+
+LatentScheduler::Action& LatentScheduler::GetRunningAction(lua_State* caller, const char* function) {
+    auto it = runningStack.empty() ? actions.end() : actions.find(runningStack.back());
+    if (it == actions.end() || it->second.thread.thread_state() != caller) {
+        throw sol::error(std::string(function) + " can only be called from a latent action (see StartLatent)");
+    }
+    return it->second;
+}
+
+bool LatentScheduler::IsOnRunningStack(Handle handle) const {
+    return std::find(runningStack.begin(), runningStack.end(), handle) != runningStack.end();
+}
+
+void LatentScheduler::WaitSeconds(lua_State* caller, double seconds) {
+    Action& action = GetRunningAction(caller, "Wait");
+    action.wait = WaitKind::Seconds;
+    action.wakeTime = time + std::max(seconds, 0.0);
+}
+
+void LatentScheduler::WaitFrames(lua_State* caller, int64_t frames) {
+    Action& action = GetRunningAction(caller, "WaitFrames");
+    action.wait = WaitKind::Frames;
+    action.wakeFrame = frame + static_cast<uint64_t>(std::max<int64_t>(frames, 1));
+}
+
+void LatentScheduler::WaitUntil(lua_State* caller, const sol::protected_function& condition) {
+    Action& action = GetRunningAction(caller, "WaitUntil");
+    if (!condition.valid()) throw sol::error("WaitUntil expects a function");
+
+    // Checked from the main state; the action's own thread is suspended by then
+    action.wait = WaitKind::Condition;
+    action.condition = sol::protected_function(L, condition);
+}
+
+void LatentScheduler::Resume(Handle handle, const std::vector<sol::object>* args) {
+    auto it = actions.find(handle);
+    if (it == actions.end()) return;
+    Action& action = it->second;
+
+    action.wait = WaitKind::None;
+    action.condition = sol::protected_function();
+
+    bool finished = true;
+    runningStack.push_back(handle);
+    {
+        Context context(*this, action.script, action.entity);
+        ScriptWatchdog::Guard guard(*watchdog, action.script, ScriptProfiler::Callback::Latent);
+        ScriptProfiler::Scope scope(*profiler, action.script, ScriptProfiler::Callback::Latent, action.entity);
+        sol::protected_function_result result = args ? action.coroutine(sol::as_args(*args)) : action.coroutine();
+        if (!result.valid()) {
+            sol::error err = result;
+            std::cerr << "Latent action error: " << err.what() << std::endl;
+        } else {
+            finished = action.coroutine.status() != sol::call_status::yielded;
+        }
+    }
+    runningStack.pop_back();
+
+    if (finished || action.stopped) {
+        actions.erase(handle);
+        return;
+    }
+
+    switch (action.wait) {
+        case WaitKind::Seconds:
+            timers.push({action.wakeTime, handle});
+            break;
+        case WaitKind::Condition:
+            conditionWaits.push_back(handle);
+            break;
+        case WaitKind::Frames:
+            frameWaits.push({action.wakeFrame, handle});
+            break;
+        case WaitKind::None:
+            // Yielded some other way; try again next frame
+            frameWaits.push({frame + 1, handle});
+            break;
+    }
+}
+
+void LatentScheduler::Update(entt::registry& reg, double dt) {
+    time += dt;
+    ++frame;
+
+    // Collect everything due before resuming, so a zero wait set now runs next frame
+    due.clear();
+    while (!timers.empty() && timers.top().when <= time) {
+        due.push_back(timers.top().handle);
+        timers.pop();
+    }
+    while (!frameWaits.empty() && frameWaits.top().when <= frame) {
+        due.push_back(frameWaits.top().handle);
+        frameWaits.pop();
+    }
+
+    auto ownerGone = [this, &reg](const Action& action) {
+        return (action.entity != NoOwner && !reg.valid(static_cast<entt::entity>(action.entity))) ||
+               watchdog->IsDisabled(action.script);
+    };
+
+    checking.clear();
+    checking.swap(conditionWaits);
+    for (Handle handle : checking) {
+        auto it = actions.find(handle);
+        if (it == actions.end()) continue;
+        Action& action = it->second;
+        if (ownerGone(action)) {
+            actions.erase(it);
+            continue;
+        }
+
+        bool ready = false;
+        runningStack.push_back(handle);
+        {
+            Context context(*this, action.script, action.entity);
+            ScriptWatchdog::Guard guard(*watchdog, action.script, ScriptProfiler::Callback::Latent);
+            sol::protected_function_result result = action.condition();
+            if (!result.valid()) {
+                sol::error err = result;
+                std::cerr << "WaitUntil condition error: " << err.what() << std::endl;
+                action.stopped = true;
+            } else {
+                ready = result.get<bool>();
+            }
+        }
+        runningStack.pop_back();
+
+        if (action.stopped) {
+            actions.erase(handle);
+        } else if (ready) {
+            due.push_back(handle);
+        } else {
+            conditionWaits.push_back(handle);
+        }
+    }
+
+    for (Handle handle : due) {
+        auto it = actions.find(handle);
+        if (it == actions.end()) continue;
+        if (ownerGone(it->second)) {
+            actions.erase(it);
+            continue;
+        }
+        Resume(handle);
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <sol/sol.hpp>
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+class ScriptProfiler;
+class ScriptWatchdog;
+
+/**
+ * LatentScheduler - runs script coroutines that wait on time, frames or a condition
+ * StartLatent(fn, ...) runs fn as a coroutine until its first Wait(seconds),
+ * WaitFrames(n) or WaitUntil(fn). A suspended action sits in a min-heap keyed by its
+ * wake time (or frame) and is resumed only once due, so sleeping actions cost nothing per
+ * frame; only WaitUntil predicates are evaluated every frame.
+ *
+ * Each action remembers the script and entity whose callback started it (see Context).
+ * Actions of a destroyed entity, or of a script the watchdog disabled, are dropped
+ * instead of resumed, and reloading a script stops the actions it started. Single-threaded, like the Lua state it drives.
+ */
+class LatentScheduler {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = 0;
+    static constexpr uint32_t NoOwner = 0xFFFFFFFFu;
+
+    // Marks the script/entity whose code runs while it is alive; latent actions started
+    // meanwhile belong to them
+    class Context {
+    public:
+        Context(LatentScheduler& scheduler, uint32_t script, uint32_t entity = NoOwner)
+            : scheduler(scheduler), previousScript(scheduler.currentScript), previousEntity(scheduler.currentEntity) {
+            scheduler.currentScript = script;
+            scheduler.currentEntity = entity;
+        }
+        ~Context() {
+            scheduler.currentScript = previousScript;
+            scheduler.currentEntity = previousEntity;
+        }
+
+        Context(const Context&) = delete;
+        Context& operator=(const Context&) = delete;
+
+    private:
+        LatentScheduler& scheduler;
+        uint32_t previousScript;
+        uint32_t previousEntity;
+    };
+
+    void Attach(lua_State* state, ScriptProfiler* scriptProfiler, ScriptWatchdog* scriptWatchdog) {
+        L = state;
+        profiler = scriptProfiler;
+        watchdog = scriptWatchdog;
+    }
+
+    // Runs fn(args...) up to its first wait; InvalidHandle if it finished (or failed) right away
+    Handle Start(const sol::protected_function& fn, const std::vector<sol::object>& args);
+    void Stop(Handle handle);
+    bool IsRunning(Handle handle) const;
+    // Stops the given script's actions that were started before startedBefore (handles
+    // only grow, so GetNextHandle() taken earlier spares everything started since)
+    void StopScript(uint32_t script, Handle startedBefore);
+    Handle GetNextHandle() const { return nextHandle; }
+
+    // Record how the running action wants to be woken; the caller then yields. Throw
+    // sol::error unless called from a latent action's own coroutine.
+    void WaitSeconds(lua_State* caller, double seconds);
+    void WaitFrames(lua_State* caller, int64_t frames);
+    void WaitUntil(lua_State* caller, const sol::protected_function& condition);
+
+    // Advances time and resumes whatever is due
+    void Update(entt::registry& reg, double dt);
+
+    size_t GetActionCount() const { return actions.size(); }
+    size_t GetConditionWaitCount() const { return conditionWaits.size(); }
+    double GetTime() const { return time; }
+    uint64_t GetFrame() const { return frame; }
+
+private:
+    enum class WaitKind : uint8_t {
+        None,
+        Seconds,
+        Frames,
+        Condition
+    };
+
+    struct Action {
+        sol::thread thread;
+        sol::coroutine coroutine;
+        uint32_t script = NoOwner;
+        uint32_t entity = NoOwner;
+        WaitKind wait = WaitKind::None;
+        double wakeTime = 0.0;
+        uint64_t wakeFrame = 0;
+        sol::protected_function condition;
+        bool stopped = false;
+    };
+
+    template <typename T>
+    struct WakeEntry {
+        T when;
+        Handle handle;
+        bool operator>(const WakeEntry& other) const { return when > other.when; }
+    };
+
+    Action& GetRunningAction(lua_State* caller, const char* function);
+    bool IsOnRunningStack(Handle handle) const;
+    void Resume(Handle handle, const std::vector<sol::object>* args = nullptr);
+
+    lua_State* L = nullptr;
+    ScriptProfiler* profiler = nullptr;
+    ScriptWatchdog* watchdog = nullptr;
+
+    // Node-based so references survive inserts made while an action is resumed
+    std::unordered_map<Handle, Action> actions;
+    Handle nextHandle = 1;
+    // Actions currently inside a resume or condition check (nested through StartLatent);
+    // stopping one of these only flags it, it is erased once control is back here
+    std::vector<Handle> runningStack;
+    uint32_t currentScript = NoOwner;
+    uint32_t currentEntity = NoOwner;
+
+    double time = 0.0;
+    uint64_t frame = 0;
+
+    // Entries of stopped actions stay queued and are skipped when popped
+    std::priority_queue<WakeEntry<double>, std::vector<WakeEntry<double>>, std::greater<>> timers;
+    std::priority_queue<WakeEntry<uint64_t>, std::vector<WakeEntry<uint64_t>>, std::greater<>> frameWaits;
+    std::vector<Handle> conditionWaits;
+    std::vector<Handle> checking;
+    std::vector<Handle> due;
+};
@@ -0,0 +1,162 @@
+#include "LuaGcScheduler.h"
+#include <lua.hpp>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double PauseBucketLimitsMicros[LuaGcScheduler::PauseBucketCount - 1] = {
+        50.0, 100.0, 250.0, 500.0, 1000.0, 2000.0, 5000.0
+    };
+
+    // Below this the heap is not worth scheduling cycles for
+    constexpr size_t MinCycleHeapKB = 1024;
+
+    double SecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+void LuaGcScheduler::Attach(lua_State* state) {
+    L = state;
+    frameTimes.reserve(FrameHistorySize);
+    SetMode(mode);
+}
+
+void LuaGcScheduler::SetMode(Mode newMode) {
+    mode = newMode;
+    cycleActive = false;
+    emergency = false;
+    if (!L) return;
+
+    // Zero keeps Lua's default tuning parameters. The collector is never stopped: in
+    // incremental mode its pause is the emergency threshold, Step() starts cycles earlier.
+    switch (mode) {
+        case Mode::Automatic:
+            lua_gc(L, LUA_GCINC, 0, 0, 0);
+            break;
+        case Mode::Incremental:
+            lua_gc(L, LUA_GCINC, static_cast<int>(EmergencyGrowth * 100.0), 0, 0);
+            break;
+        case Mode::Generational:
+            lua_gc(L, LUA_GCGEN, 0, 0);
+            break;
+    }
+    lua_gc(L, LUA_GCRESTART);
+    heapKBAfterCycle = GetHeapKB();
+}
+
+size_t LuaGcScheduler::GetHeapKB() const {
+    return L ? static_cast<size_t>(lua_gc(L, LUA_GCCOUNT)) : 0;
+}
+
+void LuaGcScheduler::Step(double frameSeconds, double targetFrameSeconds) {
+    if (frameTimes.size() < FrameHistorySize) {
+        frameTimes.push_back(static_cast<float>(frameSeconds));
+    } else {
+        frameTimes[nextFrameTime] = static_cast<float>(frameSeconds);
+        nextFrameTime = (nextFrameTime + 1) % FrameHistorySize;
+    }
+    ++stats.frames;
+
+    if (!L || mode == Mode::Automatic) return;
+
+    const size_t heapKB = GetHeapKB();
+    const size_t baseKB = std::max(heapKBAfterCycle, MinCycleHeapKB);
+
+    if (mode == Mode::Incremental) {
+        if (emergency && heapKB < baseKB * CycleStartGrowth) {
+            // Lua's own collector finished the cycle and brought the heap back down
+            emergency = false;
+            cycleActive = false;
+            heapKBAfterCycle = heapKB;
+            return;
+        }
+        if (!emergency && heapKB > baseKB * EmergencyGrowth) {
+            // The budget is not keeping up: Lua's pause has been reached and it is
+            // collecting during allocations; keep stepping to finish the cycle sooner
+            emergency = true;
+            ++stats.emergencies;
+        }
+        if (!cycleActive && heapKB < baseKB * CycleStartGrowth) return;
+        cycleActive = true;
+    } else {
+        // Generational: Lua's own collections count too
+        heapKBAfterCycle = std::min(heapKBAfterCycle, heapKB);
+        if (heapKB < heapKBAfterCycle + static_cast<size_t>(stepKB)) return;
+    }
+
+    const double budget = std::min(budgetMs * 0.001, targetFrameSeconds - frameSeconds);
+    if (budget <= 0.0) return;
+
+    const Clock::time_point start = Clock::now();
+    do {
+        const Clock::time_point stepStart = Clock::now();
+        const bool finished = mode == Mode::Incremental
+            ? lua_gc(L, LUA_GCSTEP, stepKB) != 0
+            : (lua_gc(L, LUA_GCSTEP, 0), true);   // one minor collection
+        RecordPause(SecondsSince(stepStart));
+
+        if (finished) {
+            ++stats.cycles;
+            cycleActive = false;
+            emergency = false;
+            heapKBAfterCycle = GetHeapKB();
+            break;
+        }
+    } while (SecondsSince(start) < budget);
+}
+
+void LuaGcScheduler::FullCollect() {
+    if (!L) return;
+
+    const Clock::time_point start = Clock::now();
+    lua_gc(L, LUA_GCCOLLECT);
+    RecordPause(SecondsSince(start));
+    ++stats.cycles;
+
+    cycleActive = false;
+    emergency = false;
+    heapKBAfterCycle = GetHeapKB();
+}
+
+double LuaGcScheduler::GetFrameTimePercentile(double percentile) const {
+    if (frameTimes.empty()) return 0.0;
+
+    std::vector<float> sorted = frameTimes;
+    size_t index = static_cast<size_t>(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(sorted.size() - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+void LuaGcScheduler::ResetStats() {
+    stats = Stats{};
+    frameTimes.clear();
+    nextFrameTime = 0;
+}
+
+void LuaGcScheduler::RecordPause(double seconds) {
+    const double micros = seconds * 1e6;
+    size_t bucket = 0;
+    while (bucket < PauseBucketCount - 1 && micros >= PauseBucketLimitsMicros[bucket]) {
+        ++bucket;
+    }
+    ++stats.pauseHistogram[bucket];
+    ++stats.steps;
+    stats.totalSeconds += seconds;
+    stats.maxPauseSeconds = std::max(stats.maxPauseSeconds, seconds);
+}
+
+const char* LuaGcScheduler::GetModeName(Mode mode) {
+    switch (mode) {
+        case Mode::Automatic: return "auto";
+        case Mode::Incremental: return "incremental";
+        case Mode::Generational: return "generational";
+        default: return "?";
+    }
+}
+
+double LuaGcScheduler::GetPauseBucketLimitMicros(size_t bucket) {
+    return bucket < PauseBucketCount - 1 ? PauseBucketLimitsMicros[bucket] : 0.0;
+}
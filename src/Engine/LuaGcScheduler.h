@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct lua_State;
+
+/**
+ * LuaGcScheduler - runs the Lua collector in the frame's leftover time
+ * Incremental mode advances Lua's collector in small steps from Step(), at most
+ * GetBudgetMs() per frame and never past the frame target. A cycle starts once the heap
+ * has grown by CycleStartGrowth since the last one finished. Lua's own collector stays
+ * on with its pause set to EmergencyGrowth: if the budget cannot keep up, or Step() is
+ * never called, Lua starts the cycle itself and the heap stays bounded (counted in
+ * Stats::emergencies). Generational mode (the default) keeps Lua's collector on and adds
+ * minor collections from Step() so fewer of them land mid-frame. Automatic leaves
+ * everything to Lua (the old behaviour, useful for comparisons).
+ *
+ * Every step is timed into a pause histogram; frame times passed to Step() are kept for
+ * percentiles.
+ */
+class LuaGcScheduler {
+public:
+    enum class Mode : uint8_t {
+        Automatic,
+        Incremental,
+        Generational
+    };
+
+    static constexpr size_t PauseBucketCount = 8;
+    static constexpr size_t FrameHistorySize = 1024;
+    static constexpr double CycleStartGrowth = 1.5;
+    static constexpr double EmergencyGrowth = 2.0;
+
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t steps = 0;
+        uint64_t cycles = 0;
+        uint64_t emergencies = 0;
+        double totalSeconds = 0.0;
+        double maxPauseSeconds = 0.0;
+        std::array<uint64_t, PauseBucketCount> pauseHistogram{};
+    };
+
+    void Attach(lua_State* state);
+
+    void SetMode(Mode newMode);
+    Mode GetMode() const { return mode; }
+
+    // Upper bound on GC time per frame
+    void SetBudgetMs(double ms) { budgetMs = ms < 0.0 ? 0.0 : ms; }
+    double GetBudgetMs() const { return budgetMs; }
+
+    // Call once per frame after rendering with how long the frame took so far and the
+    // frame time being aimed for; collects for at most min(budget, target - frame)
+    void Step(double frameSeconds, double targetFrameSeconds);
+
+    // Runs a complete cycle now, whatever the budget
+    void FullCollect();
+
+    size_t GetHeapKB() const;
+    const Stats& GetStats() const { return stats; }
+    // Percentile (0..1) of the recorded frame times, in seconds
+    double GetFrameTimePercentile(double percentile) const;
+    void ResetStats();
+
+    static const char* GetModeName(Mode mode);
+    // Upper edge of a pause bucket in microseconds (the last bucket is open-ended)
+    static double GetPauseBucketLimitMicros(size_t bucket);
+
+private:
+    void RecordPause(double seconds);
+
+    lua_State* L = nullptr;
+    Mode mode = Mode::Generational;
+    double budgetMs = 1.0;
+    int stepKB = 32;
+
+    bool cycleActive = false;
+    bool emergency = false;
+    size_t heapKBAfterCycle = 0;
+
+    Stats stats;
+    std::vector<float> frameTimes;
+    size_t nextFrameTime = 0;
+};
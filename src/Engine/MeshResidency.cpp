@@ -0,0 +1,254 @@
+#include "MeshResidency.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+static_assert(sizeof(Vertex) == 32, "Vertex is uploaded as-is");
+static_assert(sizeof(MeshResidency::IndirectCommand) == 20, "matches DrawElementsIndirectCommand");
+
+MeshResidency::MeshResidency(uint32_t arenaVertices, uint32_t arenaIndices, uint32_t stagingSegmentBytes)
+    : arenaVertices(arenaVertices), arenaIndices(arenaIndices), stagingSegmentBytes(stagingSegmentBytes) {
+}
+
+MeshResidency::~MeshResidency() = default;
+
+bool MeshResidency::Init(std::function<void()> configure) {
+    configureVao = std::move(configure);
+
+    multiDrawSupported = false;
+#ifdef GL_VERSION_4_3
+    multiDrawSupported = multiDrawSupported || GLAD_GL_VERSION_4_3;
+#endif
+#if defined(GL_ARB_multi_draw_indirect) && defined(GL_ARB_base_instance)
+    multiDrawSupported = multiDrawSupported || (GLAD_GL_ARB_multi_draw_indirect && GLAD_GL_ARB_base_instance);
+#endif
+    if (multiDrawSupported) {
+        glGenBuffers(1, &indirectBuffer);
+    }
+
+    bool bufferStorage = false;
+#ifdef GL_VERSION_4_4
+    bufferStorage = bufferStorage || GLAD_GL_VERSION_4_4;
+#endif
+#ifdef GL_ARB_buffer_storage
+    bufferStorage = bufferStorage || GLAD_GL_ARB_buffer_storage;
+#endif
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+    if (bufferStorage && stagingSegmentBytes > 0) {
+        const GLsizeiptr bytes = static_cast<GLsizeiptr>(StagingSegments) * stagingSegmentBytes;
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &staging);
+        glBindBuffer(GL_COPY_READ_BUFFER, staging);
+        glBufferStorage(GL_COPY_READ_BUFFER, bytes, nullptr, flags);
+        stagingMapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, bytes, flags));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        if (!stagingMapped) {
+            std::cerr << "Mesh staging buffer mapping failed, uploading with glBufferSubData" << std::endl;
+            glDeleteBuffers(1, &staging);
+            staging = 0;
+        }
+    }
+#else
+    (void)bufferStorage;
+#endif
+    return true;
+}
+
+void MeshResidency::Shutdown() {
+    for (void*& fence : stagingFences) {
+        if (fence) glDeleteSync(static_cast<GLsync>(fence));
+        fence = nullptr;
+    }
+    if (staging) {
+        if (stagingMapped) {
+            glBindBuffer(GL_COPY_READ_BUFFER, staging);
+            glUnmapBuffer(GL_COPY_READ_BUFFER);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &staging);
+    }
+    staging = 0;
+    stagingMapped = nullptr;
+
+    for (Arena& arena : arenas) {
+        glDeleteVertexArrays(1, &arena.vao);
+        glDeleteBuffers(1, &arena.vertexBuffer);
+        glDeleteBuffers(1, &arena.indexBuffer);
+    }
+    arenas.clear();
+    slots.clear();
+    freeSlots.clear();
+
+    if (indirectBuffer) glDeleteBuffers(1, &indirectBuffer);
+    indirectBuffer = 0;
+    stats = Stats{};
+}
+
+uint32_t MeshResidency::CreateArena(uint32_t vertexCapacity, uint32_t indexCapacity) {
+    Arena arena;
+    arena.vertices = RangeAllocator(vertexCapacity);
+    arena.indices = RangeAllocator(indexCapacity);
+
+    glGenVertexArrays(1, &arena.vao);
+    glGenBuffers(1, &arena.vertexBuffer);
+    glGenBuffers(1, &arena.indexBuffer);
+
+    glBindVertexArray(arena.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, arena.vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexCapacity) * sizeof(Vertex), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arena.indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexCapacity) * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(TexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    glEnableVertexAttribArray(TexCoordLocation);
+
+    if (configureVao) configureVao();
+    glBindVertexArray(0);
+
+    arenas.push_back(std::move(arena));
+    return static_cast<uint32_t>(arenas.size() - 1);
+}
+
+MeshResidency::Handle MeshResidency::Upload(const Mesh& mesh) {
+    return Upload(mesh.vertices.data(), static_cast<uint32_t>(mesh.vertices.size()),
+                  mesh.indices.data(), static_cast<uint32_t>(mesh.indices.size()));
+}
+
+MeshResidency::Handle MeshResidency::Upload(const Vertex* vertices, uint32_t vertexCount,
+                                            const uint32_t* indices, uint32_t indexCount) {
+    if (vertexCount == 0 || indexCount == 0) return InvalidHandle;
+    // The all-ones index is never issued, so InvalidHandle can't name a slot
+    if (freeSlots.empty() && slots.size() >= HandleIndexMask) {
+        std::cerr << "MeshResidency: out of mesh handles" << std::endl;
+        return InvalidHandle;
+    }
+
+    MeshRecord record;
+    record.vertexCount = vertexCount;
+    record.indexCount = indexCount;
+
+    // First arena with room for both ranges
+    bool placed = false;
+    for (uint32_t a = 0; a < arenas.size() && !placed; ++a) {
+        const uint32_t baseVertex = arenas[a].vertices.Allocate(vertexCount);
+        if (baseVertex == RangeAllocator::InvalidOffset) continue;
+        const uint32_t firstIndex = arenas[a].indices.Allocate(indexCount);
+        if (firstIndex == RangeAllocator::InvalidOffset) {
+            arenas[a].vertices.Free(baseVertex, vertexCount);
+            continue;
+        }
+        record.arena = a;
+        record.baseVertex = baseVertex;
+        record.firstIndex = firstIndex;
+        placed = true;
+    }
+    if (!placed) {
+        record.arena = CreateArena(std::max(arenaVertices, vertexCount), std::max(arenaIndices, indexCount));
+        record.baseVertex = arenas[record.arena].vertices.Allocate(vertexCount);
+        record.firstIndex = arenas[record.arena].indices.Allocate(indexCount);
+    }
+    record.resident = true;
+
+    // Indices stay mesh-relative; baseVertex is applied at draw time
+    const Arena& arena = arenas[record.arena];
+    Write(arena.vertexBuffer, static_cast<size_t>(record.baseVertex) * sizeof(Vertex), vertices,
+          static_cast<size_t>(vertexCount) * sizeof(Vertex));
+    Write(arena.indexBuffer, static_cast<size_t>(record.firstIndex) * sizeof(uint32_t), indices,
+          static_cast<size_t>(indexCount) * sizeof(uint32_t));
+
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    slots[index].record = record;
+    ++stats.meshes;
+    return index | (slots[index].generation << HandleIndexBits);
+}
+
+void MeshResidency::Release(Handle handle) {
+    if (!GetRecord(handle)) return;
+    Slot& slot = slots[handle & HandleIndexMask];
+    MeshRecord& record = slot.record;
+    arenas[record.arena].vertices.Free(record.baseVertex, record.vertexCount);
+    arenas[record.arena].indices.Free(record.firstIndex, record.indexCount);
+    record.resident = false;
+    if (slot.generation < MaxHandleGeneration) {
+        ++slot.generation;
+        freeSlots.push_back(handle & HandleIndexMask);
+    }
+    --stats.meshes;
+}
+
+void MeshResidency::Write(unsigned buffer, size_t offset, const void* data, size_t bytes) {
+    stats.uploadedBytes += bytes;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (!staging) {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        return;
+    }
+
+    // Through the ring in pieces of at most one segment
+    glBindBuffer(GL_COPY_READ_BUFFER, staging);
+    const unsigned char* source = static_cast<const unsigned char*>(data);
+    while (bytes > 0) {
+        if (stagingCursor == stagingSegmentBytes) NextStagingSegment();
+
+        const size_t chunk = std::min(bytes, static_cast<size_t>(stagingSegmentBytes) - stagingCursor);
+        const size_t stagingOffset = static_cast<size_t>(stagingSegment) * stagingSegmentBytes + stagingCursor;
+        std::memcpy(stagingMapped + stagingOffset, source, chunk);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(stagingOffset),
+                            static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(chunk));
+
+        stagingCursor += chunk;
+        stats.stagedBytes += chunk;
+        source += chunk;
+        offset += chunk;
+        bytes -= chunk;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void MeshResidency::NextStagingSegment() {
+    // The copies out of this segment are in the command stream; fence them
+    stagingFences[stagingSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    stagingSegment = (stagingSegment + 1) % StagingSegments;
+    stagingCursor = 0;
+    if (GLsync fence = static_cast<GLsync>(stagingFences[stagingSegment])) {
+        if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) {
+            ++stats.stagingWaits;
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+        }
+        glDeleteSync(fence);
+        stagingFences[stagingSegment] = nullptr;
+    }
+}
+
+void MeshResidency::EndFrame() {
+    // Nothing staged since the last segment switch: keep filling it next frame
+    if (staging && stagingCursor > 0) NextStagingSegment();
+}
+
+void MeshResidency::MultiDraw(const std::vector<IndirectCommand>& commands) {
+    if (commands.empty()) return;
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_multi_draw_indirect)
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(commands.size() * sizeof(IndirectCommand)),
+                 commands.data(), GL_STREAM_DRAW);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(commands.size()),
+                                sizeof(IndirectCommand));
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    ++stats.multiDraws;
+#endif
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Model.h"
+#include "RangeAllocator.h"
+
+/**
+ * MeshResidency - GPU copies of Mesh geometry, packed into shared vertex/index buffers
+ * Meshes are sub-allocated (RangeAllocator) from arenas: one large vertex buffer, index
+ * buffer and VAO each, so meshes in the same arena draw without rebinding anything.
+ * A new arena is opened when no existing one has room (or sized to fit a mesh larger
+ * than the default). Each record carries baseVertex/firstIndex for
+ * glDrawElementsInstancedBaseVertex or an indirect command.
+ *
+ * Uploads go through a ring of persistently mapped staging segments and
+ * glCopyBufferSubData when buffer storage (GL 4.4 / ARB_buffer_storage) is available;
+ * each segment is fenced when the ring moves past it and waited on before it is written
+ * again. Otherwise they fall back to glBufferSubData. GL thread only.
+ */
+class MeshResidency {
+public:
+    // Slot index in the low bits, that slot's generation above them, so a released handle
+    // stays invalid after its slot is reused. Bumped on Release; a slot whose generation
+    // would wrap is retired instead of reused.
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = ~0u;
+    static constexpr uint32_t HandleIndexBits = 20;
+    static constexpr uint32_t HandleIndexMask = (1u << HandleIndexBits) - 1;
+    static constexpr uint32_t MaxHandleGeneration = ~0u >> HandleIndexBits;
+
+    // Vertex layout: location 0 position, 1 normal, 7 texCoord (2-6 are left for instances)
+    static constexpr unsigned TexCoordLocation = 7;
+
+    struct MeshRecord {
+        uint32_t arena = 0;
+        uint32_t baseVertex = 0;
+        uint32_t vertexCount = 0;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        bool resident = false;
+    };
+
+    // DrawElementsIndirectCommand
+    struct IndirectCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t baseInstance;
+    };
+
+    struct Stats {
+        uint32_t meshes = 0;
+        uint64_t uploadedBytes = 0;
+        uint64_t stagedBytes = 0;       // of uploadedBytes, went through the staging ring
+        uint32_t stagingWaits = 0;      // times a segment was still in use by the GPU
+        uint32_t multiDraws = 0;
+    };
+
+    explicit MeshResidency(uint32_t arenaVertices = 1u << 18, uint32_t arenaIndices = 1u << 20,
+                           uint32_t stagingSegmentBytes = 4u << 20);
+    ~MeshResidency();
+
+    MeshResidency(const MeshResidency&) = delete;
+    MeshResidency& operator=(const MeshResidency&) = delete;
+
+    // Needs a current GL context; configureVao runs with every new arena's VAO bound
+    bool Init(std::function<void()> configureVao = {});
+    void Shutdown();
+
+    Handle Upload(const Mesh& mesh);
+    Handle Upload(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+    // The ranges are reused by later uploads; draws already issued still see the old data
+    void Release(Handle handle);
+
+    // Null for released (or never issued) handles, even once their slot holds another mesh
+    const MeshRecord* GetRecord(Handle handle) const {
+        const uint32_t index = handle & HandleIndexMask;
+        if (index >= slots.size()) return nullptr;
+        const Slot& slot = slots[index];
+        return slot.record.resident && slot.generation == handle >> HandleIndexBits ? &slot.record : nullptr;
+    }
+    unsigned GetArenaVao(uint32_t arena) const { return arena < arenas.size() ? arenas[arena].vao : 0; }
+    size_t GetArenaCount() const { return arenas.size(); }
+    const RangeAllocator& GetVertexAllocator(uint32_t arena) const { return arenas[arena].vertices; }
+    const RangeAllocator& GetIndexAllocator(uint32_t arena) const { return arenas[arena].indices; }
+
+    // glMultiDrawElementsIndirect with baseInstance (GL 4.3, or the ARB extensions)
+    bool SupportsMultiDrawIndirect() const { return multiDrawSupported; }
+    bool UsesStaging() const { return staging != 0; }
+    // Issues commands for meshes of one arena in one call; the arena's VAO must be bound
+    void MultiDraw(const std::vector<IndirectCommand>& commands);
+
+    // Fences the staging writes of this frame so the ring can come back to them
+    void EndFrame();
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    struct Arena {
+        unsigned vao = 0;
+        unsigned vertexBuffer = 0;
+        unsigned indexBuffer = 0;
+        RangeAllocator vertices;
+        RangeAllocator indices;
+    };
+
+    struct Slot {
+        MeshRecord record;
+        uint32_t generation = 0;
+    };
+
+    static constexpr int StagingSegments = 3;
+
+    uint32_t CreateArena(uint32_t vertexCapacity, uint32_t indexCapacity);
+    void Write(unsigned buffer, size_t offset, const void* data, size_t bytes);
+    void NextStagingSegment();
+
+    uint32_t arenaVertices;
+    uint32_t arenaIndices;
+    std::function<void()> configureVao;
+    std::vector<Arena> arenas;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    bool multiDrawSupported = false;
+    unsigned indirectBuffer = 0;
+
+    unsigned staging = 0;
+    unsigned char* stagingMapped = nullptr;
+    uint32_t stagingSegmentBytes;
+    int stagingSegment = 0;
+    size_t stagingCursor = 0;          // within the current segment
+    void* stagingFences[StagingSegments] = {};   // GLsync
+
+    Stats stats;
+};
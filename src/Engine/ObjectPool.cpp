@@ -0,0 +1,169 @@
+#include "ObjectPool.h"
+#include <array>
+#include <atomic>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> s_allocations{0};
+    std::atomic<uint64_t> s_frees{0};
+    std::atomic<uint64_t> s_heapAllocations{0};
+
+    constexpr size_t SizeClassCount = ObjectPools::MaxPooledSize / ObjectPools::Granularity;
+
+    // Pools are created on first use and never destroyed: actors owned by statics may
+    // still be freed during shutdown, after any function-local static would be gone
+    struct PoolTable {
+        std::array<std::atomic<ObjectPool*>, SizeClassCount> pools{};
+        std::mutex createMutex;
+        std::vector<ObjectPool*> typePools; // guarded by createMutex
+    };
+
+    PoolTable& GetPoolTable() {
+        static PoolTable* table = new PoolTable();
+        return *table;
+    }
+
+    size_t RoundToGranularity(size_t size) {
+        return (size + ObjectPools::Granularity - 1) / ObjectPools::Granularity * ObjectPools::Granularity;
+    }
+
+    size_t GetSizeClass(size_t size) {
+        return (size + ObjectPools::Granularity - 1) / ObjectPools::Granularity - 1;
+    }
+
+    ObjectPool& GetSizeClassPool(size_t sizeClass) {
+        PoolTable& table = GetPoolTable();
+        ObjectPool* pool = table.pools[sizeClass].load(std::memory_order_acquire);
+        if (!pool) {
+            std::lock_guard<std::mutex> lock(table.createMutex);
+            pool = table.pools[sizeClass].load(std::memory_order_relaxed);
+            if (!pool) {
+                pool = new ObjectPool((sizeClass + 1) * ObjectPools::Granularity);
+                table.pools[sizeClass].store(pool, std::memory_order_release);
+            }
+        }
+        return *pool;
+    }
+}
+
+ObjectPool::ObjectPool(size_t slotSize, size_t slotsPerChunk)
+    : slotSize(slotSize < sizeof(FreeSlot) ? sizeof(FreeSlot) : slotSize),
+      slotsPerChunk(slotsPerChunk) {
+}
+
+ObjectPool::~ObjectPool() {
+    for (void* chunk : chunks) {
+        ::operator delete(chunk);
+    }
+}
+
+void* ObjectPool::Allocate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeList) {
+        AddChunk(slotsPerChunk);
+    }
+
+    FreeSlot* slot = freeList;
+    freeList = slot->next;
+    --freeCount;
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+void ObjectPool::Free(void* slot) {
+    if (!slot) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    FreeSlot* freed = static_cast<FreeSlot*>(slot);
+    freed->next = freeList;
+    freeList = freed;
+    ++freeCount;
+    s_frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ObjectPool::Reserve(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeCount < count) {
+        AddChunk(count - freeCount);
+    }
+}
+
+size_t ObjectPool::GetLiveCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity - freeCount;
+}
+
+size_t ObjectPool::GetCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity;
+}
+
+void ObjectPool::AddChunk(size_t slotCount) {
+    std::byte* chunk = static_cast<std::byte*>(::operator new(slotCount * slotSize));
+    chunks.push_back(chunk);
+    s_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    // Thread the new slots onto the free list in address order
+    for (size_t i = slotCount; i-- > 0;) {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(chunk + i * slotSize);
+        slot->next = freeList;
+        freeList = slot;
+    }
+    freeCount += slotCount;
+    capacity += slotCount;
+}
+
+namespace ObjectPools {
+    void* Allocate(size_t size) {
+        if (size == 0) size = 1;
+        if (size > MaxPooledSize) {
+            s_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+        return GetSizeClassPool(GetSizeClass(size)).Allocate();
+    }
+
+    void Free(void* ptr, size_t size) {
+        if (!ptr) return;
+        if (size == 0) size = 1;
+        if (size > MaxPooledSize) {
+            ::operator delete(ptr);
+            return;
+        }
+        GetSizeClassPool(GetSizeClass(size)).Free(ptr);
+    }
+
+    void Reserve(size_t size, size_t count) {
+        if (size == 0 || size > MaxPooledSize || count == 0) return;
+        GetSizeClassPool(GetSizeClass(size)).Reserve(count);
+    }
+
+    ObjectPool& CreateTypePool(size_t size) {
+        // Slots stay Granularity-aligned: chunks come from operator new
+        ObjectPool* pool = new ObjectPool(RoundToGranularity(size == 0 ? 1 : size));
+        PoolTable& table = GetPoolTable();
+        std::lock_guard<std::mutex> lock(table.createMutex);
+        table.typePools.push_back(pool);
+        return *pool;
+    }
+
+    PoolStats GetStats() {
+        PoolStats stats;
+        stats.allocations = s_allocations.load(std::memory_order_relaxed);
+        stats.frees = s_frees.load(std::memory_order_relaxed);
+        stats.heapAllocations = s_heapAllocations.load(std::memory_order_relaxed);
+
+        auto addPool = [&stats](const ObjectPool& pool) {
+            stats.liveObjects += pool.GetLiveCount();
+            stats.reservedBytes += pool.GetCapacity() * pool.GetSlotSize();
+        };
+
+        PoolTable& table = GetPoolTable();
+        for (const auto& entry : table.pools) {
+            if (const ObjectPool* pool = entry.load(std::memory_order_acquire)) addPool(*pool);
+        }
+        std::lock_guard<std::mutex> lock(table.createMutex);
+        for (const ObjectPool* pool : table.typePools) addPool(*pool);
+        return stats;
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * ObjectPool - free-list allocator for slots of one fixed size
+ * Slots are carved out of chunks that live as long as the pool. Freed slots go on an
+ * intrusive free list and are handed out again before any new chunk is allocated, so a
+ * pool that has been reserved for its peak never reaches the heap. Thread-safe.
+ */
+class ObjectPool {
+public:
+    explicit ObjectPool(size_t slotSize, size_t slotsPerChunk = 64);
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    void* Allocate();
+    void Free(void* slot);
+
+    // Makes sure at least count more slots can be allocated without a new chunk
+    void Reserve(size_t count);
+
+    size_t GetSlotSize() const { return slotSize; }
+    size_t GetLiveCount() const;
+    size_t GetCapacity() const;
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    // Caller holds the mutex
+    void AddChunk(size_t slotCount);
+
+    size_t slotSize;
+    size_t slotsPerChunk;
+
+    mutable std::mutex mutex;
+    FreeSlot* freeList = nullptr;
+    size_t freeCount = 0;
+    size_t capacity = 0;
+    std::vector<void*> chunks;
+};
+
+/**
+ * Process-wide counters for the pooled allocators
+ * heapAllocations counts every trip to the system allocator (new chunks and requests too
+ * large to pool); a warmed-up spawn/destroy loop should leave it unchanged.
+ */
+struct PoolStats {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t heapAllocations = 0;
+    size_t liveObjects = 0;
+    size_t reservedBytes = 0;
+};
+
+/**
+ * ObjectPools - process-wide pools
+ * GetPool<T>() is the pool for one concrete type: World::SpawnActor and
+ * Actor::CreateComponent construct into it with New<T>, so every actor and component
+ * class has its own free list. Allocate/Free serve untyped requests from size-class pools
+ * (rounded up to Granularity bytes); requests above MaxPooledSize go to the heap.
+ */
+namespace ObjectPools {
+    constexpr size_t Granularity = 16;
+    constexpr size_t MaxPooledSize = 4096;
+
+    void* Allocate(size_t size);
+    void Free(void* ptr, size_t size);
+
+    // Pre-allocates room for count objects of the given size
+    void Reserve(size_t size, size_t count);
+
+    PoolStats GetStats();
+
+    // Creates a pool for objects of size bytes that lives for the rest of the process
+    // and is included in GetStats. Use GetPool<T>() rather than calling this directly.
+    ObjectPool& CreateTypePool(size_t size);
+
+    template<typename T>
+    ObjectPool& GetPool() {
+        static_assert(alignof(T) <= Granularity, "ObjectPools cannot over-align");
+        static ObjectPool& pool = CreateTypePool(sizeof(T));
+        return pool;
+    }
+
+    // Constructs a T in a slot of GetPool<T>(); the slot is returned if the constructor throws
+    template<typename T, typename... Args>
+    T* New(Args&&... args) {
+        ObjectPool& pool = GetPool<T>();
+        void* slot = pool.Allocate();
+        try {
+            return ::new (slot) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pool.Free(slot);
+            throw;
+        }
+    }
+}
+
+/**
+ * Standard allocator over ObjectPools, for containers whose nodes are created per spawn
+ * Single objects (hash nodes) come from the pool for T; arrays use the size classes.
+ */
+template<typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    static_assert(alignof(T) <= ObjectPools::Granularity, "PoolAllocator cannot over-align");
+
+    PoolAllocator() = default;
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        if (count == 1) return static_cast<T*>(ObjectPools::GetPool<T>().Allocate());
+        return static_cast<T*>(ObjectPools::Allocate(count * sizeof(T)));
+    }
+    void deallocate(T* ptr, size_t count) {
+        if (count == 1) {
+            ObjectPools::GetPool<T>().Free(ptr);
+            return;
+        }
+        ObjectPools::Free(ptr, count * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
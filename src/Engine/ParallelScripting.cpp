@@ -0,0 +1,217 @@
+#include "ParallelScripting.h"
+#include "Scripting.h"
+#include "Components.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Worker-side read; Transform getters don't write, so shards can share the registry
+    const Transform& GetTransformForRead(entt::registry& reg, uint32_t id) {
+        const Transform* t = reg.try_get<Transform>((entt::entity)id);
+        if (!t) throw sol::error("No Transform on entity " + std::to_string(id));
+        return *t;
+    }
+}
+
+ParallelScriptRunner::ParallelScriptRunner(unsigned threadCount, ScriptWatchdog& watchdog, ScriptProfiler& profiler)
+    : jobs(JobSystem::Shared())
+    , watchdog(watchdog)
+    , profiler(profiler) {
+    threadCount = std::max(threadCount, 1u);
+    shards.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+        InitShard(*shards.back());
+    }
+}
+
+ParallelScriptRunner::~ParallelScriptRunner() = default;
+
+void ParallelScriptRunner::InitShard(Shard& shard) {
+    sol::state& lua = shard.lua;
+    Shard* owner = &shard;
+    lua.open_libraries(sol::lib::base, sol::lib::math, sol::lib::table, sol::lib::string);
+    Scripting::registerValueTypes(lua);
+
+    // The profiler only names scripts in reports; it belongs to the main state, so no sampling
+    shard.watchdog.Attach(lua.lua_state(), &profiler, false);
+
+    lua["Print"] = [owner](const std::string& s){ owner->output.push_back(s); };
+
+    // Reads
+    lua["GetRotation"] = [owner](uint32_t id){
+        glm::vec3 r = GetTransformForRead(*owner->reg, id).GetRotationEuler();
+        return std::make_tuple(r.x, r.y, r.z);
+    };
+    lua["GetRotationQuat"] = [owner](uint32_t id){
+        const glm::quat& q = GetTransformForRead(*owner->reg, id).GetRotation();
+        return std::make_tuple(q.w, q.x, q.y, q.z);
+    };
+    lua["GetRotations"] = [owner](sol::table ids, sol::optional<sol::table> out, sol::this_state s){
+        const size_t count = ids.size();
+        sol::table rotations = out ? *out : sol::state_view(s).create_table(static_cast<int>(count * 3), 0);
+        for (size_t i = 0; i < count; ++i) {
+            glm::vec3 r = GetTransformForRead(*owner->reg, ids.raw_get<uint32_t>(i + 1)).GetRotationEuler();
+            rotations.raw_set(i * 3 + 1, r.x, i * 3 + 2, r.y, i * 3 + 3, r.z);
+        }
+        return rotations;
+    };
+
+    // Writes, buffered until every shard is done
+    auto setRotation = [owner](uint32_t id, const glm::vec3& v){
+        owner->commands.push_back({Command::Type::SetRotationEuler, (entt::entity)id, glm::vec4(v, 0.0f)});
+    };
+    lua["SetRotation"] = sol::overload(
+        setRotation,
+        [setRotation](uint32_t id, sol::table t){
+            setRotation(id, glm::vec3{t.get_or(1, 0.0f), t.get_or(2, 0.0f), t.get_or(3, 0.0f)});
+        });
+    lua["SetRotationQuat"] = [owner](uint32_t id, float w, float x, float y, float z){
+        owner->commands.push_back({Command::Type::SetRotationQuat, (entt::entity)id, glm::vec4(x, y, z, w)});
+    };
+    lua["SetRotations"] = [owner](sol::table ids, sol::table rotations){
+        const size_t count = ids.size();
+        for (size_t i = 0; i < count; ++i) {
+            glm::vec4 r{rotations.raw_get_or(i * 3 + 1, 0.0f),
+                        rotations.raw_get_or(i * 3 + 2, 0.0f),
+                        rotations.raw_get_or(i * 3 + 3, 0.0f), 0.0f};
+            owner->commands.push_back({Command::Type::SetRotationEuler, (entt::entity)ids.raw_get<uint32_t>(i + 1), r});
+        }
+    };
+}
+
+size_t ParallelScriptRunner::Run(entt::registry& reg, float dt) {
+    size_t ticked = 0;
+    for (auto& shard : shards) {
+        shard->reg = &reg;
+        shard->watchdog.SetEnabled(watchdog.IsEnabled());
+        ticked += shard->entities.size();
+    }
+    if (ticked == 0) return 0;
+
+    // Shards read the main watchdog's budgets while this thread waits; nothing writes them
+
+    // One job per shard: a Lua state is only ever used by one thread at a time
+    jobs.ParallelFor(shards.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            RunShard(*shards[i], dt);
+        }
+    });
+
+    for (auto& shard : shards) {
+        CollectTrips(*shard);
+        ApplyCommands(reg, *shard);
+        for (const std::string& line : shard->output) {
+            std::cout << line << std::endl;
+        }
+        shard->output.clear();
+    }
+    return ticked;
+}
+
+void ParallelScriptRunner::RunShard(Shard& shard, float dt) {
+    for (const auto& [e, loaded] : shard.entities) {
+        ShardScript* script = Prepare(shard, *loaded);
+        if (!script || shard.watchdog.IsDisabled(script->profileId)) continue;
+
+        if (script->onTickBatch.valid()) {
+            if (script->batchEntities.empty()) shard.batched.push_back(script);
+            script->batchEntities.push_back(e);
+        } else if (script->onTick.valid()) {
+            ScriptWatchdog::Guard guard(shard.watchdog, script->profileId, ScriptProfiler::Callback::OnTick,
+                                        watchdog.GetBudget(script->profileId));
+            auto result = script->onTick((uint32_t)e, dt);
+            if (shard.watchdog.IsDisabled(script->profileId)) shard.tripped.push_back(script->profileId);
+            if (!result.valid()) {
+                sol::error err = result;
+                shard.output.push_back(std::string("Lua OnTick error: ") + err.what());
+            }
+        }
+    }
+    shard.entities.clear();
+
+    for (ShardScript* script : shard.batched) {
+        const size_t count = script->batchEntities.size();
+        for (size_t i = 0; i < count; ++i) script->batchIds.raw_set(i + 1, (uint32_t)script->batchEntities[i]);
+        for (size_t i = count; i < script->batchIdCount; ++i) script->batchIds.raw_set(i + 1, sol::lua_nil);
+        script->batchIdCount = count;
+        script->batchEntities.clear();
+
+        ScriptWatchdog::Guard guard(shard.watchdog, script->profileId, ScriptProfiler::Callback::OnTickBatch,
+                                    watchdog.GetBudget(script->profileId).ForBatch(count));
+        auto result = script->onTickBatch(script->batchIds, dt);
+        if (shard.watchdog.IsDisabled(script->profileId)) shard.tripped.push_back(script->profileId);
+        if (!result.valid()) {
+            sol::error err = result;
+            shard.output.push_back(std::string("Lua OnTickBatch error: ") + err.what());
+        }
+    }
+    shard.batched.clear();
+}
+
+void ParallelScriptRunner::CollectTrips(Shard& shard) {
+    // One report per trip, in the same order. The main watchdog decides from here on:
+    // the shard forgets, so a reload or EnableScript there lets the script run again.
+    std::vector<std::string> reports = shard.watchdog.TakeReports();
+    for (size_t i = 0; i < shard.tripped.size(); ++i) {
+        const uint32_t id = shard.tripped[i];
+        if (!watchdog.IsDisabled(id)) watchdog.DisableScript(id, i < reports.size() ? std::move(reports[i]) : std::string());
+        shard.watchdog.EnableScript(id);
+    }
+    shard.tripped.clear();
+}
+
+ParallelScriptRunner::ShardScript* ParallelScriptRunner::Prepare(Shard& shard, const LoadedScript& loaded) {
+    ShardScript& script = shard.scripts[&loaded];
+    if (script.version == loaded.version) {
+        return script.onTick.valid() || script.onTickBatch.valid() ? &script : nullptr;
+    }
+
+    // First use in this shard, or the script was reloaded: load the main state's bytecode.
+    // A failure is remembered for this version, not retried every frame.
+    script.version = loaded.version;
+    script.profileId = loaded.profileId;
+    script.onTick = sol::protected_function();
+    script.onTickBatch = sol::protected_function();
+
+    sol::load_result chunk = shard.lua.load(std::string_view(loaded.bytecode), "@" + loaded.path, sol::load_mode::binary);
+    if (!chunk.valid()) {
+        sol::error err = chunk;
+        shard.output.push_back(std::string("Lua load error: ") + err.what());
+        return nullptr;
+    }
+    sol::environment env(shard.lua, sol::create, shard.lua.globals());
+    sol::protected_function body = chunk;
+    sol::set_environment(env, body);
+    auto res = body();
+    if (!res.valid()) {
+        sol::error err = res;
+        shard.output.push_back(std::string("Lua exec error: ") + err.what());
+        return nullptr;
+    }
+
+    sol::object onTick = env.raw_get<sol::object>("OnTick");
+    sol::object onTickBatch = env.raw_get<sol::object>("OnTickBatch");
+    script.env = std::move(env);
+    if (onTick.is<sol::protected_function>()) script.onTick = onTick.as<sol::protected_function>();
+    if (onTickBatch.is<sol::protected_function>()) script.onTickBatch = onTickBatch.as<sol::protected_function>();
+    if (!script.batchIds.valid()) script.batchIds = shard.lua.create_table();
+    return script.onTick.valid() || script.onTickBatch.valid() ? &script : nullptr;
+}
+
+void ParallelScriptRunner::ApplyCommands(entt::registry& reg, Shard& shard) {
+    for (const Command& command : shard.commands) {
+        Transform* t = reg.valid(command.entity) ? reg.try_get<Transform>(command.entity) : nullptr;
+        if (!t) continue;
+
+        switch (command.type) {
+            case Command::Type::SetRotationEuler:
+                t->SetRotationEuler(glm::vec3(command.value));
+                break;
+            case Command::Type::SetRotationQuat:
+                t->SetRotation(glm::quat(command.value.w, command.value.x, command.value.y, command.value.z));
+                break;
+        }
+    }
+    shard.commands.clear();
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <sol/sol.hpp>
+#include <glm/glm.hpp>
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "JobSystem.h"
+#include "ScriptWatchdog.h"
+
+struct LoadedScript;
+
+/**
+ * ParallelScriptRunner - ticks parallel-safe scripts on several Lua states at once
+ * Owns threadCount Lua states (shards), each run as one job on JobSystem::Shared().
+ * Every entity sticks to the shard picked from its id, so script state kept in globals
+ * stays in one place across frames; each shard loads a script from
+ * LoadedScript::bytecode the first time it needs it, and again after a reload.
+ *
+ * Inside a shard scripts may read the registry freely (GetRotation, GetRotationQuat,
+ * GetRotations), but writes (SetRotation, SetRotationQuat, SetRotations) and Print are
+ * buffered per shard and applied on the calling thread after every shard is done, in
+ * shard order. Reads therefore see the frame's state before any parallel write.
+ * Latent actions, GetTransform and profiling are main-state only.
+ *
+ * Every shard state has its own ScriptWatchdog hook, armed with the main watchdog's
+ * budgets (OnTickBatch under Budget::ForBatch). A script that trips in a shard is
+ * disabled in the main watchdog once the run is over, with the shard's report.
+ */
+class ParallelScriptRunner {
+public:
+    // threadCount Lua states, worked by the shared pool plus the calling thread. Budgets and
+    // disabled scripts come from watchdog, script names in reports from profiler.
+    ParallelScriptRunner(unsigned threadCount, ScriptWatchdog& watchdog, ScriptProfiler& profiler);
+    ~ParallelScriptRunner();
+
+    ParallelScriptRunner(const ParallelScriptRunner&) = delete;
+    ParallelScriptRunner& operator=(const ParallelScriptRunner&) = delete;
+
+    unsigned GetShardCount() const { return static_cast<unsigned>(shards.size()); }
+
+    // Queues e for this frame's Run; script must be parallel-safe
+    void Enqueue(entt::entity e, LoadedScript& script) {
+        shards[entt::to_entity(e) % shards.size()]->entities.push_back({e, &script});
+    }
+
+    // Ticks everything queued, then applies the buffered writes; returns entities ticked
+    size_t Run(entt::registry& reg, float dt);
+
+private:
+    struct Command {
+        enum class Type : uint8_t {
+            SetRotationEuler,
+            SetRotationQuat
+        };
+
+        Type type;
+        entt::entity entity;
+        glm::vec4 value;   // Euler degrees in xyz, or quaternion (x, y, z, w)
+    };
+
+    struct ShardScript {
+        uint32_t version = 0;
+        uint32_t profileId = ScriptProfiler::NoScript;
+        sol::environment env;
+        sol::protected_function onTick;
+        sol::protected_function onTickBatch;
+        sol::table batchIds;
+        size_t batchIdCount = 0;
+        std::vector<entt::entity> batchEntities;
+    };
+
+    struct Shard {
+        sol::state lua;
+        ScriptWatchdog watchdog;   // hook on lua, never samples
+        std::vector<uint32_t> tripped;   // scripts its watchdog disabled this run, in report order
+        entt::registry* reg = nullptr;
+        std::unordered_map<const LoadedScript*, ShardScript> scripts;
+        std::vector<std::pair<entt::entity, LoadedScript*>> entities;
+        std::vector<ShardScript*> batched;
+        std::vector<Command> commands;
+        std::vector<std::string> output;   // Print and errors, shown after the run
+    };
+
+    void InitShard(Shard& shard);
+    void RunShard(Shard& shard, float dt);
+    void CollectTrips(Shard& shard);
+    ShardScript* Prepare(Shard& shard, const LoadedScript& script);
+    void ApplyCommands(entt::registry& reg, Shard& shard);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    JobSystem& jobs;
+    ScriptWatchdog& watchdog;
+    ScriptProfiler& profiler;
+};
@@ -0,0 +1,81 @@
+#include "RangeAllocator.h"
+#include <cassert>
+#include <iterator>
+
+RangeAllocator::RangeAllocator(uint32_t capacity)
+    : capacity(capacity) {
+    Reset();
+}
+
+uint32_t RangeAllocator::Allocate(uint32_t size) {
+    if (size == 0) return InvalidOffset;
+
+    // Best fit keeps large ranges for large meshes; the list stays short in practice
+    auto best = freeRanges.end();
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+        if (it->second >= size && (best == freeRanges.end() || it->second < best->second)) {
+            best = it;
+            if (it->second == size) break;
+        }
+    }
+    if (best == freeRanges.end()) return InvalidOffset;
+
+    const uint32_t offset = best->first;
+    const uint32_t remaining = best->second - size;
+    freeRanges.erase(best);
+    if (remaining > 0) {
+        freeRanges.emplace(offset + size, remaining);
+    }
+    used += size;
+    return offset;
+}
+
+void RangeAllocator::Free(uint32_t offset, uint32_t size) {
+    if (size == 0 || offset == InvalidOffset) return;
+    assert(offset + size <= capacity && used >= size);
+
+    used -= size;
+    auto next = freeRanges.lower_bound(offset);
+    assert(next == freeRanges.end() || next->first >= offset + size);
+
+    // Merge with the range before and the one after when they touch
+    if (next != freeRanges.begin()) {
+        auto previous = std::prev(next);
+        assert(previous->first + previous->second <= offset);
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            freeRanges.erase(previous);
+        }
+    }
+    if (next != freeRanges.end() && next->first == offset + size) {
+        size += next->second;
+        freeRanges.erase(next);
+    }
+    freeRanges.emplace(offset, size);
+}
+
+void RangeAllocator::Grow(uint32_t newCapacity) {
+    if (newCapacity <= capacity) return;
+    const uint32_t oldCapacity = capacity;
+    capacity = newCapacity;
+    // The new tail is free; Free merges it with a free range ending at the old capacity
+    used += newCapacity - oldCapacity;
+    Free(oldCapacity, newCapacity - oldCapacity);
+}
+
+void RangeAllocator::Reset() {
+    freeRanges.clear();
+    used = 0;
+    if (capacity > 0) {
+        freeRanges.emplace(0, capacity);
+    }
+}
+
+uint32_t RangeAllocator::GetLargestFreeRange() const {
+    uint32_t largest = 0;
+    for (const auto& range : freeRanges) {
+        if (range.second > largest) largest = range.second;
+    }
+    return largest;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+/**
+ * RangeAllocator - sub-allocates [0, capacity) into ranges, in elements
+ * Best fit over a free list ordered by offset; Free() merges a range with free
+ * neighbours, so a range that is allocated and freed again leaves no trace.
+ * Knows nothing about what the elements are (MeshResidency uses one per vertex and
+ * per index buffer). Not thread-safe.
+ */
+class RangeAllocator {
+public:
+    static constexpr uint32_t InvalidOffset = ~0u;
+
+    explicit RangeAllocator(uint32_t capacity = 0);
+
+    // Offset of a free range of size elements, or InvalidOffset if none is large enough
+    uint32_t Allocate(uint32_t size);
+    // size must be what was allocated at offset
+    void Free(uint32_t offset, uint32_t size);
+
+    // Adds free space at the end (the backing storage must have grown to match)
+    void Grow(uint32_t newCapacity);
+    void Reset();
+
+    uint32_t GetCapacity() const { return capacity; }
+    uint32_t GetUsed() const { return used; }
+    uint32_t GetFree() const { return capacity - used; }
+    uint32_t GetLargestFreeRange() const;
+    size_t GetFreeRangeCount() const { return freeRanges.size(); }
+
+private:
+    uint32_t capacity = 0;
+    uint32_t used = 0;
+    std::map<uint32_t, uint32_t> freeRanges;   // offset -> size, never adjacent
+};
@@ -0,0 +1,111 @@
+#include "RenderQueue.h"
+#include "JobSystem.h"
+#include <cstring>
+
+void RenderCommandList::Draw(uint64_t key, uint32_t mesh, uint32_t material, const InstanceData& instance) {
+    packets.push_back(DrawPacket{key, mesh, material, static_cast<uint32_t>(instances.size()), 1});
+    instances.push_back(instance);
+}
+
+void RenderCommandList::Draw(uint64_t key, uint32_t mesh, uint32_t material, const InstanceData* data, uint32_t count) {
+    if (count == 0) return;
+    packets.push_back(DrawPacket{key, mesh, material, static_cast<uint32_t>(instances.size()), count});
+    instances.insert(instances.end(), data, data + count);
+}
+
+void RenderCommandList::Clear() {
+    packets.clear();
+    instances.clear();
+}
+
+void RenderQueue::SetListCount(unsigned listCount) {
+    lists.resize(listCount > 0 ? listCount : 1);
+}
+
+RenderCommandList& RenderQueue::GetThreadList(const JobSystem& jobs) {
+    return lists[jobs.GetCurrentThreadIndex() % lists.size()];
+}
+
+void RenderQueue::Clear() {
+    for (RenderCommandList& list : lists) {
+        list.Clear();
+    }
+}
+
+void RenderQueue::RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch) {
+    const size_t count = items.size();
+    if (count < 2) return;
+    scratch.resize(count);
+
+    // All eight byte histograms in one read
+    static thread_local uint32_t histograms[8][256];
+    std::memset(histograms, 0, sizeof(histograms));
+    for (const SortItem& item : items) {
+        for (int pass = 0; pass < 8; ++pass) {
+            ++histograms[pass][(item.key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    SortItem* src = items.data();
+    SortItem* dst = scratch.data();
+    for (int pass = 0; pass < 8; ++pass) {
+        uint32_t* histogram = histograms[pass];
+        // Every key has the same byte here (unused key bits): nothing to move
+        if (histogram[(src[0].key >> (pass * 8)) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            const uint32_t n = histogram[digit];
+            histogram[digit] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            dst[histogram[(src[i].key >> (pass * 8)) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != items.data()) {
+        items.swap(scratch);
+    }
+}
+
+const RenderFrame& RenderQueue::Build() {
+    frame.instances.clear();
+    frame.batches.clear();
+    frame.stats = RenderFrame::Stats{};
+
+    // value = list index in the top 16 bits, packet index below
+    sortItems.clear();
+    for (size_t l = 0; l < lists.size(); ++l) {
+        const std::vector<DrawPacket>& packets = lists[l].packets;
+        for (size_t p = 0; p < packets.size(); ++p) {
+            sortItems.push_back(SortItem{packets[p].key, (uint64_t(l) << 48) | p});
+        }
+    }
+    RadixSort(sortItems, sortScratch);
+
+    frame.stats.packets = static_cast<uint32_t>(sortItems.size());
+    const InstanceBatcher::Batch* last = nullptr;
+    for (const SortItem& item : sortItems) {
+        const RenderCommandList& list = lists[item.value >> 48];
+        const DrawPacket& packet = list.packets[item.value & 0xFFFFFFFFFFFFull];
+
+        const uint32_t first = static_cast<uint32_t>(frame.instances.size());
+        frame.instances.insert(frame.instances.end(), list.instances.begin() + packet.instanceOffset,
+                               list.instances.begin() + packet.instanceOffset + packet.instanceCount);
+
+        if (last && last->mesh == packet.mesh && last->material == packet.material) {
+            frame.batches.back().instanceCount += packet.instanceCount;
+            continue;
+        }
+        if (last) {
+            frame.stats.materialChanges += last->material != packet.material;
+            frame.stats.meshChanges += last->mesh != packet.mesh;
+        }
+        frame.batches.push_back(InstanceBatcher::Batch{packet.mesh, packet.material, first, packet.instanceCount});
+        last = &frame.batches.back();
+    }
+    frame.stats.batches = static_cast<uint32_t>(frame.batches.size());
+    return frame;
+}
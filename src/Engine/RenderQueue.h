@@ -0,0 +1,150 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "InstanceBatcher.h"
+
+class JobSystem;
+
+/**
+ * SortKey - 64-bit draw order, smallest first
+ *   opaque:      [layer:4][material:20][mesh:16][depth:24]   state first, then front to back
+ *   translucent: [layer:4][far-depth:24][material:20][mesh:16]   back to front
+ * depth01 is the view depth normalized to [0, 1]; values outside are clamped.
+ */
+namespace SortKey {
+    enum Layer : uint64_t {
+        Opaque = 0,
+        Translucent = 1,
+        Overlay = 2
+    };
+
+    inline uint32_t QuantizeDepth(float depth01) {
+        depth01 = depth01 < 0.0f ? 0.0f : (depth01 > 1.0f ? 1.0f : depth01);
+        return static_cast<uint32_t>(depth01 * 16777215.0f);
+    }
+
+    inline uint64_t MakeOpaque(uint32_t material, uint32_t mesh, float depth01) {
+        return (uint64_t(Opaque) << 60) | (uint64_t(material & 0xFFFFF) << 40) |
+               (uint64_t(mesh & 0xFFFF) << 24) | QuantizeDepth(depth01);
+    }
+
+    inline uint64_t MakeTranslucent(uint32_t material, uint32_t mesh, float depth01) {
+        return (uint64_t(Translucent) << 60) | (uint64_t(0xFFFFFF - QuantizeDepth(depth01)) << 36) |
+               (uint64_t(material & 0xFFFFF) << 16) | (mesh & 0xFFFF);
+    }
+}
+
+// One draw request; instanceOffset indexes the instances of the list that recorded it
+struct DrawPacket {
+    uint64_t key;
+    uint32_t mesh;
+    uint32_t material;
+    uint32_t instanceOffset;
+    uint32_t instanceCount;
+};
+
+/**
+ * RenderCommandList - draw packets recorded by one thread
+ * Only its owning thread writes to it between RenderQueue::Clear and RenderQueue::Build.
+ */
+class RenderCommandList {
+public:
+    void Draw(uint64_t key, uint32_t mesh, uint32_t material, const InstanceData& instance);
+    // count instances drawn as one packet, e.g. a prebuilt instance group
+    void Draw(uint64_t key, uint32_t mesh, uint32_t material, const InstanceData* instances, uint32_t count);
+
+    size_t GetPacketCount() const { return packets.size(); }
+    void Clear();
+
+private:
+    friend class RenderQueue;
+
+    std::vector<DrawPacket> packets;
+    std::vector<InstanceData> instances;
+};
+
+// Sorted, batched draws ready for a backend; every batch is one instanced draw
+struct RenderFrame {
+    struct Stats {
+        uint32_t packets = 0;
+        uint32_t batches = 0;
+        uint32_t materialChanges = 0;
+        uint32_t meshChanges = 0;
+    };
+
+    std::vector<InstanceData> instances;   // in batch order
+    std::vector<InstanceBatcher::Batch> batches;
+    Stats stats;
+};
+
+/**
+ * RenderBackend - replays a RenderFrame
+ * GLRenderBackend draws it; RecordingRenderBackend keeps copies for headless checks.
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+    virtual void Execute(const glm::mat4& viewProj, const RenderFrame& frame) = 0;
+};
+
+class RecordingRenderBackend : public RenderBackend {
+public:
+    struct Recorded {
+        glm::mat4 viewProj;
+        RenderFrame frame;
+    };
+
+    void Execute(const glm::mat4& viewProj, const RenderFrame& frame) override {
+        frames.push_back(Recorded{viewProj, frame});
+    }
+
+    const std::vector<Recorded>& GetFrames() const { return frames; }
+    void Clear() { frames.clear(); }
+
+private:
+    std::vector<Recorded> frames;
+};
+
+/**
+ * RenderQueue - per-thread command lists merged into one sorted frame
+ * Systems record into GetList(jobs.GetCurrentThreadIndex()) (or GetThreadList(jobs))
+ * from any thread; Build() then runs on one thread: it gathers every list's packets,
+ * radix-sorts them by key (stable, so equal keys keep list and record order) and
+ * coalesces runs with the same mesh and material into batches, copying their instances
+ * next to each other.
+ */
+class RenderQueue {
+public:
+    explicit RenderQueue(unsigned listCount = 1) { SetListCount(listCount); }
+
+    // Not while anything is recording
+    void SetListCount(unsigned listCount);
+    unsigned GetListCount() const { return static_cast<unsigned>(lists.size()); }
+
+    RenderCommandList& GetList(unsigned index) { return lists[index]; }
+    // The list for the calling thread's index in jobs (0 off the pool)
+    RenderCommandList& GetThreadList(const JobSystem& jobs);
+
+    const RenderFrame& Build();
+    // The last Build()
+    const RenderFrame& GetFrame() const { return frame; }
+    void Submit(RenderBackend& backend, const glm::mat4& viewProj) { backend.Execute(viewProj, Build()); }
+
+    // Empties every list; buffers keep their capacity
+    void Clear();
+
+    // Stable LSD radix sort of (key, value) pairs by key; scratch is resized as needed
+    struct SortItem {
+        uint64_t key;
+        uint64_t value;
+    };
+    static void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+
+private:
+    std::vector<RenderCommandList> lists;
+    std::vector<SortItem> sortItems;
+    std::vector<SortItem> sortScratch;
+    RenderFrame frame;
+};
@@ -4,20 +4,14 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <vector>
-#include <fstream>
-#include <sstream>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
 #ifndef SE_ASSETS_DIR
 #define SE_ASSETS_DIR "assets"
 #endif
 
-static std::string LoadText(const std::string& path){
-    std::ifstream ifs(path);
-    std::stringstream ss; ss << ifs.rdbuf();
-    return ss.str();
-}
-
 bool Renderer::init(GLFWwindow* window){
     (void)window;
     if(!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)){
@@ -26,8 +20,11 @@ bool Renderer::init(GLFWwindow* window){
     glEnable(GL_DEPTH_TEST);
 
     // Shaders
-    if(!loadShaders(std::string(SE_ASSETS_DIR) + "/shaders/basic.vert",
-                    std::string(SE_ASSETS_DIR) + "/shaders/basic.frag")) return false;
+    if(!m_shaders.Init()) return false;
+    const std::string shaderDir = std::string(SE_ASSETS_DIR) + "/shaders/";
+    m_basicShader = m_shaders.Load(shaderDir + "basic.vert", shaderDir + "basic.frag");
+    m_instancedShader = m_shaders.Load(shaderDir + "instanced.vert", shaderDir + "instanced.frag");
+    if(m_basicShader == ShaderLibrary::InvalidHandle || m_instancedShader == ShaderLibrary::InvalidHandle) return false;
 
     // Unit cube (pos, normal)
     float v[] = {
@@ -41,7 +38,7 @@ bool Renderer::init(GLFWwindow* window){
        0.5f, 0.5f, 0.5f,   0, 1,0,
       -0.5f, 0.5f, 0.5f,   0, 1,0,
     };
-    unsigned idx[] = {
+    uint32_t idx[] = {
       0,1,2, 2,3,0, // bottom
       4,5,6, 6,7,4, // top
       0,1,5, 5,4,0, // front
@@ -67,11 +64,45 @@ bool Renderer::init(GLFWwindow* window){
 
     glBindVertexArray(0);
 
+    return initInstancing(v, idx);
+}
+
+bool Renderer::initInstancing(const float* v, const uint32_t* idx){
+    // Persistent mapping needs buffer storage (GL 4.4 or the ARB extension); on a plain
+    // 3.3 context the instance buffer is orphaned and mapped each flush instead
+    m_persistent = false;
+#ifdef GL_VERSION_4_4
+    m_persistent = m_persistent || GLAD_GL_VERSION_4_4;
+#endif
+#ifdef GL_ARB_buffer_storage
+    m_persistent = m_persistent || GLAD_GL_ARB_buffer_storage;
+#endif
+
+    // Instanced meshes live in the shared residency buffers; every arena VAO gets the
+    // instance attributes, pointed at the right part of m_instanceBuffer when drawing
+    m_meshes.Init([]{
+        for(unsigned i = 2; i <= 6; ++i){
+            glEnableVertexAttribArray(i);
+            glVertexAttribDivisor(i, 1);
+        }
+    });
+    std::vector<Vertex> cubeVertices(8);
+    for(size_t i = 0; i < cubeVertices.size(); ++i){
+        cubeVertices[i].position = glm::vec3(v[i*6+0], v[i*6+1], v[i*6+2]);
+        cubeVertices[i].normal = glm::vec3(v[i*6+3], v[i*6+4], v[i*6+5]);
+    }
+    if(m_meshes.Upload(cubeVertices.data(), (uint32_t)cubeVertices.size(), idx, 36) != MeshCube){
+        std::cerr << "Cube mesh upload failed" << std::endl; return false;
+    }
+
+    reserveInstances(1024);
     return true;
 }
 
 void Renderer::shutdown(){
-    if(m_program) glDeleteProgram(m_program);
+    releaseInstanceBuffer();
+    m_meshes.Shutdown();
+    m_shaders.Shutdown();
     if(m_vbo) glDeleteBuffers(1,&m_vbo);
     if(m_ebo) glDeleteBuffers(1,&m_ebo);
     if(m_vao) glDeleteVertexArrays(1,&m_vao);
@@ -81,66 +112,234 @@ void Renderer::beginFrame(int w, int h){
     glViewport(0,0,w,h);
     glClearColor(0.08f,0.09f,0.11f,1);
     glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
+    m_stats = FrameStats{};
+    // Edited shader files are recompiled and swapped in here
+    m_shaders.Update();
 }
 
 void Renderer::drawCube(const glm::mat4& mvp){
-    glUseProgram(m_program);
-    glUniformMatrix4fv(m_uMVP, 1, GL_FALSE, &mvp[0][0]);
+    glUseProgram(m_shaders.GetProgram(m_basicShader));
+    glUniformMatrix4fv(m_shaders.GetUniform(m_basicShader, ShaderLibrary::Uniform::MVP), 1, GL_FALSE, &mvp[0][0]);
     glBindVertexArray(m_vao);
     glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
+    ++m_stats.drawCalls;
+    ++m_stats.instances;
 }
 
 void Renderer::drawCube(const glm::mat4& mvp, const glm::vec3& tint) {
-    glUseProgram(m_program);
-    glUniformMatrix4fv(m_uMVP, 1, GL_FALSE, &mvp[0][0]);
-    int loc = glGetUniformLocation(m_program, "uTint");
-    if (loc >= 0) glUniform3f(loc, tint.x, tint.y, tint.z);
+    glUseProgram(m_shaders.GetProgram(m_basicShader));
+    glUniformMatrix4fv(m_shaders.GetUniform(m_basicShader, ShaderLibrary::Uniform::MVP), 1, GL_FALSE, &mvp[0][0]);
+    const int tintLoc = m_shaders.GetUniform(m_basicShader, ShaderLibrary::Uniform::Tint);
+    if (tintLoc >= 0) glUniform3f(tintLoc, tint.x, tint.y, tint.z);
     glBindVertexArray(m_vao);
     glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
     // reset tint to white to avoid leaking to other draws
-    if (loc >= 0) glUniform3f(loc, 1.0f, 1.0f, 1.0f);
+    if (tintLoc >= 0) glUniform3f(tintLoc, 1.0f, 1.0f, 1.0f);
+    ++m_stats.drawCalls;
+    ++m_stats.instances;
 }
 
-void Renderer::endFrame(){
-    // nothing for now
-}
-
-unsigned Renderer::compileShader(unsigned type, const std::string& src){
-    unsigned s = glCreateShader(type);
-    const char* c = src.c_str();
-    glShaderSource(s,1,&c,nullptr);
-    glCompileShader(s);
-    int ok; glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
-    glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
-    if(!ok){ char log[1024]; glGetShaderInfoLog(s,1024,nullptr,log); std::cerr<<"Shader error: "<<log<<"\n"; }
-    return s;
-}
-
-unsigned Renderer::linkProgram(unsigned vs, unsigned fs){
-    unsigned p = glCreateProgram();
-    glAttachShader(p, vs); glAttachShader(p, fs);
-    glLinkProgram(p);
-    int ok; glGetProgramiv(p, GL_LINK_STATUS, &ok);
-    if(!ok){ char log[1024]; glGetProgramInfoLog(p,1024,nullptr,log); std::cerr<<"Link error: "<<log<<"\n"; }
-    glDeleteShader(vs); glDeleteShader(fs);
-    return p;
-}
-
-bool Renderer::loadShaders(const std::string& vp, const std::string& fp){
-    auto vsrc = LoadText(vp);
-    auto fsrc = LoadText(fp);
-    unsigned vs = compileShader(GL_VERTEX_SHADER, vsrc);
-    unsigned fs = compileShader(GL_FRAGMENT_SHADER, fsrc);
-    m_program = linkProgram(vs, fs);
-    m_uMVP = glGetUniformLocation(m_program, "uMVP");
-    // Ensure tint uniform exists and initialize to white
-    int tintLoc = glGetUniformLocation(m_program, "uTint");
-    if (tintLoc >= 0) {
-        glUseProgram(m_program);
-        glUniform3f(tintLoc, 1.0f, 1.0f, 1.0f);
-        glUseProgram(0);
+void Renderer::setViewProjection(const glm::mat4& viewProj){
+    m_viewProj = viewProj;
+}
+
+void Renderer::submitCube(const glm::mat4& model, const glm::vec3& tint){
+    m_batcher.Add(MeshCube, MaterialBasic, model, glm::vec4(tint, 1.0f));
+}
+
+void Renderer::flushInstances(){
+    const size_t count = m_batcher.GetInstanceCount();
+    if(count == 0) return;
+
+    size_t baseOffset = 0;
+    InstanceData* dst = beginInstanceUpload(count, baseOffset);
+    if(!dst){ m_batcher.Clear(); return; }
+    const auto& batches = m_batcher.Pack(dst);
+    endInstanceUpload();
+
+    drawInstanceBatches(m_viewProj, baseOffset, batches);
+    m_batcher.Clear();
+}
+
+void Renderer::drawInstances(const glm::mat4& viewProj, const InstanceData* instances, size_t count,
+                             const std::vector<InstanceBatcher::Batch>& batches){
+    if(count == 0) return;
+
+    size_t baseOffset = 0;
+    InstanceData* dst = beginInstanceUpload(count, baseOffset);
+    if(!dst) return;
+    std::memcpy(dst, instances, count * sizeof(InstanceData));
+    endInstanceUpload();
+
+    drawInstanceBatches(viewProj, baseOffset, batches);
+}
+
+InstanceData* Renderer::beginInstanceUpload(size_t count, size_t& baseOffset){
+    reserveInstances(count);
+
+    if(m_persistent){
+        m_instanceSegment = (m_instanceSegment + 1) % InstanceSegments;
+        if(GLsync fence = (GLsync)m_instanceFences[m_instanceSegment]){
+            // Normally long signalled: the segment was last used InstanceSegments flushes ago
+            while(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED){}
+            glDeleteSync(fence);
+            m_instanceFences[m_instanceSegment] = nullptr;
+        }
+        baseOffset = m_instanceSegment * m_instanceCapacity * sizeof(InstanceData);
+        return m_instanceMapped + m_instanceSegment * m_instanceCapacity;
+    }
+
+    // Orphan the old storage so the driver never stalls on a draw still reading it
+    baseOffset = 0;
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, m_instanceCapacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+    return static_cast<InstanceData*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+}
+
+void Renderer::endInstanceUpload(){
+    if(!m_persistent) glUnmapBuffer(GL_ARRAY_BUFFER);
+}
+
+void Renderer::drawInstanceBatches(const glm::mat4& viewProj, size_t baseOffset,
+                                   const std::vector<InstanceBatcher::Batch>& batches){
+    // View-projection lives in the per-frame UBO; only uploaded when it changed
+    ShaderLibrary::FrameData frame = m_shaders.GetFrameData();
+    frame.viewProj = viewProj;
+    m_shaders.SetFrameData(frame);
+
+    glUseProgram(m_shaders.GetProgram(m_instancedShader));
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+    if(m_meshes.SupportsMultiDrawIndirect()){
+        // Consecutive batches in one arena become one glMultiDrawElementsIndirect; base
+        // instance selects each batch's instances, so the attributes stay at the segment
+        const uint32_t segmentInstance = (uint32_t)(baseOffset / sizeof(InstanceData));
+        uint32_t arena = ~0u;
+        auto flush = [&]{
+            if(m_indirectCommands.empty()) return;
+            m_meshes.MultiDraw(m_indirectCommands);
+            m_indirectCommands.clear();
+            ++m_stats.drawCalls;
+        };
+        for(const auto& batch : batches){
+            const MeshResidency::MeshRecord* mesh = m_meshes.GetRecord(batch.mesh);
+            if(!mesh) continue;
+            if(mesh->arena != arena){
+                flush();
+                arena = mesh->arena;
+                glBindVertexArray(m_meshes.GetArenaVao(arena));
+                bindInstanceAttributes(0);
+            }
+            m_indirectCommands.push_back({mesh->indexCount, batch.instanceCount, mesh->firstIndex,
+                                          (int32_t)mesh->baseVertex, segmentInstance + batch.firstInstance});
+            m_stats.instances += batch.instanceCount;
+        }
+        flush();
+    } else {
+        uint32_t arena = ~0u;
+        for(const auto& batch : batches){
+            const MeshResidency::MeshRecord* mesh = m_meshes.GetRecord(batch.mesh);
+            if(!mesh) continue;
+            if(mesh->arena != arena){
+                arena = mesh->arena;
+                glBindVertexArray(m_meshes.GetArenaVao(arena));
+            }
+            // No base instance before GL 4.2, so the attributes move to the batch instead
+            bindInstanceAttributes(baseOffset + batch.firstInstance * sizeof(InstanceData));
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei)mesh->indexCount, GL_UNSIGNED_INT,
+                                              (void*)(mesh->firstIndex * sizeof(uint32_t)),
+                                              (GLsizei)batch.instanceCount, (GLint)mesh->baseVertex);
+            ++m_stats.drawCalls;
+            m_stats.instances += batch.instanceCount;
+        }
+    }
+    glBindVertexArray(0);
+
+    if(m_persistent){
+        m_instanceFences[m_instanceSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     }
-    return m_program != 0;
+}
+
+void Renderer::bindInstanceAttributes(size_t byteOffset){
+    const GLsizei stride = sizeof(InstanceData);
+    for(unsigned column = 0; column < 4; ++column){
+        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(byteOffset + column * sizeof(glm::vec4)));
+    }
+    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(byteOffset + offsetof(InstanceData, tint)));
+}
+
+void Renderer::reserveInstances(size_t count){
+    if(count <= m_instanceCapacity && m_instanceBuffer) return;
+    size_t capacity = m_instanceCapacity ? m_instanceCapacity : 1024;
+    while(capacity < count) capacity *= 2;
+
+    releaseInstanceBuffer();
+    m_instanceCapacity = capacity;
+    glGenBuffers(1, &m_instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+    if(m_persistent){
+        const GLsizeiptr bytes = (GLsizeiptr)(InstanceSegments * capacity * sizeof(InstanceData));
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+        m_instanceMapped = static_cast<InstanceData*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags));
+        if(m_instanceMapped) return;
+        std::cerr << "Persistent instance buffer mapping failed, falling back to orphaning" << std::endl;
+        m_persistent = false;
+        glDeleteBuffers(1, &m_instanceBuffer);
+        glGenBuffers(1, &m_instanceBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    }
+#endif
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+}
+
+void Renderer::releaseInstanceBuffer(){
+    for(void*& fence : m_instanceFences){
+        if(fence){
+            // Growing while the GPU still reads the old storage: wait before unmapping it
+            glClientWaitSync((GLsync)fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            glDeleteSync((GLsync)fence);
+            fence = nullptr;
+        }
+    }
+    if(m_instanceBuffer){
+        if(m_instanceMapped){
+            glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            m_instanceMapped = nullptr;
+        }
+        glDeleteBuffers(1, &m_instanceBuffer);
+        m_instanceBuffer = 0;
+    }
+}
+
+void Renderer::submitMesh(uint32_t mesh, const glm::mat4& model, const glm::vec3& tint){
+    m_batcher.Add(mesh, MaterialBasic, model, glm::vec4(tint, 1.0f));
+}
+
+uint32_t Renderer::uploadMesh(const Mesh& mesh){
+    return m_meshes.Upload(mesh);
+}
+
+std::vector<uint32_t> Renderer::uploadModel(const Model& model){
+    std::vector<uint32_t> handles;
+    handles.reserve(model.meshes.size());
+    for(const Mesh& mesh : model.meshes) handles.push_back(m_meshes.Upload(mesh));
+    return handles;
+}
+
+void Renderer::releaseMesh(uint32_t mesh){
+    if(mesh != MeshCube) m_meshes.Release(mesh);
+}
+
+void Renderer::endFrame(){
+    // Anything submitted after the last explicit flush
+    flushInstances();
+    m_meshes.EndFrame();
 }
@@ -1,11 +1,30 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include "InstanceBatcher.h"
+#include "MeshResidency.h"
+#include "Model.h"
+#include "RenderQueue.h"
+#include "ShaderLibrary.h"
 
 struct GLFWwindow;
 
 class Renderer {
 public:
+    // Mesh and material ids for submitted instances; meshes are MeshResidency handles
+    // and the cube is always the first one uploaded
+    static constexpr uint32_t MeshCube = 0;
+    static constexpr uint32_t MaterialBasic = 0;
+
+    struct FrameStats {
+        uint32_t drawCalls = 0;
+        uint32_t instances = 0;
+        uint32_t visible = 0;   // reported by the culling stage
+        uint32_t culled = 0;
+    };
+
     bool init(GLFWwindow* window);
     void shutdown();
 
@@ -13,14 +32,76 @@ public:
     void drawCube(const glm::mat4& mvp);
     // tint multiplies the base color (use to highlight selected objects)
     void drawCube(const glm::mat4& mvp, const glm::vec3& tint);
+
+    // Instanced path: submit during the frame, flushInstances() draws everything with one
+    // instanced call per mesh/material, or one multi-draw-indirect per mesh arena where
+    // supported. viewProj is uploaded once per flush.
+    void setViewProjection(const glm::mat4& viewProj);
+    void submitCube(const glm::mat4& model, const glm::vec3& tint = glm::vec3(1.0f));
+    void submitMesh(uint32_t mesh, const glm::mat4& model, const glm::vec3& tint = glm::vec3(1.0f));
+    void flushInstances();
+    // Uploads prepared instances and draws each batch with one instanced call
+    void drawInstances(const glm::mat4& viewProj, const InstanceData* instances, size_t count,
+                       const std::vector<InstanceBatcher::Batch>& batches);
+
+    // Copies geometry into the shared mesh buffers; the ids go to submitMesh/RenderCommandList
+    uint32_t uploadMesh(const Mesh& mesh);
+    std::vector<uint32_t> uploadModel(const Model& model);
+    void releaseMesh(uint32_t mesh);
+
+    // Counters since beginFrame
+    const FrameStats& getFrameStats() const { return m_stats; }
+    void addCullStats(uint32_t visible, uint32_t culled) { m_stats.visible += visible; m_stats.culled += culled; }
+    bool usesPersistentMapping() const { return m_persistent; }
+    ShaderLibrary& getShaderLibrary() { return m_shaders; }
+    const MeshResidency& getMeshResidency() const { return m_meshes; }
+
     void endFrame();
 
 private:
-    unsigned int m_program = 0;
+    // Segments of the persistently mapped instance buffer, fenced so the CPU never
+    // writes what the GPU may still read
+    static constexpr int InstanceSegments = 3;
+
+    ShaderLibrary m_shaders;
+    ShaderLibrary::Handle m_basicShader = ShaderLibrary::InvalidHandle;
+    ShaderLibrary::Handle m_instancedShader = ShaderLibrary::InvalidHandle;
+
     unsigned int m_vao = 0, m_vbo = 0, m_ebo = 0;
-    int m_uMVP = -1;
 
-    unsigned int compileShader(unsigned int type, const std::string& src);
-    unsigned int linkProgram(unsigned int vs, unsigned int fs);
-    bool loadShaders(const std::string& vertPath, const std::string& fragPath);
+    MeshResidency m_meshes;
+    std::vector<MeshResidency::IndirectCommand> m_indirectCommands;
+
+    unsigned int m_instanceBuffer = 0;
+    bool m_persistent = false;
+    size_t m_instanceCapacity = 0;      // instances per segment
+    InstanceData* m_instanceMapped = nullptr;
+    int m_instanceSegment = 0;
+    void* m_instanceFences[InstanceSegments] = {};   // GLsync
+    glm::mat4 m_viewProj{1.0f};
+    InstanceBatcher m_batcher;
+
+    FrameStats m_stats;
+
+    bool initInstancing(const float* cubeVertices, const uint32_t* cubeIndices);
+    void reserveInstances(size_t count);
+    void releaseInstanceBuffer();
+    void bindInstanceAttributes(size_t byteOffset);
+    InstanceData* beginInstanceUpload(size_t count, size_t& baseOffset);
+    void endInstanceUpload();
+    void drawInstanceBatches(const glm::mat4& viewProj, size_t baseOffset,
+                             const std::vector<InstanceBatcher::Batch>& batches);
+};
+
+// Replays RenderQueue frames through the renderer's instanced path
+class GLRenderBackend : public RenderBackend {
+public:
+    explicit GLRenderBackend(Renderer& renderer) : m_renderer(renderer) {}
+
+    void Execute(const glm::mat4& viewProj, const RenderFrame& frame) override {
+        m_renderer.drawInstances(viewProj, frame.instances.data(), frame.instances.size(), frame.batches);
+    }
+
+private:
+    Renderer& m_renderer;
 };
@@ -0,0 +1,150 @@
+#include "ScriptBytecodeCache.h"
+#include <lua.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint64_t FnvOffsetBasis = 0xCBF29CE484222325ull;
+    constexpr uint64_t FnvPrime = 0x100000001B3ull;
+
+    uint64_t Fnv1a(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= FnvPrime;
+        }
+        return hash;
+    }
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t formatVersion;
+        uint64_t key;
+        uint64_t size;
+    };
+
+    constexpr char FileMagic[4] = {'S', 'P', 'L', 'C'};
+    constexpr uint32_t FileFormatVersion = 1;
+
+    int WriteChunk(lua_State*, const void* data, size_t size, void* ud) {
+        static_cast<std::string*>(ud)->append(static_cast<const char*>(data), size);
+        return 0;
+    }
+
+    double SecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+ScriptBytecodeCache::ScriptBytecodeCache(std::string directory)
+    : directory(std::move(directory)) {
+}
+
+uint64_t ScriptBytecodeCache::HashSource(const std::string& source, const std::string& chunkName) {
+    // Bytecode is only valid for the Lua version and number/pointer sizes that made it
+    const uint32_t abi[] = {static_cast<uint32_t>(LUA_VERSION_NUM), static_cast<uint32_t>(sizeof(void*)),
+                            static_cast<uint32_t>(sizeof(lua_Number)), static_cast<uint32_t>(sizeof(lua_Integer))};
+    uint64_t hash = Fnv1a(FnvOffsetBasis, abi, sizeof(abi));
+    // The chunk name ends up in the bytecode (error messages, debug info)
+    hash = Fnv1a(hash, chunkName.data(), chunkName.size());
+    hash = Fnv1a(hash, "\0", 1);
+    return Fnv1a(hash, source.data(), source.size());
+}
+
+const std::string* ScriptBytecodeCache::GetBytecode(lua_State* L, const std::string& source, const std::string& chunkName, std::string& error) {
+    const uint64_t key = HashSource(source, chunkName);
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        ++stats.memoryHits;
+        return &it->second;
+    }
+
+    std::string bytecode;
+    if (!directory.empty()) {
+        const Clock::time_point start = Clock::now();
+        const bool found = ReadFromDisk(key, bytecode);
+        stats.diskSeconds += SecondsSince(start);
+        if (found) {
+            ++stats.diskHits;
+            return &entries.emplace(key, std::move(bytecode)).first->second;
+        }
+    }
+
+    const Clock::time_point start = Clock::now();
+    if (luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "t") != LUA_OK) {
+        error = lua_tostring(L, -1);
+        lua_pop(L, 1);
+        return nullptr;
+    }
+    // Keep debug info, script errors should still name lines
+    lua_dump(L, WriteChunk, &bytecode, 0);
+    lua_pop(L, 1);
+    stats.compileSeconds += SecondsSince(start);
+    ++stats.compiles;
+
+    if (!directory.empty()) {
+        WriteToDisk(key, bytecode);
+    }
+    return &entries.emplace(key, std::move(bytecode)).first->second;
+}
+
+std::string ScriptBytecodeCache::GetFilePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.luac", static_cast<unsigned long long>(key));
+    return directory + "/" + name;
+}
+
+bool ScriptBytecodeCache::ReadFromDisk(uint64_t key, std::string& bytecode) const {
+    std::ifstream in(GetFilePath(key), std::ios::binary);
+    if (!in) return false;
+
+    FileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0 ||
+        header.formatVersion != FileFormatVersion || header.key != key) {
+        return false;
+    }
+
+    bytecode.resize(static_cast<size_t>(header.size));
+    if (!in.read(bytecode.data(), static_cast<std::streamsize>(bytecode.size()))) return false;
+    // Exactly the recorded size, no trailing bytes from a torn write
+    return in.peek() == std::ifstream::traits_type::eof();
+}
+
+void ScriptBytecodeCache::WriteToDisk(uint64_t key, const std::string& bytecode) const {
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec) return;
+
+    // Write aside and rename, so a reader never sees half a file
+    const std::string path = GetFilePath(key);
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+
+        FileHeader header{};
+        std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+        header.formatVersion = FileFormatVersion;
+        header.key = key;
+        header.size = bytecode.size();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+        if (!out) {
+            out.close();
+            fs::remove(temporary, ec);
+            return;
+        }
+    }
+    fs::rename(temporary, path, ec);
+    if (ec) fs::remove(temporary, ec);
+}
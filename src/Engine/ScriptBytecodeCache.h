@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+struct lua_State;
+
+/**
+ * ScriptBytecodeCache - compiled Lua chunks keyed by a hash of their source
+ * GetBytecode() returns the lua_dump output for a script, compiling it only when neither
+ * the in-memory table nor the on-disk cache directory has that exact source (FNV-1a
+ * over source, chunk name and the Lua version/ABI, so a cache written by another Lua
+ * build is never picked up). Callers load the returned bytes in binary mode.
+ *
+ * Files on disk are checked against their key and size before use, but are trusted
+ * otherwise: point the directory somewhere only the engine writes. Not thread-safe.
+ */
+class ScriptBytecodeCache {
+public:
+    struct Stats {
+        uint64_t memoryHits = 0;
+        uint64_t diskHits = 0;
+        uint64_t compiles = 0;
+        double compileSeconds = 0.0;
+        double diskSeconds = 0.0;
+    };
+
+    // An empty directory keeps the cache in memory only
+    explicit ScriptBytecodeCache(std::string directory = "cache/scripts");
+
+    // Bytecode for source, owned by the cache and stable until Clear(); nullptr with
+    // error set if the source does not compile
+    const std::string* GetBytecode(lua_State* L, const std::string& source, const std::string& chunkName, std::string& error);
+
+    static uint64_t HashSource(const std::string& source, const std::string& chunkName);
+
+    const std::string& GetDirectory() const { return directory; }
+    size_t GetEntryCount() const { return entries.size(); }
+    const Stats& GetStats() const { return stats; }
+    // Drops the in-memory entries (files stay)
+    void Clear() { entries.clear(); }
+
+private:
+    std::string GetFilePath(uint64_t key) const;
+    bool ReadFromDisk(uint64_t key, std::string& bytecode) const;
+    void WriteToDisk(uint64_t key, const std::string& bytecode) const;
+
+    std::string directory;
+    std::unordered_map<uint64_t, std::string> entries;
+    Stats stats;
+};
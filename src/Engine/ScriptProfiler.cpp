@@ -0,0 +1,209 @@
+#include "ScriptProfiler.h"
+#include <lua.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+    void WriteJsonString(std::ofstream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            switch (c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                default:
+                    if (static_cast<unsigned char>(c) >= 0x20) out << c;
+                    break;
+            }
+        }
+        out << '"';
+    }
+}
+
+double ScriptProfiler::ScriptStats::GetTotalSeconds() const {
+    double total = 0.0;
+    for (const CallStats& stats : callbacks) {
+        total += stats.totalSeconds;
+    }
+    return total;
+}
+
+ScriptProfiler::Scope::Scope(ScriptProfiler& profiler, uint32_t script, Callback callback, uint32_t entity)
+    : profiler(profiler.enabled ? &profiler : nullptr), script(script), previousScript(NoScript),
+      entity(entity), callback(callback) {
+    if (!this->profiler) return;
+
+    previousScript = profiler.currentScript;
+    profiler.currentScript = script;
+    start = Clock::now();
+    if (profiler.sampling) {
+        profiler.lastSample = start;
+    }
+}
+
+ScriptProfiler::Scope::~Scope() {
+    if (!profiler) return;
+
+    profiler->EndScope(*this, Clock::now());
+    profiler->currentScript = previousScript;
+}
+
+void ScriptProfiler::EndScope(const Scope& scope, Clock::time_point end) {
+    if (scope.script >= scripts.size()) return;
+
+    const double seconds = std::chrono::duration<double>(end - scope.start).count();
+    CallStats& stats = scripts[scope.script].callbacks[static_cast<size_t>(scope.callback)];
+    ++stats.calls;
+    stats.totalSeconds += seconds;
+    stats.maxSeconds = std::max(stats.maxSeconds, seconds);
+
+    if (tracing && traceEvents.size() < MaxTraceEvents) {
+        traceEvents.push_back(TraceEvent{
+            scope.script, scope.entity, scope.callback,
+            std::chrono::duration_cast<std::chrono::microseconds>(scope.start - traceStart).count(),
+            std::chrono::duration_cast<std::chrono::microseconds>(end - scope.start).count()});
+    }
+}
+
+void* ScriptProfiler::LuaAlloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    ScriptProfiler* profiler = static_cast<ScriptProfiler*>(ud);
+
+    // With ptr == null, osize is a type tag rather than a size
+    const size_t oldSize = ptr ? osize : 0;
+    if (nsize == 0) {
+        std::free(ptr);
+        profiler->liveBytes -= oldSize;
+        return nullptr;
+    }
+
+    void* block = std::realloc(ptr, nsize);
+    if (!block) return nullptr;
+
+    profiler->liveBytes += nsize;
+    profiler->liveBytes -= oldSize;
+    if (profiler->enabled && nsize > oldSize && profiler->currentScript < profiler->scripts.size()) {
+        ScriptStats& stats = profiler->scripts[profiler->currentScript];
+        stats.allocatedBytes += nsize - oldSize;
+        ++stats.allocationCount;
+    }
+    return block;
+}
+
+void ScriptProfiler::SetEnabled(bool enable) {
+    enabled = enable;
+    if (!enabled) {
+        SetSampling(false);
+        StopTrace();
+        currentScript = NoScript;
+    }
+}
+
+const char* ScriptProfiler::GetCallbackName(Callback callback) {
+    switch (callback) {
+        case Callback::Load: return "Load";
+        case Callback::OnStart: return "OnStart";
+        case Callback::OnTick: return "OnTick";
+        case Callback::OnTickBatch: return "OnTickBatch";
+        case Callback::Latent: return "Latent";
+        default: return "?";
+    }
+}
+
+void ScriptProfiler::SetSampling(bool enable, int instructionInterval) {
+    sampling = enable && L != nullptr;
+    sampleInterval = std::max(1, instructionInterval);
+    if (sampling) {
+        lastSample = Clock::now();
+    }
+}
+
+void ScriptProfiler::Sample(lua_State* state, lua_Debug* ar) {
+    if (!enabled || currentScript == NoScript) return;
+
+    const Clock::time_point now = Clock::now();
+    const double seconds = std::chrono::duration<double>(now - lastSample).count();
+    lastSample = now;
+
+    if (!lua_getinfo(state, "S", ar)) return;
+
+    FunctionStats& stats = functions[FunctionKey{ar->source, ar->linedefined}];
+    if (stats.samples == 0) {
+        stats.name = std::string(ar->short_src) + ":" + std::to_string(ar->linedefined);
+    }
+    ++stats.samples;
+    stats.seconds += seconds;
+}
+
+uint32_t ScriptProfiler::RegisterScript(const std::string& path) {
+    auto it = scriptIds.find(path);
+    if (it != scriptIds.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(scripts.size());
+    scripts.emplace_back();
+    scripts.back().path = path;
+    scriptIds.emplace(path, id);
+    return id;
+}
+
+std::vector<ScriptProfiler::FunctionStats> ScriptProfiler::GetFunctionStats() const {
+    std::vector<FunctionStats> result;
+    result.reserve(functions.size());
+    for (const auto& [key, stats] : functions) {
+        result.push_back(stats);
+    }
+    std::sort(result.begin(), result.end(), [](const FunctionStats& a, const FunctionStats& b) {
+        return a.seconds > b.seconds;
+    });
+    return result;
+}
+
+void ScriptProfiler::StartTrace() {
+    traceEvents.clear();
+    traceStart = Clock::now();
+    tracing = true;
+}
+
+void ScriptProfiler::StopTrace() {
+    tracing = false;
+}
+
+bool ScriptProfiler::WriteChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+
+    // Complete ("X") events, one row per script
+    out << "{\"traceEvents\":[";
+    const char* separator = "\n";
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":";
+        WriteJsonString(out, scripts[i].path);
+        out << "}}";
+        separator = ",\n";
+    }
+    for (const TraceEvent& event : traceEvents) {
+        out << separator << "{\"name\":\"" << GetCallbackName(event.callback) << "\",\"cat\":\"script\",\"ph\":\"X\""
+            << ",\"ts\":" << event.startMicros << ",\"dur\":" << event.durationMicros
+            << ",\"pid\":1,\"tid\":" << event.script;
+        if (event.entity != NoEntity) {
+            out << ",\"args\":{\"entity\":" << event.entity << "}";
+        }
+        out << "}";
+        separator = ",\n";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(out);
+}
+
+void ScriptProfiler::Reset() {
+    for (ScriptStats& stats : scripts) {
+        for (CallStats& call : stats.callbacks) {
+            call = CallStats();
+        }
+        stats.allocatedBytes = 0;
+        stats.allocationCount = 0;
+    }
+    functions.clear();
+    traceEvents.clear();
+    frameCount = 0;
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct lua_State;
+struct lua_Debug;
+
+/**
+ * ScriptProfiler - per-script timing, Lua allocation accounting and function sampling
+ * Scripting wraps every call into a script in a Scope, which times it and makes that
+ * script the owner of any Lua allocation made meanwhile (LuaAlloc is the state's
+ * allocator). Optionally the running Lua function is sampled every N VM instructions
+ * and charged the time since the previous sample; the count hook itself belongs to
+ * ScriptWatchdog (a state has one hook), which forwards to Sample(). While a trace capture
+ * is running, each call is also recorded for WriteChromeTrace (chrome://tracing format).
+ *
+ * Everything but the live-memory total is skipped while the profiler is disabled.
+ * Single-threaded, like the Lua state it instruments.
+ */
+class ScriptProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Callback : uint8_t {
+        Load,
+        OnStart,
+        OnTick,
+        OnTickBatch,
+        Latent,
+        Count
+    };
+
+    static constexpr uint32_t NoScript = 0xFFFFFFFFu;
+    static constexpr uint32_t NoEntity = 0xFFFFFFFFu;
+    static constexpr size_t CallbackCount = static_cast<size_t>(Callback::Count);
+    static constexpr size_t MaxTraceEvents = 1 << 20;
+
+    struct CallStats {
+        uint64_t calls = 0;
+        double totalSeconds = 0.0;
+        double maxSeconds = 0.0;
+    };
+
+    struct ScriptStats {
+        std::string path;
+        CallStats callbacks[CallbackCount];
+        uint64_t allocatedBytes = 0;   // cumulative, while this script was running
+        uint64_t allocationCount = 0;
+
+        double GetTotalSeconds() const;
+    };
+
+    struct FunctionStats {
+        std::string name;   // "source:line"
+        uint64_t samples = 0;
+        double seconds = 0.0;
+    };
+
+    // Times one call into a script; no-op while the profiler is disabled
+    class Scope {
+    public:
+        Scope(ScriptProfiler& profiler, uint32_t script, Callback callback, uint32_t entity = NoEntity);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ScriptProfiler* profiler;
+        uint32_t script;
+        uint32_t previousScript;
+        uint32_t entity;
+        Callback callback;
+        Clock::time_point start;
+
+        friend class ScriptProfiler;
+    };
+
+    // lua_Alloc for the instrumented state; ud must be the profiler
+    static void* LuaAlloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
+    // Called once the state exists (sampling is only possible with a state)
+    void Attach(lua_State* state) { L = state; }
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return enabled; }
+
+    // Samples every instructionInterval VM instructions (rounded up to the hook's interval)
+    void SetSampling(bool sampling, int instructionInterval = 1000);
+    bool IsSampling() const { return sampling; }
+    int GetSampleInterval() const { return sampleInterval; }
+    // Called from the count hook while sampling
+    void Sample(lua_State* state, lua_Debug* ar);
+
+    static const char* GetCallbackName(Callback callback);
+
+    // Returns the id used by Scope (the same path always gets the same id)
+    uint32_t RegisterScript(const std::string& path);
+
+    void BeginFrame() { ++frameCount; }
+    uint64_t GetFrameCount() const { return frameCount; }
+
+    const std::vector<ScriptStats>& GetScriptStats() const { return scripts; }
+    // Sorted by time, most expensive first
+    std::vector<FunctionStats> GetFunctionStats() const;
+    size_t GetLiveBytes() const { return liveBytes; }
+
+    void StartTrace();
+    void StopTrace();
+    bool IsTracing() const { return tracing; }
+    size_t GetTraceEventCount() const { return traceEvents.size(); }
+    bool WriteChromeTrace(const std::string& path) const;
+
+    // Clears all counters and samples (scripts stay registered)
+    void Reset();
+
+private:
+    struct TraceEvent {
+        uint32_t script;
+        uint32_t entity;
+        Callback callback;
+        int64_t startMicros;
+        int64_t durationMicros;
+    };
+
+    struct FunctionKey {
+        const char* source;   // interned by Lua, stable while the function's chunk lives
+        int line;
+        bool operator==(const FunctionKey& other) const { return source == other.source && line == other.line; }
+    };
+
+    struct FunctionKeyHash {
+        size_t operator()(const FunctionKey& key) const {
+            return std::hash<const void*>()(key.source) ^ (std::hash<int>()(key.line) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    void EndScope(const Scope& scope, Clock::time_point end);
+
+    lua_State* L = nullptr;
+    bool enabled = false;
+    bool sampling = false;
+    int sampleInterval = 1000;
+
+    std::vector<ScriptStats> scripts;
+    std::unordered_map<std::string, uint32_t> scriptIds;
+    uint32_t currentScript = NoScript;
+    uint64_t frameCount = 0;
+    size_t liveBytes = 0;
+
+    std::unordered_map<FunctionKey, FunctionStats, FunctionKeyHash> functions;
+    Clock::time_point lastSample;
+
+    bool tracing = false;
+    Clock::time_point traceStart;
+    std::vector<TraceEvent> traceEvents;
+};
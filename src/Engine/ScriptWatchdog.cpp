@@ -0,0 +1,150 @@
+#include "ScriptWatchdog.h"
+#include <lua.hpp>
+#include <algorithm>
+#include <cstdio>
+
+ScriptWatchdog::Budget ScriptWatchdog::Budget::ForBatch(size_t entityCount) const {
+    const double count = static_cast<double>(std::max<size_t>(entityCount, 1));
+    Budget batch = *this;
+    if (maxMilliseconds > 0.0) {
+        batch.maxMilliseconds = maxMilliseconds * count;
+        if (maxBatchMilliseconds > 0.0) batch.maxMilliseconds = std::min(batch.maxMilliseconds, maxBatchMilliseconds);
+    }
+    if (maxInstructions != 0) {
+        batch.maxInstructions = maxInstructions * std::max<size_t>(entityCount, 1);
+    }
+    return batch;
+}
+
+ScriptWatchdog::Guard::Guard(ScriptWatchdog& watchdog, uint32_t script, ScriptProfiler::Callback callback)
+    : Guard(watchdog, script, callback, watchdog.GetBudget(script)) {
+}
+
+ScriptWatchdog::Guard::Guard(ScriptWatchdog& watchdog, uint32_t script, ScriptProfiler::Callback callback,
+                             const Budget& budget)
+    : watchdog(watchdog) {
+    if (watchdog.depth++ > 0) return;
+
+    watchdog.activeScript = script;
+    watchdog.activeCallback = callback;
+    watchdog.activeBudget = budget;
+    watchdog.callStart = Clock::now();
+    watchdog.instructions = 0;
+    watchdog.tripped = false;
+}
+
+ScriptWatchdog::Guard::~Guard() {
+    if (--watchdog.depth > 0) return;
+
+    // Back to the normal interval; a coroutine that tripped has died with its error
+    if (watchdog.tripped && watchdog.L) {
+        lua_sethook(watchdog.L, &ScriptWatchdog::Hook, LUA_MASKCOUNT, CheckInterval);
+    }
+    watchdog.tripped = false;
+    watchdog.activeScript = ScriptProfiler::NoScript;
+}
+
+void ScriptWatchdog::Attach(lua_State* state, ScriptProfiler* scriptProfiler, bool sampleWithProfiler) {
+    L = state;
+    profiler = scriptProfiler;
+    sampling = sampleWithProfiler;
+    // Found again from any thread of the state; new threads copy the main thread's space
+    *static_cast<ScriptWatchdog**>(lua_getextraspace(L)) = this;
+    lua_sethook(L, &ScriptWatchdog::Hook, LUA_MASKCOUNT, CheckInterval);
+}
+
+void ScriptWatchdog::Hook(lua_State* state, lua_Debug* ar) {
+    ScriptWatchdog* watchdog = *static_cast<ScriptWatchdog**>(lua_getextraspace(state));
+    if (!watchdog) return;
+
+    // Keep failing until control is back in the engine, even under a pcall in the script.
+    // Only trivially destructible locals from here on: luaL_error does not return.
+    if (watchdog->tripped) {
+        luaL_error(state, "script disabled: exceeded its budget");
+        return;
+    }
+
+    ScriptProfiler* profiler = watchdog->profiler;
+    if (profiler && watchdog->sampling && profiler->IsSampling()) {
+        watchdog->sampleCountdown -= CheckInterval;
+        if (watchdog->sampleCountdown <= 0) {
+            watchdog->sampleCountdown = profiler->GetSampleInterval();
+            profiler->Sample(state, ar);
+        }
+    }
+
+    if (!watchdog->enabled || watchdog->depth == 0) return;
+
+    watchdog->instructions += CheckInterval;
+    const Budget& budget = watchdog->activeBudget;
+    double milliseconds = 0.0;
+    bool over = budget.maxInstructions != 0 && watchdog->instructions > budget.maxInstructions;
+    if (budget.maxMilliseconds > 0.0) {
+        milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - watchdog->callStart).count();
+        over = over || milliseconds > budget.maxMilliseconds;
+    }
+    if (!over) return;
+
+    watchdog->Trip(state, milliseconds);
+    luaL_error(state, "script disabled: exceeded its budget");
+}
+
+void ScriptWatchdog::Trip(lua_State* state, double milliseconds) {
+    tripped = true;
+    if (activeScript != ScriptProfiler::NoScript) {
+        ScriptState& script = GetState(activeScript);
+        script.disabled = true;
+        ++script.violations;
+    }
+
+    const char* path = "?";
+    if (profiler && activeScript < profiler->GetScriptStats().size()) {
+        path = profiler->GetScriptStats()[activeScript].path.c_str();
+    }
+    char line[512];
+    std::snprintf(line, sizeof(line),
+                  "Script %s disabled: %s ran %.1f ms / %llu instructions (budget %.1f ms / %llu instructions); reload it to re-enable",
+                  path, ScriptProfiler::GetCallbackName(activeCallback), milliseconds,
+                  static_cast<unsigned long long>(instructions), activeBudget.maxMilliseconds,
+                  static_cast<unsigned long long>(activeBudget.maxInstructions));
+    reports.emplace_back(line);
+
+    // Check every instruction until the guard ends, so the error escapes any pcall
+    lua_sethook(state, &ScriptWatchdog::Hook, LUA_MASKCOUNT, 1);
+}
+
+ScriptWatchdog::ScriptState& ScriptWatchdog::GetState(uint32_t script) {
+    if (script >= scripts.size()) scripts.resize(script + 1);
+    return scripts[script];
+}
+
+void ScriptWatchdog::SetBudget(uint32_t script, const Budget& budget) {
+    ScriptState& state = GetState(script);
+    state.budget = budget;
+    state.hasBudget = true;
+}
+
+void ScriptWatchdog::ClearBudget(uint32_t script) {
+    if (script < scripts.size()) scripts[script].hasBudget = false;
+}
+
+const ScriptWatchdog::Budget& ScriptWatchdog::GetBudget(uint32_t script) const {
+    return script < scripts.size() && scripts[script].hasBudget ? scripts[script].budget : defaultBudget;
+}
+
+void ScriptWatchdog::EnableScript(uint32_t script) {
+    if (script < scripts.size()) scripts[script].disabled = false;
+}
+
+void ScriptWatchdog::DisableScript(uint32_t script, std::string report) {
+    ScriptState& state = GetState(script);
+    state.disabled = true;
+    ++state.violations;
+    reports.push_back(std::move(report));
+}
+
+std::vector<std::string> ScriptWatchdog::TakeReports() {
+    std::vector<std::string> taken;
+    taken.swap(reports);
+    return taken;
+}
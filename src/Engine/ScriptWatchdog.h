@@ -0,0 +1,107 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ScriptProfiler.h"
+
+struct lua_State;
+struct lua_Debug;
+
+/**
+ * ScriptWatchdog - per-call time and instruction budgets for scripts
+ * Owns the Lua state's count hook, which runs every CheckInterval VM instructions (and
+ * forwards to ScriptProfiler::Sample while sampling). Each call into a script is wrapped
+ * in a Guard; when the call runs past its script's budget the hook raises a Lua error
+ * (on every instruction from then on, so pcall inside the script cannot swallow it),
+ * the script is disabled and a report is queued for the editor log (TakeReports).
+ * A disabled script gets no more calls until EnableScript(), e.g. after a reload.
+ * OnTickBatch calls cover many entities, so they run under Budget::ForBatch.
+ *
+ * Coroutines created after Attach inherit the hook. Single-threaded, like the state: every
+ * Lua state needs its own watchdog (ParallelScriptRunner gives each shard one).
+ */
+class ScriptWatchdog {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int CheckInterval = 1000;
+
+    struct Budget {
+        double maxMilliseconds = 8.0;   // 0 = no time limit
+        uint64_t maxInstructions = 0;   // 0 = no instruction limit (counted in CheckInterval steps)
+        double maxBatchMilliseconds = 100.0;   // cap on a scaled batch time limit; 0 = no cap
+
+        // Limits for one call covering entityCount entities: the per-call limits times
+        // the count, with the time limit capped at maxBatchMilliseconds
+        Budget ForBatch(size_t entityCount) const;
+    };
+
+    struct ScriptState {
+        Budget budget;
+        bool hasBudget = false;   // otherwise the default budget applies
+        bool disabled = false;
+        uint64_t violations = 0;
+    };
+
+    // Arms the watchdog for one call into a script; nested guards run under the outer one
+    class Guard {
+    public:
+        Guard(ScriptWatchdog& watchdog, uint32_t script, ScriptProfiler::Callback callback);
+        // With an explicit budget instead of the script's own (batches, shard states)
+        Guard(ScriptWatchdog& watchdog, uint32_t script, ScriptProfiler::Callback callback, const Budget& budget);
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        ScriptWatchdog& watchdog;
+    };
+
+    // profiler may be null; names in reports come from it. With sampling off the hook
+    // never calls ScriptProfiler::Sample, so the profiler may belong to another state.
+    void Attach(lua_State* state, ScriptProfiler* profiler, bool sampling = true);
+
+    void SetEnabled(bool enabled) { this->enabled = enabled; }
+    bool IsEnabled() const { return enabled; }
+
+    void SetDefaultBudget(const Budget& budget) { defaultBudget = budget; }
+    const Budget& GetDefaultBudget() const { return defaultBudget; }
+    void SetBudget(uint32_t script, const Budget& budget);
+    void ClearBudget(uint32_t script);
+    const Budget& GetBudget(uint32_t script) const;
+
+    bool IsDisabled(uint32_t script) const { return script < scripts.size() && scripts[script].disabled; }
+    void EnableScript(uint32_t script);
+    // Disables a script that tripped another state's watchdog; report goes to TakeReports
+    void DisableScript(uint32_t script, std::string report);
+    const std::vector<ScriptState>& GetScriptStates() const { return scripts; }
+
+    // Budget violations since the last call, formatted for a log
+    std::vector<std::string> TakeReports();
+
+private:
+    static void Hook(lua_State* state, lua_Debug* ar);
+    void Trip(lua_State* state, double milliseconds);
+    ScriptState& GetState(uint32_t script);
+
+    lua_State* L = nullptr;
+    ScriptProfiler* profiler = nullptr;
+    bool sampling = true;
+    bool enabled = true;
+    Budget defaultBudget;
+    std::vector<ScriptState> scripts;   // indexed by script id (ScriptProfiler::RegisterScript)
+
+    // The call being guarded
+    int depth = 0;
+    uint32_t activeScript = ScriptProfiler::NoScript;
+    ScriptProfiler::Callback activeCallback = ScriptProfiler::Callback::OnTick;
+    Budget activeBudget;
+    Clock::time_point callStart;
+    uint64_t instructions = 0;
+    bool tripped = false;
+
+    int sampleCountdown = 0;
+    std::vector<std::string> reports;
+};
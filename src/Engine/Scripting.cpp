@@ -2,31 +2,185 @@
 #include "FileUtil.h"
 #include "Components.h"
 #include <iostream>
+#include <algorithm>
 
-static glm::vec3 GetRot(entt::registry& R, entt::entity e){ return R.get<Transform>(e).rotationEuler; }
-static void SetRot(entt::registry& R, entt::entity e, const glm::vec3& v){ R.get<Transform>(e).rotationEuler = v; }
+// Scripts see Euler degrees; Transform keeps a quaternion and caches the angles it was given
+static glm::vec3 GetRot(entt::registry& R, entt::entity e){ return R.get<Transform>(e).GetRotationEuler(); }
+static void SetRot(entt::registry& R, entt::entity e, const glm::vec3& v){ R.get<Transform>(e).SetRotationEuler(v); }
+
+namespace {
+    // Script-side reference to an entity's Transform. Holds the entity rather than a pointer
+    // and re-checks it on every access, so a ref kept past the entity's destruction raises a
+    // Lua error instead of touching freed storage.
+    struct TransformRef {
+        entt::registry* reg;
+        entt::entity entity;
+
+        bool IsValid() const { return reg->valid(entity) && reg->all_of<Transform>(entity); }
+
+        Transform& Get() const {
+            if(!IsValid()) throw sol::error("Transform of invalid entity " + std::to_string((uint32_t)entity));
+            return reg->get<Transform>(entity);
+        }
+    };
+
+    // t.position / t.scale. Goes through its TransformRef on every access rather than
+    // pointing into the component storage, so one kept across frames or past the entity
+    // stays safe, and only writes count as a change to the transform.
+    struct TransformVec3Ref {
+        TransformRef transform;
+        bool scale; // else position
+
+        glm::vec3 Get() const {
+            const Transform& t = transform.Get();
+            return scale ? t.GetScale() : t.GetPosition();
+        }
+
+        void Set(const glm::vec3& value) const {
+            Transform& t = transform.Get();
+            if(scale) t.SetScale(value);
+            else t.SetPosition(value);
+        }
+
+        void SetAxis(int axis, float value) const {
+            glm::vec3 v = Get();
+            v[axis] = value;
+            Set(v);
+        }
+    };
+}
 
 bool Scripting::init(){
+    profiler.Attach(lua.lua_state());
+    watchdog.Attach(lua.lua_state(), &profiler);
     lua.open_libraries(sol::lib::base, sol::lib::math, sol::lib::table, sol::lib::string);
+    gcScheduler.Attach(lua.lua_state());
+    latent.Attach(lua.lua_state(), &profiler, &watchdog);
     return true;
 }
 
 void Scripting::shutdown(){ }
 
+void Scripting::registerValueTypes(sol::state& target){
+    // vec3 value type: vec3(), vec3(s), vec3(x, y, z); fields x/y/z; + - * and tostring
+    target.new_usertype<glm::vec3>("vec3",
+        sol::call_constructor, sol::constructors<glm::vec3(), glm::vec3(float), glm::vec3(float, float, float)>(),
+        "x", &glm::vec3::x,
+        "y", &glm::vec3::y,
+        "z", &glm::vec3::z,
+        "Length", [](const glm::vec3& v){ return glm::length(v); },
+        sol::meta_function::addition, [](const glm::vec3& a, const glm::vec3& b){ return a + b; },
+        sol::meta_function::subtraction, [](const glm::vec3& a, const glm::vec3& b){ return a - b; },
+        sol::meta_function::multiplication, sol::overload(
+            [](const glm::vec3& v, float s){ return v * s; },
+            [](float s, const glm::vec3& v){ return v * s; }),
+        sol::meta_function::unary_minus, [](const glm::vec3& v){ return -v; },
+        sol::meta_function::to_string, [](const glm::vec3& v){
+            return "vec3(" + std::to_string(v.x) + ", " + std::to_string(v.y) + ", " + std::to_string(v.z) + ")";
+        });
+}
+
 void Scripting::attach(entt::registry& reg){
     lua["Print"] = [](const std::string& s){ std::cout << s << std::endl; };
 
+    registerValueTypes(lua);
+
+    // GetTransform(id) -> reference to the entity's Transform component, checked on every
+    // access. position and scale are TransformVec3Refs: t.position.x = 1 writes through,
+    // t.position:Get() copies out a vec3 for arithmetic. rotation is Euler degrees.
+    lua.new_usertype<TransformVec3Ref>("TransformVec3Ref",
+        sol::no_constructor,
+        "x", sol::property([](const TransformVec3Ref& r){ return r.Get().x; }, [](const TransformVec3Ref& r, float v){ r.SetAxis(0, v); }),
+        "y", sol::property([](const TransformVec3Ref& r){ return r.Get().y; }, [](const TransformVec3Ref& r, float v){ r.SetAxis(1, v); }),
+        "z", sol::property([](const TransformVec3Ref& r){ return r.Get().z; }, [](const TransformVec3Ref& r, float v){ r.SetAxis(2, v); }),
+        "Get", &TransformVec3Ref::Get,
+        sol::meta_function::to_string, [](const TransformVec3Ref& r){
+            const glm::vec3 v = r.Get();
+            return "vec3(" + std::to_string(v.x) + ", " + std::to_string(v.y) + ", " + std::to_string(v.z) + ")";
+        });
+
+    lua.new_usertype<TransformRef>("TransformRef",
+        sol::no_constructor,
+        "IsValid", &TransformRef::IsValid,
+        "entity", sol::readonly_property([](const TransformRef& t){ return (uint32_t)t.entity; }),
+        "position", sol::property(
+            [](const TransformRef& t){ t.Get(); return TransformVec3Ref{t, false}; },
+            [](const TransformRef& t, const glm::vec3& v){ t.Get().SetPosition(v); }),
+        "scale", sol::property(
+            [](const TransformRef& t){ t.Get(); return TransformVec3Ref{t, true}; },
+            [](const TransformRef& t, const glm::vec3& v){ t.Get().SetScale(v); }),
+        "rotation", sol::property(
+            [](const TransformRef& t){ return t.Get().GetRotationEuler(); },
+            [](const TransformRef& t, const glm::vec3& v){ t.Get().SetRotationEuler(v); }));
+
+    lua["GetTransform"] = [&reg](uint32_t id){
+        TransformRef ref{&reg, (entt::entity)id};
+        if(!ref.IsValid()) throw sol::error("GetTransform: invalid entity " + std::to_string(id));
+        return ref;
+    };
+
     // Basic accessors. Note: we pass tuples/arrays to/from Lua.
     lua["GetRotation"] = [&reg](uint32_t id){
         entt::entity e = (entt::entity)id;
         auto r = GetRot(reg, e);
         return std::make_tuple(r.x, r.y, r.z);
     };
-    lua["SetRotation"] = [&reg](uint32_t id, sol::table t){
-        float x = t.get_or(1, 0.0f);
-        float y = t.get_or(2, 0.0f);
-        float z = t.get_or(3, 0.0f);
-        SetRot(reg, (entt::entity)id, glm::vec3{x,y,z});
+    lua["SetRotation"] = sol::overload(
+        [&reg](uint32_t id, const glm::vec3& v){ SetRot(reg, (entt::entity)id, v); },
+        [&reg](uint32_t id, sol::table t){
+            float x = t.get_or(1, 0.0f);
+            float y = t.get_or(2, 0.0f);
+            float z = t.get_or(3, 0.0f);
+            SetRot(reg, (entt::entity)id, glm::vec3{x,y,z});
+        });
+    // Quaternion access (w, x, y, z) for scripts that want to avoid Euler round trips
+    lua["GetRotationQuat"] = [&reg](uint32_t id){
+        const glm::quat& q = reg.get<Transform>((entt::entity)id).GetRotation();
+        return std::make_tuple(q.w, q.x, q.y, q.z);
+    };
+    lua["SetRotationQuat"] = [&reg](uint32_t id, float w, float x, float y, float z){
+        reg.get<Transform>((entt::entity)id).SetRotation(glm::quat(w, x, y, z));
+    };
+
+    // Bulk forms over a packed id array (see OnTickBatch). Rotations are a flat
+    // {x1, y1, z1, x2, ...} array in degrees; pass out to refill a table instead of
+    // allocating a new one per call.
+    lua["GetRotations"] = [&reg](sol::table ids, sol::optional<sol::table> out, sol::this_state s){
+        const size_t count = ids.size();
+        sol::table rotations = out ? *out : sol::state_view(s).create_table(static_cast<int>(count * 3), 0);
+        for(size_t i = 0; i < count; ++i){
+            glm::vec3 r = GetRot(reg, (entt::entity)ids.raw_get<uint32_t>(i + 1));
+            rotations.raw_set(i * 3 + 1, r.x, i * 3 + 2, r.y, i * 3 + 3, r.z);
+        }
+        return rotations;
+    };
+    lua["SetRotations"] = [&reg](sol::table ids, sol::table rotations){
+        const size_t count = ids.size();
+        for(size_t i = 0; i < count; ++i){
+            glm::vec3 r{rotations.raw_get_or(i * 3 + 1, 0.0f),
+                        rotations.raw_get_or(i * 3 + 2, 0.0f),
+                        rotations.raw_get_or(i * 3 + 3, 0.0f)};
+            SetRot(reg, (entt::entity)ids.raw_get<uint32_t>(i + 1), r);
+        }
+    };
+
+    // Latent actions: StartLatent(fn, ...) runs fn as a coroutine, which may then
+    // Wait(seconds), WaitFrames(n) or WaitUntil(fn) without being ticked meanwhile.
+    // SetTickEnabled(id, false) stops OnTick/OnTickBatch calls for an entity altogether.
+    lua["StartLatent"] = [this](sol::protected_function fn, sol::variadic_args va){
+        std::vector<sol::object> args(va.begin(), va.end());
+        return latent.Start(fn, args);
+    };
+    lua["StopLatent"] = [this](LatentScheduler::Handle handle){ latent.Stop(handle); };
+    lua["IsLatentRunning"] = [this](LatentScheduler::Handle handle){ return latent.IsRunning(handle); };
+    lua["Wait"] = sol::yielding([this](double seconds, sol::this_state s){ latent.WaitSeconds(s, seconds); });
+    lua["WaitFrames"] = sol::yielding([this](int64_t frames, sol::this_state s){ latent.WaitFrames(s, frames); });
+    lua["WaitUntil"] = sol::yielding([this](sol::protected_function condition, sol::this_state s){ latent.WaitUntil(s, condition); });
+    lua["SetTickEnabled"] = [&reg](uint32_t id, bool enabled){
+        entt::entity e = (entt::entity)id;
+        if(!reg.valid(e)) return;
+        if(enabled) reg.remove<ScriptTickDisabled>(e);
+        else reg.emplace_or_replace<ScriptTickDisabled>(e);
     };
 }
 
@@ -34,49 +188,201 @@ bool Scripting::loadScript(entt::registry& reg, entt::entity e, const std::strin
     auto& sc = reg.get<Script>(e);
     sc.filePath = path;
     sc.lastUpdateTime = GetFileWriteTime(path);
-    auto src = ReadTextFile(path);
-    if(!src){ std::cerr<<"Failed to read script: "<<path<<"\n"; return false; }
+    scriptWatcher.Watch(path);
+
+    std::string key = FileWatcher::NormalizePath(path);
+    auto it = loadedScripts.find(key);
+    if(it == loadedScripts.end()){
+        auto script = std::make_unique<LoadedScript>();
+        script->path = key;
+        script->profileId = profiler.RegisterScript(key);
+        if(!compileScript(*script)){ sc.loaded = nullptr; return false; }
+        it = loadedScripts.emplace(key, std::move(script)).first;
+    }
+
+    bindEntity(reg, e, *it->second);
+    return true;
+}
+
+bool Scripting::reloadScript(entt::registry& reg, const std::string& path){
+    std::string key = FileWatcher::NormalizePath(path);
+    scriptWatcher.Watch(key);
+
+    // Actions started from here on belong to the new version
+    const LatentScheduler::Handle firstNewAction = latent.GetNextHandle();
 
-    sol::load_result chunk = lua.load(*src);
+    auto it = loadedScripts.find(key);
+    if(it == loadedScripts.end()){
+        auto script = std::make_unique<LoadedScript>();
+        script->path = key;
+        script->profileId = profiler.RegisterScript(key);
+        if(!compileScript(*script)) return false;
+        it = loadedScripts.emplace(key, std::move(script)).first;
+    } else if(!compileScript(*it->second)){
+        return false;
+    } else {
+        // The old code's coroutines would keep running next to the new OnStart's
+        latent.StopScript(it->second->profileId, firstNewAction);
+        // New code gets a fresh chance if the watchdog had disabled the old one
+        watchdog.EnableScript(it->second->profileId);
+    }
+
+    // Re-bind everything that runs this file
+    double writeTime = GetFileWriteTime(key);
+    auto view = reg.view<Script>();
+    for(auto e : view){
+        auto &sc = view.get<Script>(e);
+        if(sc.filePath.empty() || FileWatcher::NormalizePath(sc.filePath) != key) continue;
+        sc.lastUpdateTime = writeTime;
+        bindEntity(reg, e, *it->second);
+    }
+    return true;
+}
+
+bool Scripting::compileScript(LoadedScript& script){
+    auto src = ReadTextFile(script.path);
+    if(!src){ std::cerr<<"Failed to read script: "<<script.path<<"\n"; return false; }
+
+    // Compiled once per distinct source; a reload of an unchanged file or a restart with a
+    // warm cache directory skips the parser
+    const std::string chunkName = "@" + script.path;
+    std::string compileError;
+    const std::string* bytecode = bytecodeCache.GetBytecode(lua.lua_state(), *src, chunkName, compileError);
+    if(!bytecode){
+        std::cerr << "Lua load error: " << compileError << std::endl;
+        return false;
+    }
+
+    sol::load_result chunk = lua.load(std::string_view(*bytecode), chunkName, sol::load_mode::binary);
     if(!chunk.valid()){
         sol::error err = chunk;
         std::cerr << "Lua load error: " << err.what() << std::endl;
         return false;
     }
-    sol::protected_function script = chunk;
-    auto res = script();
+
+    // Fresh environment per compile, so functions removed from the file go away on reload
+    sol::environment env(lua, sol::create, lua.globals());
+    sol::protected_function body = chunk;
+    sol::set_environment(env, body);
+    auto res = [&]{
+        LatentScheduler::Context context(latent, script.profileId);
+        ScriptWatchdog::Guard guard(watchdog, script.profileId, ScriptProfiler::Callback::Load);
+        ScriptProfiler::Scope scope(profiler, script.profileId, ScriptProfiler::Callback::Load);
+        return body();
+    }();
     if(!res.valid()){
         sol::error err = res;
         std::cerr << "Lua exec error: " << err.what() << std::endl;
         return false;
     }
 
+    // Raw lookups: a script without OnTick must not pick up a global one
+    sol::object onStart = env.raw_get<sol::object>("OnStart");
+    sol::object onTick = env.raw_get<sol::object>("OnTick");
+    sol::object onTickBatch = env.raw_get<sol::object>("OnTickBatch");
+    script.parallel = env.raw_get_or("Parallel", false);
+    script.bytecode = *bytecode;
+    ++script.version;
+    script.env = std::move(env);
+    script.onStart = onStart.is<sol::protected_function>() ? onStart.as<sol::protected_function>() : sol::protected_function();
+    script.onTick = onTick.is<sol::protected_function>() ? onTick.as<sol::protected_function>() : sol::protected_function();
+    script.onTickBatch = onTickBatch.is<sol::protected_function>() ? onTickBatch.as<sol::protected_function>() : sol::protected_function();
+    if(!script.batchIds.valid()) script.batchIds = lua.create_table();
+    return true;
+}
+
+void Scripting::bindEntity(entt::registry& reg, entt::entity e, LoadedScript& script){
+    auto& sc = reg.get<Script>(e);
+    sc.loaded = &script;
     sc.needsUpdate = true;
 
-    // Call OnStart if present
-    sol::object onStartObj = lua["OnStart"];
-    if(onStartObj.is<sol::protected_function>()) {
-        sol::protected_function onStart = onStartObj.as<sol::protected_function>();
-        if(onStart.valid()) onStart((uint32_t)e);
+    // Entities with nothing to tick stay out of update() entirely; OnStart may still opt
+    // out below through SetTickEnabled
+    if(script.onTick.valid() || script.onTickBatch.valid()) reg.remove<ScriptTickDisabled>(e);
+    else reg.emplace_or_replace<ScriptTickDisabled>(e);
+
+    if(script.onStart.valid()){
+        LatentScheduler::Context context(latent, script.profileId, (uint32_t)e);
+        ScriptWatchdog::Guard guard(watchdog, script.profileId, ScriptProfiler::Callback::OnStart);
+        ScriptProfiler::Scope scope(profiler, script.profileId, ScriptProfiler::Callback::OnStart, (uint32_t)e);
+        script.onStart((uint32_t)e);
+    }
+}
+
+void Scripting::setParallelThreads(unsigned threads){
+    if(threads <= 1) parallelRunner.reset();
+    else if(!parallelRunner || parallelRunner->GetShardCount() != threads) parallelRunner = std::make_unique<ParallelScriptRunner>(threads, watchdog, profiler);
+}
+
+void Scripting::pollScriptChanges(){
+    std::vector<std::string> changed;
+    scriptWatcher.Poll(changed);
+    for(const auto& path : changed) queueReload(path);
+}
+
+void Scripting::queueReload(const std::string& path){
+    std::string key = FileWatcher::NormalizePath(path);
+    if(std::find(pendingReloads.begin(), pendingReloads.end(), key) == pendingReloads.end())
+        pendingReloads.push_back(std::move(key));
+}
+
+void Scripting::processPendingReloads(entt::registry& reg){
+    if(pendingReloads.empty()) return;
+
+    std::vector<std::string> reloads;
+    reloads.swap(pendingReloads);
+    for(const auto& path : reloads){
+        std::cout << "Hot reload: " << path << std::endl;
+        reloadScript(reg, path);
     }
-    return true;
 }
 
 void Scripting::update(entt::registry& reg, float dt){
-    auto view = reg.view<Script>();
+    profiler.BeginFrame();
+
+    // Safe point: nothing is mid-call into Lua here
+    pollScriptChanges();
+    processPendingReloads(reg);
+
+    // Direct calls through the cached references, no table lookups. Batch scripts only
+    // collect their entities here and are called once each below.
+    auto view = reg.view<Script>(entt::exclude<ScriptTickDisabled>);
     for(auto e : view){
-        auto &sc = view.get<Script>(e);
-        // Hot reload
-        double wt = GetFileWriteTime(sc.filePath);
-        if(!sc.filePath.empty() && wt > sc.lastUpdateTime){
-            std::cout << "Hot reload: " << sc.filePath << std::endl;
-            loadScript(reg, e, sc.filePath);
-        }
-        // Tick
-        sol::object onTickObj = lua["OnTick"];
-        if(onTickObj.is<sol::protected_function>()) {
-            sol::protected_function onTick = onTickObj.as<sol::protected_function>();
-            if(onTick.valid()) onTick((uint32_t)e, dt);
+        LoadedScript* script = view.get<Script>(e).loaded;
+        if(!script || watchdog.IsDisabled(script->profileId)) continue;
+        if(parallelRunner && script->parallel){
+            parallelRunner->Enqueue(e, *script);
+        } else if(script->onTickBatch.valid()){
+            if(script->batchEntities.empty()) batchedScripts.push_back(script);
+            script->batchEntities.push_back(e);
+        } else if(script->onTick.valid()){
+            LatentScheduler::Context context(latent, script->profileId, (uint32_t)e);
+            ScriptWatchdog::Guard guard(watchdog, script->profileId, ScriptProfiler::Callback::OnTick);
+            ScriptProfiler::Scope scope(profiler, script->profileId, ScriptProfiler::Callback::OnTick, (uint32_t)e);
+            script->onTick((uint32_t)e, dt);
         }
     }
+
+    for(LoadedScript* script : batchedScripts){
+        // Refill the reused id array, clearing whatever is left from a larger batch
+        const size_t count = script->batchEntities.size();
+        for(size_t i = 0; i < count; ++i) script->batchIds.raw_set(i + 1, (uint32_t)script->batchEntities[i]);
+        for(size_t i = count; i < script->batchIdCount; ++i) script->batchIds.raw_set(i + 1, sol::lua_nil);
+        script->batchIdCount = count;
+        script->batchEntities.clear();
+
+        // One call covers the whole batch, so it gets the per-call budget scaled by its size
+        LatentScheduler::Context context(latent, script->profileId);
+        ScriptWatchdog::Guard guard(watchdog, script->profileId, ScriptProfiler::Callback::OnTickBatch,
+                                    watchdog.GetBudget(script->profileId).ForBatch(count));
+        ScriptProfiler::Scope scope(profiler, script->profileId, ScriptProfiler::Callback::OnTickBatch);
+        script->onTickBatch(script->batchIds, dt);
+    }
+    batchedScripts.clear();
+
+    // Parallel-safe scripts; their writes are applied before this returns
+    if(parallelRunner) parallelRunner->Run(reg, dt);
+
+    // Only actions whose wait is over run here
+    latent.Update(reg, dt);
 }
@@ -4,6 +4,43 @@
 #include <string>
 #include <optional>
 #include <entt/entt.hpp>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "FileWatcher.h"
+#include "ScriptProfiler.h"
+#include "LuaGcScheduler.h"
+#include "LatentScheduler.h"
+#include "ParallelScripting.h"
+#include "ScriptBytecodeCache.h"
+#include "ScriptWatchdog.h"
+
+// One compiled script file. It runs in its own environment (reads fall back to the
+// globals holding the engine API), so scripts no longer overwrite each other's
+// OnStart/OnTick. Entities point at it through Script::loaded; reloads update it in place.
+//
+// A script that defines OnTickBatch(ids, dt) is called once per frame with the ids of
+// all its entities packed into batchIds (a table reused across frames); OnTick is then
+// not called. Scripts without it keep the per-entity OnTick.
+//
+// A script that sets Parallel = true declares its ticks parallel-safe: with parallel
+// ticking on they run on ParallelScriptRunner's Lua states, which load bytecode again.
+struct LoadedScript {
+    std::string path; // normalized
+    std::string bytecode; // as compiled by the bytecode cache
+    uint32_t version = 0; // bumped by every successful compile
+    bool parallel = false;
+    sol::environment env;
+    sol::protected_function onStart;
+    sol::protected_function onTick;
+    sol::protected_function onTickBatch;
+    uint32_t profileId = ScriptProfiler::NoScript;
+
+    // Batch dispatch state, rebuilt every update
+    sol::table batchIds;
+    size_t batchIdCount = 0; // entries currently set in batchIds
+    std::vector<entt::entity> batchEntities;
+};
 
 class Scripting {
 public:
@@ -13,8 +50,70 @@ public:
     void attach(entt::registry& reg);
     void update(entt::registry& reg, float dt);
 
+    // Binds e to the script at path, compiling the file only if it is not loaded yet
     bool loadScript(entt::registry& reg, entt::entity e, const std::string& path);
 
+    // Recompiles path now and re-binds every entity using it; on failure the previous
+    // version keeps running
+    bool reloadScript(entt::registry& reg, const std::string& path);
+
+    // Hot reload. Changed script files are queued by pollScriptChanges() and reloaded by
+    // processPendingReloads(); update() does both before ticking, so a reload never lands
+    // in the middle of a frame's script calls. Each queued file runs once, then every
+    // entity using it is re-bound (OnStart).
+    void pollScriptChanges();
+    void queueReload(const std::string& path);
+    const std::vector<std::string>& getPendingReloads() const { return pendingReloads; }
+    void processPendingReloads(entt::registry& reg);
+
+    // Per-script call timing, Lua allocations and function sampling (off until enabled)
+    ScriptProfiler& getProfiler() { return profiler; }
+
+    // Lua GC runs from here, in the time left after rendering (see LuaGcScheduler);
+    // call once per frame with the frame time so far and the target frame time. Hosts
+    // that do can switch the scheduler to incremental mode; the default needs no calls.
+    void collectGarbage(double frameSeconds, double targetFrameSeconds) { gcScheduler.Step(frameSeconds, targetFrameSeconds); }
+    LuaGcScheduler& getGcScheduler() { return gcScheduler; }
+
+    // Coroutines started with StartLatent; resumed by update() once their wait is over
+    LatentScheduler& getLatentScheduler() { return latent; }
+
+    // Ticks Parallel = true scripts on this many Lua states/threads; 0 or 1 turns it off
+    // and runs everything on the main state again
+    void setParallelThreads(unsigned threads);
+    unsigned getParallelThreads() const { return parallelRunner ? parallelRunner->GetShardCount() : 0; }
+
+    // Per-call time/instruction budgets; scripts that blow theirs are disabled until reloaded
+    ScriptWatchdog& getWatchdog() { return watchdog; }
+    // Id used by the profiler and watchdog for a script path
+    uint32_t getScriptId(const std::string& path) { return profiler.RegisterScript(FileWatcher::NormalizePath(path)); }
+
+    // Compiled chunks by source hash, in memory and under cache/scripts
+    ScriptBytecodeCache& getBytecodeCache() { return bytecodeCache; }
+
+    // Registers vec3 into a state (also used for the parallel states)
+    static void registerValueTypes(sol::state& target);
+
 private:
-    sol::state lua;
+    // Declared before lua: it is the state's allocator and must outlive it
+    ScriptProfiler profiler;
+    sol::state lua{sol::default_at_panic, &ScriptProfiler::LuaAlloc, &profiler};
+    LuaGcScheduler gcScheduler;
+    ScriptBytecodeCache bytecodeCache;
+    ScriptWatchdog watchdog;
+    // After lua: its coroutine references must go before the state does
+    LatentScheduler latent;
+    std::unique_ptr<ParallelScriptRunner> parallelRunner;
+
+    // Keyed by normalized path; records are never moved, entities hold pointers to them
+    std::unordered_map<std::string, std::unique_ptr<LoadedScript>> loadedScripts;
+
+    // Scripts with entities queued for OnTickBatch this update
+    std::vector<LoadedScript*> batchedScripts;
+
+    FileWatcher scriptWatcher;
+    std::vector<std::string> pendingReloads; // normalized paths, each at most once
+
+    bool compileScript(LoadedScript& script);
+    void bindEntity(entt::registry& reg, entt::entity e, LoadedScript& script);
 };
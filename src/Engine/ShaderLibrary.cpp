@@ -0,0 +1,536 @@
+#include "ShaderLibrary.h"
+#include "FileWatcher.h"
+#include <glad/glad.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#if defined(GL_VERSION_4_1) || defined(GL_ARB_get_program_binary)
+#define SPROUT_SHADER_PROGRAM_BINARY 1
+#endif
+
+#if defined(GL_KHR_parallel_shader_compile)
+#define SPROUT_SHADER_PARALLEL_COMPILE 1
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint64_t FnvOffsetBasis = 0xCBF29CE484222325ull;
+    constexpr uint64_t FnvPrime = 0x100000001B3ull;
+
+    uint64_t Fnv1a(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= FnvPrime;
+        }
+        return hash;
+    }
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t formatVersion;
+        uint64_t key;
+        uint32_t binaryFormat;
+        uint32_t reserved;
+        uint64_t size;
+    };
+
+    constexpr char FileMagic[4] = {'S', 'P', 'S', 'H'};
+    constexpr uint32_t FileFormatVersion = 1;
+
+    constexpr const char* UniformNames[] = {"uMVP", "uTint", "uModel"};
+    static_assert(sizeof(UniformNames) / sizeof(UniformNames[0]) == static_cast<size_t>(ShaderLibrary::Uniform::Count));
+
+    std::string ShaderLog(unsigned shader) {
+        char log[1024] = {};
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        return log;
+    }
+
+    std::string ProgramLog(unsigned program) {
+        char log[1024] = {};
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        return log;
+    }
+
+    unsigned CompileShader(unsigned type, const std::string& source) {
+        unsigned shader = glCreateShader(type);
+        const char* text = source.c_str();
+        glShaderSource(shader, 1, &text, nullptr);
+        glCompileShader(shader);
+        return shader;
+    }
+}
+
+ShaderLibrary::ShaderLibrary(std::string cacheDirectory)
+    : cacheDirectory(std::move(cacheDirectory)) {
+}
+
+ShaderLibrary::~ShaderLibrary() = default;
+
+bool ShaderLibrary::Init() {
+    auto glString = [](GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? std::string(reinterpret_cast<const char*>(value)) : std::string();
+    };
+    driverId = glString(GL_VENDOR) + "\n" + glString(GL_RENDERER) + "\n" + glString(GL_VERSION);
+
+    binarySupported = false;
+#ifdef GL_VERSION_4_1
+    binarySupported = binarySupported || GLAD_GL_VERSION_4_1;
+#endif
+#ifdef GL_ARB_get_program_binary
+    binarySupported = binarySupported || GLAD_GL_ARB_get_program_binary;
+#endif
+#if SPROUT_SHADER_PROGRAM_BINARY
+    if (binarySupported) {
+        // Some drivers expose the API but no format to save in
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        binarySupported = formats > 0;
+    }
+#endif
+
+    parallelCompileSupported = false;
+#if SPROUT_SHADER_PARALLEL_COMPILE
+    if (GLAD_GL_KHR_parallel_shader_compile) {
+        parallelCompileSupported = true;
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);   // as many as the driver likes
+    }
+#endif
+
+    glGenBuffers(1, &frameBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, frameBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), &frameData, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FrameBlockBinding, frameBuffer);
+    frameDataUploaded = true;
+
+    watcher = std::make_unique<FileWatcher>();
+    return frameBuffer != 0;
+}
+
+void ShaderLibrary::Shutdown() {
+    for (Program& program : programs) {
+        DiscardBuild(program.pending);
+        if (program.program) glDeleteProgram(program.program);
+        program.program = 0;
+    }
+    programs.clear();
+    handles.clear();
+    programsByFile.clear();
+    watcher.reset();
+
+    if (frameBuffer) glDeleteBuffers(1, &frameBuffer);
+    frameBuffer = 0;
+    frameDataUploaded = false;
+}
+
+ShaderLibrary::Handle ShaderLibrary::Load(const std::string& vertexPath, const std::string& fragmentPath,
+                                          const std::vector<std::string>& defines) {
+    std::string id = vertexPath + "\n" + fragmentPath;
+    for (const std::string& define : defines) {
+        id += "\n" + define;
+    }
+    auto found = handles.find(id);
+    if (found != handles.end()) return found->second;
+
+    const Clock::time_point start = Clock::now();
+    Program program;
+    program.vertexPath = vertexPath;
+    program.fragmentPath = fragmentPath;
+    program.defines = defines;
+
+    Build build;
+    std::string error;
+    if (!StartBuild(program, build, error) || !FinishBuild(build, error)) {
+        reports.push_back({true, "Shader " + vertexPath + " + " + fragmentPath + " failed: " + error});
+        std::fprintf(stderr, "%s\n", reports.back().message.c_str());
+        return InvalidHandle;
+    }
+    Install(program, build.program);
+
+    const Handle handle = static_cast<Handle>(programs.size());
+    programs.push_back(std::move(program));
+    handles.emplace(std::move(id), handle);
+    WatchFile(vertexPath, handle);
+    WatchFile(fragmentPath, handle);
+    for (const std::string& include : build.includes) {
+        WatchFile(include, handle);
+    }
+
+    stats.loadSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+    return handle;
+}
+
+void ShaderLibrary::WatchFile(const std::string& path, Handle handle) {
+    std::vector<Handle>& users = programsByFile[FileWatcher::NormalizePath(path)];
+    for (Handle user : users) {
+        if (user == handle) return;
+    }
+    users.push_back(handle);
+    if (watcher) watcher->Watch(path);
+}
+
+unsigned ShaderLibrary::GetProgram(Handle handle) const {
+    return handle < programs.size() ? programs[handle].program : 0;
+}
+
+int ShaderLibrary::GetUniform(Handle handle, Uniform uniform) const {
+    return handle < programs.size() ? programs[handle].uniforms[static_cast<size_t>(uniform)] : -1;
+}
+
+int ShaderLibrary::GetUniformLocation(Handle handle, const std::string& name) {
+    if (handle >= programs.size()) return -1;
+    Program& program = programs[handle];
+    auto it = program.namedUniforms.find(name);
+    if (it == program.namedUniforms.end()) {
+        it = program.namedUniforms.emplace(name, glGetUniformLocation(program.program, name.c_str())).first;
+    }
+    return it->second;
+}
+
+void ShaderLibrary::SetFrameData(const FrameData& data) {
+    if (frameDataUploaded && std::memcmp(&data, &frameData, sizeof(FrameData)) == 0) return;
+    frameData = data;
+    if (!frameBuffer) return;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, frameBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &frameData);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    frameDataUploaded = true;
+}
+
+void ShaderLibrary::Update() {
+    if (watcher) {
+        std::vector<std::string> changed;
+        watcher->Poll(changed);
+        for (const std::string& path : changed) {
+            auto it = programsByFile.find(path);
+            if (it == programsByFile.end()) continue;
+
+            for (Handle handle : it->second) {
+                Program& program = programs[handle];
+                // A newer edit supersedes a reload still in flight
+                DiscardBuild(program.pending);
+                std::string error;
+                if (!StartBuild(program, program.pending, error)) {
+                    ++stats.failedReloads;
+                    reports.push_back({true, "Shader reload " + program.vertexPath + " + " + program.fragmentPath +
+                                                 " failed, keeping the previous program: " + error});
+                }
+            }
+        }
+    }
+
+    for (Program& program : programs) {
+        if (!program.pending.program || !IsBuildDone(program.pending, parallelCompileSupported)) continue;
+
+        std::string error;
+        if (FinishBuild(program.pending, error)) {
+            Install(program, program.pending.program);
+            // An edit may have added an include
+            for (const std::string& include : program.pending.includes) {
+                WatchFile(include, static_cast<Handle>(&program - programs.data()));
+            }
+            ++stats.reloads;
+            reports.push_back({false, "Reloaded shader " + program.vertexPath + " + " + program.fragmentPath});
+        } else {
+            ++stats.failedReloads;
+            reports.push_back({true, "Shader reload " + program.vertexPath + " + " + program.fragmentPath +
+                                         " failed, keeping the previous program: " + error});
+        }
+        program.pending = Build{};
+    }
+}
+
+void ShaderLibrary::ReloadAll() {
+    for (Program& program : programs) {
+        DiscardBuild(program.pending);
+        std::string error;
+        if (!StartBuild(program, program.pending, error)) {
+            ++stats.failedReloads;
+            reports.push_back({true, "Shader reload " + program.vertexPath + " + " + program.fragmentPath +
+                                         " failed, keeping the previous program: " + error});
+        }
+    }
+}
+
+std::vector<ShaderLibrary::Report> ShaderLibrary::TakeReports() {
+    std::vector<Report> taken;
+    taken.swap(reports);
+    return taken;
+}
+
+std::string ShaderLibrary::LoadText(const std::string& path, bool& ok) {
+    std::ifstream in(path, std::ios::binary);
+    ok = static_cast<bool>(in);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+std::string ShaderLibrary::InjectDefines(const std::string& source, const std::vector<std::string>& defines) {
+    if (defines.empty()) return source;
+
+    std::string block;
+    for (const std::string& define : defines) {
+        block += "#define " + define + "\n";
+    }
+    // Defines must come after #version, which has to stay the first line
+    size_t insertAt = 0;
+    if (source.compare(0, 8, "#version") == 0) {
+        const size_t lineEnd = source.find('\n');
+        insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+        if (lineEnd == std::string::npos) block.insert(0, "\n");
+    }
+    return source.substr(0, insertAt) + block + source.substr(insertAt);
+}
+
+std::string ShaderLibrary::ResolveIncludes(const std::string& source, const std::string& path,
+                                           std::vector<std::string>& includes, std::string& error) {
+    if (source.find("#include") == std::string::npos) return source;
+
+    const fs::path directory = fs::path(path).parent_path();
+    std::string result;
+    std::istringstream lines(source);
+    std::string line;
+    while (std::getline(lines, line)) {
+        const size_t directive = line.find_first_not_of(" \t");
+        if (directive == std::string::npos || line.compare(directive, 8, "#include") != 0) {
+            result += line + "\n";
+            continue;
+        }
+
+        const size_t open = line.find('"', directive);
+        const size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+        if (close == std::string::npos) {
+            error = path + ": malformed " + line;
+            return {};
+        }
+        const std::string includePath = (directory / line.substr(open + 1, close - open - 1)).generic_string();
+        bool ok = false;
+        std::string included = LoadText(includePath, ok);
+        if (!ok) {
+            error = path + ": cannot read " + includePath;
+            return {};
+        }
+        includes.push_back(includePath);
+        result += included;
+        if (!included.empty() && included.back() != '\n') result += "\n";
+    }
+    return result;
+}
+
+uint64_t ShaderLibrary::HashSources(const std::string& vertexSource, const std::string& fragmentSource) const {
+    // A binary is only valid for the driver that produced it
+    uint64_t hash = Fnv1a(FnvOffsetBasis, driverId.data(), driverId.size());
+    hash = Fnv1a(hash, "\0", 1);
+    hash = Fnv1a(hash, vertexSource.data(), vertexSource.size());
+    hash = Fnv1a(hash, "\0", 1);
+    return Fnv1a(hash, fragmentSource.data(), fragmentSource.size());
+}
+
+bool ShaderLibrary::StartBuild(const Program& program, Build& build, std::string& error) {
+    build = Build{};
+    bool vertexOk = false, fragmentOk = false;
+    std::string vertexSource = LoadText(program.vertexPath, vertexOk);
+    std::string fragmentSource = LoadText(program.fragmentPath, fragmentOk);
+    if (!vertexOk || !fragmentOk) {
+        error = "cannot read " + (vertexOk ? program.fragmentPath : program.vertexPath);
+        return false;
+    }
+    error.clear();
+    vertexSource = ResolveIncludes(vertexSource, program.vertexPath, build.includes, error);
+    if (error.empty()) fragmentSource = ResolveIncludes(fragmentSource, program.fragmentPath, build.includes, error);
+    if (!error.empty()) return false;
+    vertexSource = InjectDefines(vertexSource, program.defines);
+    fragmentSource = InjectDefines(fragmentSource, program.defines);
+
+    build.key = HashSources(vertexSource, fragmentSource);
+    if (UsesProgramBinaries()) {
+        build.program = LoadBinary(build.key);
+        if (build.program) {
+            ++stats.binaryHits;
+            return true;
+        }
+    }
+
+    // Compile and link are only issued here; with parallel compile the driver works on
+    // them while the frame goes on, and FinishBuild is called once IsBuildDone says so
+    build.vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
+    build.fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    build.program = glCreateProgram();
+    glAttachShader(build.program, build.vertexShader);
+    glAttachShader(build.program, build.fragmentShader);
+#if SPROUT_SHADER_PROGRAM_BINARY
+    if (UsesProgramBinaries()) glProgramParameteri(build.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+    glLinkProgram(build.program);
+    ++stats.compiles;
+    return true;
+}
+
+bool ShaderLibrary::IsBuildDone(const Build& build, bool parallel) {
+#if SPROUT_SHADER_PARALLEL_COMPILE
+    if (parallel && build.vertexShader) {
+        GLint done = GL_FALSE;
+        glGetProgramiv(build.program, GL_COMPLETION_STATUS_KHR, &done);
+        return done == GL_TRUE;
+    }
+#else
+    (void)build;
+    (void)parallel;
+#endif
+    return true;
+}
+
+bool ShaderLibrary::FinishBuild(Build& build, std::string& error) {
+    // From a binary: already linked and checked by LoadBinary
+    if (!build.vertexShader) return build.program != 0;
+
+    GLint ok = GL_FALSE;
+    glGetShaderiv(build.vertexShader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        error = "vertex shader: " + ShaderLog(build.vertexShader);
+        DiscardBuild(build);
+        return false;
+    }
+    glGetShaderiv(build.fragmentShader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        error = "fragment shader: " + ShaderLog(build.fragmentShader);
+        DiscardBuild(build);
+        return false;
+    }
+    glGetProgramiv(build.program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        error = "link: " + ProgramLog(build.program);
+        DiscardBuild(build);
+        return false;
+    }
+
+    glDetachShader(build.program, build.vertexShader);
+    glDetachShader(build.program, build.fragmentShader);
+    glDeleteShader(build.vertexShader);
+    glDeleteShader(build.fragmentShader);
+    build.vertexShader = build.fragmentShader = 0;
+
+    if (UsesProgramBinaries()) SaveBinary(build.key, build.program);
+    return true;
+}
+
+void ShaderLibrary::DiscardBuild(Build& build) {
+    if (build.vertexShader) glDeleteShader(build.vertexShader);
+    if (build.fragmentShader) glDeleteShader(build.fragmentShader);
+    if (build.program) glDeleteProgram(build.program);
+    build = Build{};
+}
+
+void ShaderLibrary::Install(Program& program, unsigned linked) {
+    if (program.program && program.program != linked) glDeleteProgram(program.program);
+    program.program = linked;
+
+    for (size_t i = 0; i < static_cast<size_t>(Uniform::Count); ++i) {
+        program.uniforms[i] = glGetUniformLocation(linked, UniformNames[i]);
+    }
+    program.namedUniforms.clear();
+
+    const GLuint block = glGetUniformBlockIndex(linked, "FrameBlock");
+    if (block != GL_INVALID_INDEX) glUniformBlockBinding(linked, block, FrameBlockBinding);
+
+    // Tint defaults to white, as the old single-program path did
+    if (program.uniforms[static_cast<size_t>(Uniform::Tint)] >= 0) {
+        glUseProgram(linked);
+        glUniform3f(program.uniforms[static_cast<size_t>(Uniform::Tint)], 1.0f, 1.0f, 1.0f);
+        glUseProgram(0);
+    }
+}
+
+std::string ShaderLibrary::GetBinaryPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return cacheDirectory + "/" + name;
+}
+
+unsigned ShaderLibrary::LoadBinary(uint64_t key) {
+#if SPROUT_SHADER_PROGRAM_BINARY
+    std::ifstream in(GetBinaryPath(key), std::ios::binary);
+    if (!in) return 0;
+
+    FileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return 0;
+    if (std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0 ||
+        header.formatVersion != FileFormatVersion || header.key != key) {
+        return 0;
+    }
+    std::vector<char> binary(static_cast<size_t>(header.size));
+    if (!in.read(binary.data(), static_cast<std::streamsize>(binary.size()))) return 0;
+
+    unsigned program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        // Driver update or a format it no longer takes: rebuild from source, which overwrites the file
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+#else
+    (void)key;
+    return 0;
+#endif
+}
+
+void ShaderLibrary::SaveBinary(uint64_t key, unsigned program) {
+#if SPROUT_SHADER_PROGRAM_BINARY
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    std::error_code ec;
+    fs::create_directories(cacheDirectory, ec);
+    if (ec) return;
+
+    // Write aside and rename, so a reader never sees half a file
+    const std::string path = GetBinaryPath(key);
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+
+        FileHeader header{};
+        std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+        header.formatVersion = FileFormatVersion;
+        header.key = key;
+        header.binaryFormat = format;
+        header.size = static_cast<uint64_t>(written);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(binary.data(), written);
+        if (!out) {
+            out.close();
+            fs::remove(temporary, ec);
+            return;
+        }
+    }
+    fs::rename(temporary, path, ec);
+    if (ec) fs::remove(temporary, ec);
+#else
+    (void)key;
+    (void)program;
+#endif
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FileWatcher;
+
+/**
+ * ShaderLibrary - GL programs keyed by their shader files and #defines
+ * Load() returns a stable handle; loading the same files with the same defines again
+ * returns the same one. Every program gets its uniform locations resolved once per link
+ * (GetUniform for the engine's own names, GetUniformLocation caches any other name) and
+ * its FrameBlock uniform block bound to the shared per-frame UBO.
+ *
+ * Shader files may #include "file" (relative to the including file, one level deep);
+ * edits to included files reload every program using them.
+ *
+ * Linked programs are kept on disk as driver binaries (glGetProgramBinary, GL 4.1 or
+ * ARB_get_program_binary), keyed by the final sources and the GL vendor/renderer/version,
+ * so an unchanged shader set starts without compiling GLSL. A binary the driver rejects
+ * is recompiled from source and replaced.
+ *
+ * Update() watches the shader files: changed programs are recompiled in the background of
+ * the driver when KHR_parallel_shader_compile is available (polled, never waited on) and
+ * swapped in once linked. A reload that fails keeps the old program and reports the log.
+ * GL thread only.
+ */
+class ShaderLibrary {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = ~0u;
+
+    // Uniforms looked up at link time; -1 where a program does not use one
+    enum class Uniform : uint8_t {
+        MVP,
+        Tint,
+        Model,
+        Count
+    };
+
+    // std140 layout of the FrameBlock uniform block, see assets/shaders/*
+    struct FrameData {
+        glm::mat4 viewProj{1.0f};
+        glm::vec4 lightDirection{0.3f, 0.6f, 0.7f, 0.0f};   // xyz toward the light, normalized in the shader
+        glm::vec4 lightColor{1.0f, 1.0f, 1.0f, 0.15f};      // rgb, a = ambient floor
+        glm::vec4 cameraPosition{0.0f};
+        glm::vec4 time{0.0f};                               // x = seconds
+    };
+    static constexpr unsigned FrameBlockBinding = 0;
+
+    struct Stats {
+        uint32_t binaryHits = 0;
+        uint32_t compiles = 0;
+        uint32_t reloads = 0;
+        uint32_t failedReloads = 0;
+        double loadSeconds = 0.0;
+    };
+
+    // An empty cache directory disables program binaries
+    explicit ShaderLibrary(std::string cacheDirectory = "cache/shaders");
+    ~ShaderLibrary();
+
+    ShaderLibrary(const ShaderLibrary&) = delete;
+    ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+    // Needs a current GL context; creates the frame UBO and checks extensions
+    bool Init();
+    void Shutdown();
+
+    // defines are "NAME" or "NAME VALUE"; InvalidHandle if the program does not build
+    Handle Load(const std::string& vertexPath, const std::string& fragmentPath,
+                const std::vector<std::string>& defines = {});
+
+    // 0 for an invalid handle; may change after a reload, so look it up at draw time
+    unsigned GetProgram(Handle handle) const;
+    int GetUniform(Handle handle, Uniform uniform) const;
+    int GetUniformLocation(Handle handle, const std::string& name);
+
+    // Uploads only when the data differs from the last upload
+    void SetFrameData(const FrameData& data);
+    const FrameData& GetFrameData() const { return frameData; }
+
+    // Picks up edited shader files and swaps in finished recompiles
+    void Update();
+    // Recompiles every program (e.g. from the console)
+    void ReloadAll();
+
+    size_t GetProgramCount() const { return programs.size(); }
+    const Stats& GetStats() const { return stats; }
+    bool UsesProgramBinaries() const { return binarySupported && !cacheDirectory.empty(); }
+    bool UsesParallelCompile() const { return parallelCompileSupported; }
+
+    struct Report {
+        bool error;
+        std::string message;
+    };
+    // Compile errors and reloads since the last call, formatted for a log
+    std::vector<Report> TakeReports();
+
+private:
+    struct Build {
+        unsigned program = 0;
+        unsigned vertexShader = 0;
+        unsigned fragmentShader = 0;
+        uint64_t key = 0;
+        std::vector<std::string> includes;   // files pulled in by #include
+    };
+
+    struct Program {
+        std::string vertexPath;
+        std::string fragmentPath;
+        std::vector<std::string> defines;
+        unsigned program = 0;
+        int uniforms[static_cast<size_t>(Uniform::Count)] = {-1, -1, -1};
+        std::unordered_map<std::string, int> namedUniforms;
+        Build pending;   // reload in flight
+    };
+
+    static std::string LoadText(const std::string& path, bool& ok);
+    static std::string InjectDefines(const std::string& source, const std::vector<std::string>& defines);
+    static std::string ResolveIncludes(const std::string& source, const std::string& path,
+                                       std::vector<std::string>& includes, std::string& error);
+    void WatchFile(const std::string& path, Handle handle);
+    uint64_t HashSources(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+    bool StartBuild(const Program& program, Build& build, std::string& error);
+    bool FinishBuild(Build& build, std::string& error);
+    static bool IsBuildDone(const Build& build, bool parallel);
+    void DiscardBuild(Build& build);
+    void Install(Program& program, unsigned linked);
+
+    std::string GetBinaryPath(uint64_t key) const;
+    unsigned LoadBinary(uint64_t key);
+    void SaveBinary(uint64_t key, unsigned program);
+
+    std::string cacheDirectory;
+    std::string driverId;   // vendor/renderer/version, part of every binary key
+    bool binarySupported = false;
+    bool parallelCompileSupported = false;
+
+    std::vector<Program> programs;
+    std::unordered_map<std::string, Handle> handles;   // by paths + defines
+    std::unique_ptr<FileWatcher> watcher;
+    std::unordered_map<std::string, std::vector<Handle>> programsByFile;
+
+    unsigned frameBuffer = 0;
+    FrameData frameData;
+    bool frameDataUploaded = false;
+
+    Stats stats;
+    std::vector<Report> reports;
+};
@@ -345,6 +345,9 @@ public:
     std::string GenerateCpp() const override {
         std::string result = "class " + className + " : public " + baseClass + " {\n";
         result += "public:\n";
+        result += "    using ThisClass = " + className + ";\n";
+        result += "    using Super = " + baseClass + ";\n";
+        result += "    static std::string StaticClass() { return \"" + className + "\"; }\n\n";
 
         // Constructor
         result += "    " + className + "(World* world, const std::string& name = \"" + className + "\")\n";
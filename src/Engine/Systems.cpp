@@ -1,8 +1,362 @@
 #include "Systems.h"
 #include "Components.h"
+#include "TransformKernel.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+    // Changed Transforms gathered as SoA for TransformKernel; kept around to avoid reallocating
+    struct LocalMatrixBatch {
+        std::vector<float> positionX, positionY, positionZ;
+        std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+        std::vector<float> scaleX, scaleY, scaleZ;
+        std::vector<WorldTransform*> targets;
+        std::vector<float> matrices;
+
+        void Clear() {
+            for (auto* column : {&positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ,
+                                 &rotationW, &scaleX, &scaleY, &scaleZ}) {
+                column->clear();
+            }
+            targets.clear();
+        }
+
+        void Push(const Transform& t, WorldTransform* target) {
+            const glm::vec3& position = t.GetPosition();
+            positionX.push_back(position.x);
+            positionY.push_back(position.y);
+            positionZ.push_back(position.z);
+            const glm::quat& rotation = t.GetRotation();
+            rotationX.push_back(rotation.x);
+            rotationY.push_back(rotation.y);
+            rotationZ.push_back(rotation.z);
+            rotationW.push_back(rotation.w);
+            const glm::vec3& scale = t.GetScale();
+            scaleX.push_back(scale.x);
+            scaleY.push_back(scale.y);
+            scaleZ.push_back(scale.z);
+            targets.push_back(target);
+        }
+
+        void Compose() {
+            const size_t count = targets.size();
+            matrices.resize(count * 16);
+
+            TransformKernel::TRSArrays arrays{
+                positionX.data(), positionY.data(), positionZ.data(),
+                rotationX.data(), rotationY.data(), rotationZ.data(), rotationW.data(),
+                scaleX.data(), scaleY.data(), scaleZ.data()
+            };
+            TransformKernel::ComposeTRS(arrays, matrices.data(), count);
+
+            for (size_t i = 0; i < count; ++i) {
+                std::memcpy(glm::value_ptr(targets[i]->local), matrices.data() + i * 16, sizeof(float) * 16);
+            }
+        }
+    };
+
+    // Parent-before-child visit order, kept in the registry context. The order is a
+    // depth-first preorder, so an entity's subtree is the range [index, index + subtreeSize).
+    // New root entities are appended; anything else that changes the tree (reparenting,
+    // new children, removals) rebuilds it.
+    struct TransformHierarchy {
+        std::vector<entt::entity> order;
+        std::vector<uint32_t> subtreeSize;      // parallel to order
+        std::vector<uint32_t> orderIndex;       // by entity index; only valid where order[i] matches
+        std::vector<entt::entity> pendingAdded;
+        bool orderDirty = true;
+        // Entities whose parent is set but has no Transform (yet); while there are any,
+        // new entities rebuild the order in case one of them is that parent
+        size_t detachedCount = 0;
+        uint32_t frame = 0;
+
+        // Filled by the Transform setters (heap-allocated: Transforms keep its address)
+        std::unique_ptr<TransformDirtySet> dirtySet = std::make_unique<TransformDirtySet>();
+
+        // Per-update scratch
+        std::vector<entt::entity> dirty;
+        std::vector<uint32_t> dirtyIndices;
+        LocalMatrixBatch batch;
+
+        // RebuildOrder scratch: children of every entity as one flat array
+        std::vector<uint32_t> childOffsets;
+        std::vector<uint32_t> childCursor;
+        std::vector<entt::entity> children;
+        std::vector<entt::entity> roots;
+        std::vector<uint8_t> visited;
+        std::vector<entt::entity> stack;
+    };
+
+    void OnTransformConstructed(entt::registry& reg, entt::entity e) {
+        if (auto* hierarchy = reg.ctx().find<TransformHierarchy>()) {
+            reg.get<Transform>(e).BindDirtySet(hierarchy->dirtySet.get(), e);
+            hierarchy->pendingAdded.push_back(e);
+        }
+    }
+
+    void OnTransformDestroyed(entt::registry& reg, entt::entity) {
+        // Children of the removed entity turn into roots; the rebuild marks them changed
+        if (auto* hierarchy = reg.ctx().find<TransformHierarchy>()) {
+            hierarchy->orderDirty = true;
+        }
+    }
+
+    TransformHierarchy& GetHierarchy(entt::registry& reg) {
+        if (auto* hierarchy = reg.ctx().find<TransformHierarchy>()) {
+            return *hierarchy;
+        }
+        reg.on_construct<Transform>().connect<&OnTransformConstructed>();
+        reg.on_destroy<Transform>().connect<&OnTransformDestroyed>();
+        TransformHierarchy& hierarchy = reg.ctx().emplace<TransformHierarchy>();
+
+        // Transforms created before the first update start out changed
+        for (auto e : reg.view<Transform>()) {
+            reg.get<Transform>(e).BindDirtySet(hierarchy.dirtySet.get(), e);
+        }
+        return hierarchy;
+    }
+
+    // Parent used for propagation: null when unset, destroyed or without a Transform
+    entt::entity EffectiveParent(const entt::registry& reg, entt::entity e, const Transform& t) {
+        entt::entity parent = t.GetParent();
+        if (parent == entt::null || parent == e) return entt::null;
+        if (!reg.valid(parent) || !reg.all_of<Transform>(parent)) return entt::null;
+        return parent;
+    }
+
+    // Entities whose composed parent changes are added to hierarchy.dirty
+    void RebuildOrder(entt::registry& reg, TransformHierarchy& hierarchy) {
+        auto view = reg.view<Transform>();
+
+        size_t indexCount = 0;
+        for (auto e : view) {
+            indexCount = std::max(indexCount, static_cast<size_t>(entt::to_entity(e)) + 1);
+        }
+
+        // Children per parent, counted then scattered into one array
+        hierarchy.childOffsets.assign(indexCount + 1, 0);
+        hierarchy.roots.clear();
+        hierarchy.detachedCount = 0;
+        for (auto e : view) {
+            const Transform& t = view.get<Transform>(e);
+            entt::entity parent = EffectiveParent(reg, e, t);
+            if (parent != entt::null) {
+                ++hierarchy.childOffsets[entt::to_entity(parent) + 1];
+            } else {
+                hierarchy.roots.push_back(e);
+                if (t.GetParent() != entt::null && t.GetParent() != e) ++hierarchy.detachedCount;
+            }
+        }
+        for (size_t i = 1; i < hierarchy.childOffsets.size(); ++i) {
+            hierarchy.childOffsets[i] += hierarchy.childOffsets[i - 1];
+        }
+        hierarchy.children.resize(hierarchy.childOffsets.back());
+        hierarchy.childCursor.assign(hierarchy.childOffsets.begin(), hierarchy.childOffsets.end() - 1);
+        for (auto e : view) {
+            entt::entity parent = EffectiveParent(reg, e, view.get<Transform>(e));
+            if (parent != entt::null) {
+                hierarchy.children[hierarchy.childCursor[entt::to_entity(parent)]++] = e;
+            }
+        }
+
+        hierarchy.order.clear();
+        hierarchy.subtreeSize.clear();
+        hierarchy.orderIndex.resize(indexCount);
+        hierarchy.visited.assign(indexCount, 0);
+
+        // Preorder walk; composedParent is null for roots and for entities whose parent
+        // chain loops back on itself (cut where the walk enters the cycle)
+        auto walk = [&](entt::entity root) {
+            hierarchy.stack.clear();
+            hierarchy.stack.push_back(root);
+            hierarchy.visited[entt::to_entity(root)] = 1;
+            bool isRoot = true;
+            while (!hierarchy.stack.empty()) {
+                entt::entity e = hierarchy.stack.back();
+                hierarchy.stack.pop_back();
+                const size_t index = entt::to_entity(e);
+
+                entt::entity composedParent = isRoot ? entt::null : EffectiveParent(reg, e, view.get<Transform>(e));
+                isRoot = false;
+                WorldTransform* world = reg.try_get<WorldTransform>(e);
+                if (!world) world = &reg.emplace<WorldTransform>(e);
+                if (world->cachedParent != composedParent) {
+                    world->cachedParent = composedParent;
+                    hierarchy.dirty.push_back(e);
+                }
+
+                hierarchy.orderIndex[index] = static_cast<uint32_t>(hierarchy.order.size());
+                hierarchy.order.push_back(e);
+                hierarchy.subtreeSize.push_back(1);
+
+                // Reverse, so children come out in the order they were gathered
+                for (uint32_t c = hierarchy.childOffsets[index + 1]; c > hierarchy.childOffsets[index]; --c) {
+                    entt::entity child = hierarchy.children[c - 1];
+                    if (hierarchy.visited[entt::to_entity(child)]) continue;
+                    hierarchy.visited[entt::to_entity(child)] = 1;
+                    hierarchy.stack.push_back(child);
+                }
+            }
+        };
+        for (auto root : hierarchy.roots) {
+            walk(root);
+        }
+        for (auto e : view) {
+            if (!hierarchy.visited[entt::to_entity(e)]) walk(e);
+        }
+
+        // Children follow their parent, so sizes add up from the back
+        for (size_t i = hierarchy.order.size(); i-- > 1;) {
+            entt::entity parent = reg.get<WorldTransform>(hierarchy.order[i]).cachedParent;
+            if (parent != entt::null) {
+                hierarchy.subtreeSize[hierarchy.orderIndex[entt::to_entity(parent)]] += hierarchy.subtreeSize[i];
+            }
+        }
+
+        hierarchy.pendingAdded.clear();
+        hierarchy.orderDirty = false;
+    }
+
+    // Appends new root entities; a new child (or a possible missing parent) needs a rebuild
+    void AppendPendingEntities(entt::registry& reg, TransformHierarchy& hierarchy) {
+        if (hierarchy.detachedCount > 0) {
+            hierarchy.orderDirty = true;
+            return;
+        }
+        for (auto e : hierarchy.pendingAdded) {
+            if (!reg.valid(e) || !reg.all_of<Transform>(e)) continue;
+            if (EffectiveParent(reg, e, reg.get<Transform>(e)) != entt::null ||
+                reg.get<Transform>(e).GetParent() != entt::null) {
+                hierarchy.orderDirty = true;
+                return;
+            }
+            if (!reg.all_of<WorldTransform>(e)) {
+                reg.emplace<WorldTransform>(e);
+            }
+            const size_t index = entt::to_entity(e);
+            if (index >= hierarchy.orderIndex.size()) hierarchy.orderIndex.resize(index + 1);
+            hierarchy.orderIndex[index] = static_cast<uint32_t>(hierarchy.order.size());
+            hierarchy.order.push_back(e);
+            hierarchy.subtreeSize.push_back(1);
+        }
+        hierarchy.pendingAdded.clear();
+    }
+
+    // World-space axes straight from the rotation quaternion
+    void UpdateBasis(WorldTransform& world) {
+        const glm::quat& q = world.rotation;
+        const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+        world.right = glm::vec3(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy));
+        world.up = glm::vec3(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx));
+        world.forward = glm::vec3(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy));
+    }
+
+    // Takes this frame's dirty entities out of the set; true if one of them was reparented
+    bool CollectDirty(entt::registry& reg, TransformHierarchy& hierarchy) {
+        hierarchy.dirtySet->Collect(hierarchy.dirty);
+
+        bool reparented = false;
+        for (auto e : hierarchy.dirty) {
+            if (!reg.valid(e)) continue;
+            Transform* t = reg.try_get<Transform>(e);
+            if (!t) continue;
+            t->ClearDirty();
+
+            const WorldTransform* world = reg.try_get<WorldTransform>(e);
+            if (world && EffectiveParent(reg, e, *t) != world->cachedParent) {
+                reparented = true;
+            }
+        }
+        return reparented;
+    }
+
+    void UpdateWorldMatrices(entt::registry& reg, TransformHierarchy& hierarchy) {
+        // Order positions of the changed entities, ascending
+        hierarchy.dirtyIndices.clear();
+        for (auto e : hierarchy.dirty) {
+            if (!reg.valid(e) || !reg.all_of<Transform>(e)) continue;
+            const size_t index = entt::to_entity(e);
+            if (index >= hierarchy.orderIndex.size()) continue;
+            const uint32_t at = hierarchy.orderIndex[index];
+            if (at < hierarchy.order.size() && hierarchy.order[at] == e) {
+                hierarchy.dirtyIndices.push_back(at);
+            }
+        }
+        std::sort(hierarchy.dirtyIndices.begin(), hierarchy.dirtyIndices.end());
+        hierarchy.dirtyIndices.erase(std::unique(hierarchy.dirtyIndices.begin(), hierarchy.dirtyIndices.end()),
+                                     hierarchy.dirtyIndices.end());
+
+        // Rebuild the changed local matrices in one vectorized batch
+        LocalMatrixBatch& batch = hierarchy.batch;
+        batch.Clear();
+        for (uint32_t at : hierarchy.dirtyIndices) {
+            entt::entity e = hierarchy.order[at];
+            batch.Push(reg.get<Transform>(e), &reg.get<WorldTransform>(e));
+        }
+        if (!batch.targets.empty()) {
+            batch.Compose();
+        }
+
+        // Each changed subtree once, parents first. A subtree root's parent is either
+        // unchanged or was finished as part of an earlier range.
+        size_t coveredEnd = 0;
+        for (uint32_t at : hierarchy.dirtyIndices) {
+            if (at < coveredEnd) continue;
+            coveredEnd = at + hierarchy.subtreeSize[at];
+
+            for (size_t i = at; i < coveredEnd; ++i) {
+                entt::entity e = hierarchy.order[i];
+                WorldTransform& world = reg.get<WorldTransform>(e);
+                const glm::quat& rotation = reg.get<Transform>(e).GetRotation();
+                if (world.cachedParent != entt::null) {
+                    const WorldTransform& parentWorld = reg.get<WorldTransform>(world.cachedParent);
+                    world.matrix = parentWorld.matrix * world.local;
+                    world.rotation = parentWorld.rotation * rotation;
+                } else {
+                    world.matrix = world.local;
+                    world.rotation = rotation;
+                }
+                UpdateBasis(world);
+                world.updatedFrame = hierarchy.frame;
+            }
+        }
+    }
+}
 
 namespace Systems {
     void UpdateTransform(entt::registry& reg, float){
-        (void)reg;
+        TransformHierarchy& hierarchy = GetHierarchy(reg);
+
+        // 0 is reserved for "never updated"
+        if (++hierarchy.frame == 0) hierarchy.frame = 1;
+
+        if (CollectDirty(reg, hierarchy)) {
+            hierarchy.orderDirty = true;
+        }
+        if (!hierarchy.orderDirty && !hierarchy.pendingAdded.empty()) {
+            AppendPendingEntities(reg, hierarchy);
+        }
+        if (hierarchy.orderDirty) {
+            RebuildOrder(reg, hierarchy);
+        }
+
+        UpdateWorldMatrices(reg, hierarchy);
+        hierarchy.dirty.clear();
+    }
+
+    glm::mat4 GetWorldMatrix(const entt::registry& reg, entt::entity e) {
+        if (const auto* world = reg.try_get<WorldTransform>(e); world && world->updatedFrame != 0) {
+            return world->matrix;
+        }
+        if (const auto* t = reg.try_get<Transform>(e)) {
+            return t->GetLocalMatrix();
+        }
+        return glm::mat4(1.0f);
     }
 }
@@ -3,5 +3,10 @@
 #include <glm/glm.hpp>
 
 namespace Systems {
+    // Refreshes WorldTransform for every Transform whose local values or parent chain changed.
+    // Parents are always processed before their children; untouched subtrees are skipped.
     void UpdateTransform(entt::registry& reg, float dt);
+
+    // Cached world matrix, or the local matrix if the entity has not been through UpdateTransform yet
+    glm::mat4 GetWorldMatrix(const entt::registry& reg, entt::entity e);
 }
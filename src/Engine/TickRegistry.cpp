@@ -0,0 +1,273 @@
+#include "TickRegistry.h"
+#include "Actor.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace {
+    void TickItem(Actor* actor, float deltaTime) {
+        if (!actor->IsPendingDestroy()) {
+            actor->Tick(deltaTime);
+        }
+    }
+
+    void TickItem(ActorComponent* component, float deltaTime) {
+        // The owner may have been destroyed earlier in this group
+        if (!component->GetOwner()->IsPendingDestroy()) {
+            component->TickComponent(deltaTime);
+        }
+    }
+}
+
+TickRegistration& TickRegistry::RegistrationOf(Actor* actor) {
+    return actor->tickRegistration;
+}
+
+TickRegistration& TickRegistry::RegistrationOf(ActorComponent* component) {
+    return component->tickRegistration;
+}
+
+TickRegistry::TickRegistry() {
+    for (size_t group = 0; group < NumTickGroups; ++group) {
+        for (int gameThreadOnly = 0; gameThreadOnly < 2; ++gameThreadOnly) {
+            auto& bucket = actorBuckets[ActorBucketIndex(static_cast<ETickGroup>(group), gameThreadOnly != 0)];
+            bucket.group = static_cast<ETickGroup>(group);
+            bucket.gameThreadOnly = gameThreadOnly != 0;
+        }
+    }
+}
+
+void TickRegistry::RegisterActor(Actor* actor) {
+    if (!actor) return;
+    // Checked when the op is applied: a deferred unregister of this actor may come first
+    if (DeferIfTicking(PendingOpType::RegisterActor, actor, InvalidComponentTypeId)) return;
+    if (RegistrationOf(actor).IsRegistered()) return;
+
+    size_t bucketIndex = ActorBucketIndex(actor->GetTickGroup(), actor->IsTickOnGameThreadOnly());
+    AddToBucket(actorBuckets[bucketIndex], static_cast<int32_t>(bucketIndex), actor);
+    ++registeredActorCount;
+}
+
+void TickRegistry::UnregisterActor(Actor* actor) {
+    if (!actor) return;
+    if (DeferIfParallel(PendingOpType::UnregisterActor, actor, InvalidComponentTypeId)) return;
+    DropPendingRegister(actor);
+    if (!RegistrationOf(actor).IsRegistered()) return;
+
+    RemoveFromBucket(actorBuckets[RegistrationOf(actor).bucket], actor);
+    --registeredActorCount;
+}
+
+void TickRegistry::Register(ActorComponent* component, ComponentTypeId type) {
+    if (!component) return;
+    if (DeferIfTicking(PendingOpType::RegisterComponent, component, type)) return;
+    if (RegistrationOf(component).IsRegistered()) return;
+
+    uint32_t bucketIndex = FindOrCreateComponentBucket(type, component->GetTickGroup(),
+                                                       component->IsTickOnGameThreadOnly());
+    AddToBucket(componentBuckets[bucketIndex], static_cast<int32_t>(bucketIndex), component);
+    ++registeredComponentCount;
+}
+
+void TickRegistry::Unregister(ActorComponent* component) {
+    if (!component) return;
+    if (DeferIfParallel(PendingOpType::UnregisterComponent, component, InvalidComponentTypeId)) return;
+    DropPendingRegister(component);
+    if (!RegistrationOf(component).IsRegistered()) return;
+
+    RemoveFromBucket(componentBuckets[RegistrationOf(component).bucket], component);
+    --registeredComponentCount;
+}
+
+void TickRegistry::RunTickGroup(ETickGroup group, float deltaTime, JobSystem* jobs) {
+    bTicking = true;
+
+    const auto& componentBucketIndices = groupComponentBuckets[static_cast<size_t>(group)];
+
+    // Game-thread-only work first, so it can feed the parallel ticks of the same group
+    TickBucket(actorBuckets[ActorBucketIndex(group, true)], deltaTime, nullptr);
+    for (uint32_t bucketIndex : componentBucketIndices) {
+        if (componentBuckets[bucketIndex].gameThreadOnly) {
+            TickBucket(componentBuckets[bucketIndex], deltaTime, nullptr);
+        }
+    }
+
+    bParallelPhase = true;
+    TickBucket(actorBuckets[ActorBucketIndex(group, false)], deltaTime, jobs);
+    for (uint32_t bucketIndex : componentBucketIndices) {
+        if (!componentBuckets[bucketIndex].gameThreadOnly) {
+            TickBucket(componentBuckets[bucketIndex], deltaTime, jobs);
+        }
+    }
+    bParallelPhase = false;
+
+    bTicking = false;
+
+    for (auto& bucket : actorBuckets) {
+        if (bucket.hasHoles) CompactBucket(bucket);
+    }
+    for (auto& bucket : componentBuckets) {
+        if (bucket.hasHoles) CompactBucket(bucket);
+    }
+
+    ApplyPendingOps();
+}
+
+void TickRegistry::Clear() {
+    for (auto& bucket : actorBuckets) {
+        for (Actor* actor : bucket.items) {
+            if (actor) RegistrationOf(actor) = TickRegistration{};
+        }
+        bucket.items.clear();
+        bucket.hasHoles = false;
+    }
+    for (auto& bucket : componentBuckets) {
+        for (ActorComponent* component : bucket.items) {
+            if (component) RegistrationOf(component) = TickRegistration{};
+        }
+    }
+    componentBuckets.clear();
+    componentBucketLookup.clear();
+    for (auto& indices : groupComponentBuckets) {
+        indices.clear();
+    }
+    registeredActorCount = 0;
+    registeredComponentCount = 0;
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingOps.clear();
+}
+
+bool TickRegistry::DeferIfTicking(PendingOpType type, void* object, ComponentTypeId componentType) {
+    if (!bTicking) return false;
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingOps.push_back(PendingOp{type, object, componentType});
+    return true;
+}
+
+bool TickRegistry::DeferIfParallel(PendingOpType type, void* object, ComponentTypeId componentType) {
+    if (!bParallelPhase.load(std::memory_order_acquire)) return false;
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingOps.push_back(PendingOp{type, object, componentType});
+    return true;
+}
+
+void TickRegistry::DropPendingRegister(void* object) {
+    if (!bTicking) return;
+
+    // Spawned and removed within one group: the object may be freed before the ops run
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingOps.erase(std::remove_if(pendingOps.begin(), pendingOps.end(), [object](const PendingOp& op) {
+        return op.object == object &&
+               (op.type == PendingOpType::RegisterActor || op.type == PendingOpType::RegisterComponent);
+    }), pendingOps.end());
+}
+
+void TickRegistry::ApplyPendingOps() {
+    std::vector<PendingOp> ops;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        ops.swap(pendingOps);
+    }
+
+    for (const PendingOp& op : ops) {
+        switch (op.type) {
+            case PendingOpType::RegisterActor:
+                RegisterActor(static_cast<Actor*>(op.object));
+                break;
+            case PendingOpType::UnregisterActor:
+                UnregisterActor(static_cast<Actor*>(op.object));
+                break;
+            case PendingOpType::RegisterComponent:
+                Register(static_cast<ActorComponent*>(op.object), op.componentType);
+                break;
+            case PendingOpType::UnregisterComponent:
+                Unregister(static_cast<ActorComponent*>(op.object));
+                break;
+        }
+    }
+}
+
+uint32_t TickRegistry::FindOrCreateComponentBucket(ComponentTypeId type, ETickGroup group, bool gameThreadOnly) {
+    if (type >= componentBucketLookup.size()) {
+        std::array<int32_t, NumTickGroups * 2> unassigned;
+        unassigned.fill(-1);
+        componentBucketLookup.resize(static_cast<size_t>(type) + 1, unassigned);
+    }
+
+    int32_t& bucketIndex = componentBucketLookup[type][ActorBucketIndex(group, gameThreadOnly)];
+    if (bucketIndex < 0) {
+        bucketIndex = static_cast<int32_t>(componentBuckets.size());
+        Bucket<ActorComponent> bucket;
+        bucket.group = group;
+        bucket.gameThreadOnly = gameThreadOnly;
+        componentBuckets.push_back(std::move(bucket));
+        groupComponentBuckets[static_cast<size_t>(group)].push_back(static_cast<uint32_t>(bucketIndex));
+    }
+    return static_cast<uint32_t>(bucketIndex);
+}
+
+template<typename T>
+void TickRegistry::AddToBucket(Bucket<T>& bucket, int32_t bucketIndex, T* item) {
+    TickRegistration& registration = RegistrationOf(item);
+    registration.bucket = bucketIndex;
+    registration.slot = static_cast<uint32_t>(bucket.items.size());
+    bucket.items.push_back(item);
+}
+
+template<typename T>
+void TickRegistry::RemoveFromBucket(Bucket<T>& bucket, T* item) {
+    TickRegistration& registration = RegistrationOf(item);
+    uint32_t slot = registration.slot;
+
+    if (bTicking) {
+        // Leave a hole so indices stay valid for the loop in flight; compacted afterwards
+        bucket.items[slot] = nullptr;
+        bucket.hasHoles = true;
+    } else {
+        // Swap-and-pop
+        T* last = bucket.items.back();
+        bucket.items[slot] = last;
+        RegistrationOf(last).slot = slot;
+        bucket.items.pop_back();
+    }
+
+    registration = TickRegistration{};
+}
+
+template<typename T>
+void TickRegistry::TickBucket(Bucket<T>& bucket, float deltaTime, JobSystem* jobs) {
+    const size_t count = bucket.items.size();
+    if (count == 0) return;
+
+    if (jobs && !bucket.gameThreadOnly) {
+        // No registration changes reach the vector during the parallel phase
+        T* const* items = bucket.items.data();
+        jobs->ParallelFor(count, ParallelChunkSize, [items, deltaTime](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (T* item = items[i]) TickItem(item, deltaTime);
+            }
+        });
+        return;
+    }
+
+    // Serial: registrations made by these ticks wait for the end of the group
+    for (size_t i = 0; i < count; ++i) {
+        if (T* item = bucket.items[i]) TickItem(item, deltaTime);
+    }
+}
+
+template<typename T>
+void TickRegistry::CompactBucket(Bucket<T>& bucket) {
+    auto& items = bucket.items;
+    size_t write = 0;
+    for (size_t read = 0; read < items.size(); ++read) {
+        if (T* item = items[read]) {
+            RegistrationOf(item).slot = static_cast<uint32_t>(write);
+            items[write++] = item;
+        }
+    }
+    items.resize(write);
+    bucket.hasHoles = false;
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "ComponentStorage.h"
+
+class Actor;
+class ActorComponent;
+class JobSystem;
+
+/**
+ * Tick groups run in order every frame; everything in one group finishes before the next starts
+ */
+enum class ETickGroup : uint8_t {
+    PrePhysics,
+    DuringPhysics,
+    PostPhysics,
+    PostUpdateWork,
+    Count
+};
+
+constexpr size_t NumTickGroups = static_cast<size_t>(ETickGroup::Count);
+
+// Where an actor/component sits inside the registry (bucket -1 means not registered)
+struct TickRegistration {
+    int32_t bucket = -1;
+    uint32_t slot = 0;
+
+    bool IsRegistered() const { return bucket >= 0; }
+};
+
+/**
+ * TickRegistry - dense per-tick-group arrays of ticking actors and components
+ * Components are further bucketed per concrete type so every component of one class
+ * runs back to back. Within a group, game-thread-only entries tick first on the
+ * calling thread, then the rest are split into parallel chunks on the JobSystem.
+ *
+ * Registrations made while a group is ticking are deferred until that group finishes,
+ * since adding one may create a bucket and move the ones being iterated. Unregistering
+ * leaves a hole on the game thread and is deferred only during the parallel part.
+ */
+class TickRegistry {
+public:
+    static constexpr size_t ParallelChunkSize = 64;
+
+    TickRegistry();
+
+    void RegisterActor(Actor* actor);
+    void UnregisterActor(Actor* actor);
+
+    // Adds a component to the bucket for its concrete type (no-op if already registered)
+    void Register(ActorComponent* component, ComponentTypeId type);
+    void Unregister(ActorComponent* component);
+
+    void RunTickGroup(ETickGroup group, float deltaTime, JobSystem* jobs);
+
+    // True while RunTickGroup is in its parallel part (on every thread)
+    bool IsInParallelPhase() const { return bParallelPhase.load(std::memory_order_acquire); }
+
+    size_t GetRegisteredCount() const { return registeredComponentCount; }
+    size_t GetRegisteredActorCount() const { return registeredActorCount; }
+    size_t GetBucketCount() const { return componentBuckets.size(); }
+    void Clear();
+
+private:
+    template<typename T>
+    struct Bucket {
+        std::vector<T*> items;
+        ETickGroup group = ETickGroup::PrePhysics;
+        bool gameThreadOnly = false;
+        bool hasHoles = false;
+    };
+
+    enum class PendingOpType : uint8_t {
+        RegisterActor,
+        UnregisterActor,
+        RegisterComponent,
+        UnregisterComponent
+    };
+
+    struct PendingOp {
+        PendingOpType type;
+        void* object;
+        ComponentTypeId componentType;
+    };
+
+    // One actor bucket per (group, thread mode)
+    std::array<Bucket<Actor>, NumTickGroups * 2> actorBuckets;
+
+    // Component buckets per (type, group, thread mode)
+    std::vector<Bucket<ActorComponent>> componentBuckets;
+    // Indexed by ComponentTypeId; -1 where no bucket exists yet
+    std::vector<std::array<int32_t, NumTickGroups * 2>> componentBucketLookup;
+    std::array<std::vector<uint32_t>, NumTickGroups> groupComponentBuckets;
+
+    size_t registeredActorCount = 0;
+    size_t registeredComponentCount = 0;
+
+    // Iteration state: holes instead of swap-and-pop while ticking, deferred registration
+    bool bTicking = false;
+    std::atomic<bool> bParallelPhase{false};
+    std::mutex pendingMutex;
+    std::vector<PendingOp> pendingOps;
+
+    bool DeferIfTicking(PendingOpType type, void* object, ComponentTypeId componentType);
+    bool DeferIfParallel(PendingOpType type, void* object, ComponentTypeId componentType);
+    void DropPendingRegister(void* object);
+    void ApplyPendingOps();
+
+    uint32_t FindOrCreateComponentBucket(ComponentTypeId type, ETickGroup group, bool gameThreadOnly);
+
+    template<typename T>
+    void AddToBucket(Bucket<T>& bucket, int32_t bucketIndex, T* item);
+    template<typename T>
+    void RemoveFromBucket(Bucket<T>& bucket, T* item);
+    template<typename T>
+    void TickBucket(Bucket<T>& bucket, float deltaTime, JobSystem* jobs);
+    template<typename T>
+    static void CompactBucket(Bucket<T>& bucket);
+
+    static TickRegistration& RegistrationOf(Actor* actor);
+    static TickRegistration& RegistrationOf(ActorComponent* component);
+
+    static size_t ActorBucketIndex(ETickGroup group, bool gameThreadOnly) {
+        return static_cast<size_t>(group) * 2 + (gameThreadOnly ? 1 : 0);
+    }
+};
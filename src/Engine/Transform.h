@@ -2,49 +2,297 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/constants.hpp>
 #include <entt/entt.hpp>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Entities whose Transform changed since the last Systems::UpdateTransform
+ * Transforms report themselves through their setters once the system has bound them.
+ * Add may be called from several threads (parallel ticks): every thread appends to a list
+ * of its own, so only a thread's first Add to a set takes the lock. Collect runs on the
+ * game thread between ticks and must not overlap an Add.
+ */
+struct TransformDirtySet {
+    TransformDirtySet() : id(NextId()) {}
+
+    TransformDirtySet(const TransformDirtySet&) = delete;
+    TransformDirtySet& operator=(const TransformDirtySet&) = delete;
+
+    void Add(entt::entity e) { LocalList().push_back(e); }
+
+    // Replaces out with every thread's entries and empties the lists (capacity is kept)
+    void Collect(std::vector<entt::entity>& out) {
+        out.clear();
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<ThreadList>& list : lists) {
+            out.insert(out.end(), list->entities.begin(), list->entities.end());
+            list->entities.clear();
+        }
+    }
+
+private:
+    struct ThreadList {
+        std::thread::id thread;
+        std::vector<entt::entity> entities;
+    };
+
+    // Sets are told apart by id, not address: a new set may reuse a freed one's memory
+    uint64_t id;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadList>> lists;
+
+    std::vector<entt::entity>& LocalList() {
+        // The list this thread used last; switching sets (e.g. two registries) goes through the lock
+        struct Cache {
+            uint64_t set = 0;
+            std::vector<entt::entity>* entities = nullptr;
+        };
+        thread_local Cache cache;
+        if (cache.set == id) return *cache.entities;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::thread::id thread = std::this_thread::get_id();
+        ThreadList* found = nullptr;
+        for (const std::unique_ptr<ThreadList>& list : lists) {
+            if (list->thread == thread) {
+                found = list.get();
+                break;
+            }
+        }
+        if (!found) {
+            lists.push_back(std::make_unique<ThreadList>(ThreadList{thread, {}}));
+            found = lists.back().get();
+        }
+        cache = Cache{id, &found->entities};
+        return found->entities;
+    }
+
+    static uint64_t NextId() {
+        static std::atomic<uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+};
 
 /**
  * Enhanced Transform component with hierarchy support
+ * Rotation is stored as a normalized quaternion. Euler angles (degrees, applied X then Y
+ * then Z) are kept as given when set directly, so editing or accumulating them round-trips
+ * exactly; after a quaternion write they are derived from the quaternion on each read.
+ *
+ * All state is behind setters so every change reaches the dirty set that
+ * Systems::UpdateTransform works from. Copies carry values only; moves (the registry
+ * relocating the component) carry the binding along.
  */
 struct Transform {
-    glm::vec3 position{0.0f};
-    glm::vec3 rotationEuler{0.0f}; // degrees
-    glm::vec3 scale{1.0f};
+    Transform() = default;
+
+    Transform(const Transform& other) { CopyValues(other); }
+
+    Transform(Transform&& other) noexcept {
+        CopyValues(other);
+        dirtySet = other.dirtySet;
+        self = other.self;
+        dirty = other.dirty;
+    }
+
+    Transform& operator=(const Transform& other) {
+        if (this != &other) {
+            CopyValues(other);
+            MarkDirty();
+        }
+        return *this;
+    }
+
+    // A bound source is the registry moving a component between slots; an unbound one
+    // is a new value assigned over this entity's component
+    Transform& operator=(Transform&& other) noexcept {
+        if (this == &other) return *this;
+        CopyValues(other);
+        if (other.dirtySet) {
+            dirtySet = other.dirtySet;
+            self = other.self;
+            dirty = other.dirty;
+        } else {
+            MarkDirty();
+        }
+        return *this;
+    }
+
+    const glm::vec3& GetPosition() const { return position; }
+    void SetPosition(const glm::vec3& value) {
+        position = value;
+        MarkDirty();
+    }
+
+    const glm::vec3& GetScale() const { return scale; }
+    void SetScale(const glm::vec3& value) {
+        scale = value;
+        MarkDirty();
+    }
 
     // Hierarchy support
-    entt::entity parent{entt::null};
+    entt::entity GetParent() const { return parent; }
+    void SetParent(entt::entity value) {
+        parent = value;
+        MarkDirty();
+    }
 
-    // Helper methods
-    glm::mat4 GetLocalMatrix() const {
-        glm::mat4 T = glm::translate(glm::mat4(1.0f), position);
-        glm::mat4 R = glm::rotate(glm::mat4(1.0f), glm::radians(rotationEuler.x), glm::vec3(1, 0, 0));
-        R = glm::rotate(R, glm::radians(rotationEuler.y), glm::vec3(0, 1, 0));
-        R = glm::rotate(R, glm::radians(rotationEuler.z), glm::vec3(0, 0, 1));
-        glm::mat4 S = glm::scale(glm::mat4(1.0f), scale);
-        return T * R * S;
+    // Rotation
+    const glm::quat& GetRotation() const { return rotation; }
+
+    void SetRotation(const glm::quat& quat) {
+        rotation = glm::normalize(quat);
+        eulerValid = false;
+        MarkDirty();
+    }
+
+    // Applies delta in local space (after the current rotation)
+    void Rotate(const glm::quat& delta) {
+        SetRotation(rotation * delta);
+    }
+
+    // Never writes, so concurrent reads (parallel ticks, script workers) are safe
+    glm::vec3 GetRotationEuler() const {
+        return eulerValid ? rotationEuler : EulerFromQuat(rotation);
     }
 
-    glm::quat GetRotationQuaternion() const {
-        return glm::quat(glm::radians(rotationEuler));
+    void SetRotationEuler(const glm::vec3& degrees) {
+        rotation = QuatFromEuler(degrees);
+        rotationEuler = degrees;
+        eulerValid = true;
+        MarkDirty();
     }
 
-    void SetRotationQuaternion(const glm::quat& quat) {
-        rotationEuler = glm::degrees(glm::eulerAngles(quat));
+    // Helper methods
+    glm::mat4 GetLocalMatrix() const {
+        glm::mat4 M = glm::mat4_cast(rotation);
+        M[0] *= scale.x;
+        M[1] *= scale.y;
+        M[2] *= scale.z;
+        M[3] = glm::vec4(position, 1.0f);
+        return M;
     }
 
+    // Legacy names, kept for existing callers
+    glm::quat GetRotationQuaternion() const { return rotation; }
+    void SetRotationQuaternion(const glm::quat& quat) { SetRotation(quat); }
+
+    // Local basis: columns of the rotation matrix, no trig involved
     glm::vec3 GetForward() const {
-        glm::quat quat = GetRotationQuaternion();
-        return quat * glm::vec3(0, 0, 1);
+        const glm::quat& q = rotation;
+        return glm::vec3(2.0f * (q.x * q.z + q.w * q.y),
+                         2.0f * (q.y * q.z - q.w * q.x),
+                         1.0f - 2.0f * (q.x * q.x + q.y * q.y));
     }
 
     glm::vec3 GetRight() const {
-        glm::quat quat = GetRotationQuaternion();
-        return quat * glm::vec3(1, 0, 0);
+        const glm::quat& q = rotation;
+        return glm::vec3(1.0f - 2.0f * (q.y * q.y + q.z * q.z),
+                         2.0f * (q.x * q.y + q.w * q.z),
+                         2.0f * (q.x * q.z - q.w * q.y));
     }
 
     glm::vec3 GetUp() const {
-        glm::quat quat = GetRotationQuaternion();
-        return quat * glm::vec3(0, 1, 0);
+        const glm::quat& q = rotation;
+        return glm::vec3(2.0f * (q.x * q.y - q.w * q.z),
+                         1.0f - 2.0f * (q.x * q.x + q.z * q.z),
+                         2.0f * (q.y * q.z + q.w * q.x));
+    }
+
+    // Same rotation as the matrix Rx * Ry * Rz
+    static glm::quat QuatFromEuler(const glm::vec3& degrees) {
+        glm::vec3 radians = glm::radians(degrees);
+        return glm::normalize(glm::angleAxis(radians.x, glm::vec3(1, 0, 0)) *
+                              glm::angleAxis(radians.y, glm::vec3(0, 1, 0)) *
+                              glm::angleAxis(radians.z, glm::vec3(0, 0, 1)));
+    }
+
+    static glm::vec3 EulerFromQuat(const glm::quat& q) {
+        // R = Rx * Ry * Rz gives R[0][2] = sin(y) (row, column)
+        float sinY = 2.0f * (q.x * q.z + q.w * q.y);
+        glm::vec3 radians;
+        if (std::abs(sinY) > 0.99999f) {
+            // Gimbal lock: X and Z share an axis, put all of it on X
+            radians.y = std::copysign(glm::half_pi<float>(), sinY);
+            radians.z = 0.0f;
+            radians.x = std::atan2(2.0f * (q.y * q.z + q.w * q.x), 1.0f - 2.0f * (q.x * q.x + q.z * q.z));
+        } else {
+            radians.y = std::asin(sinY);
+            radians.x = std::atan2(-2.0f * (q.y * q.z - q.w * q.x), 1.0f - 2.0f * (q.x * q.x + q.y * q.y));
+            radians.z = std::atan2(-2.0f * (q.x * q.y - q.w * q.z), 1.0f - 2.0f * (q.y * q.y + q.z * q.z));
+        }
+        return glm::degrees(radians);
+    }
+
+    // Called by Systems::UpdateTransform: changes of this component are reported as e.
+    // A newly bound transform counts as changed so it gets its first world matrix.
+    void BindDirtySet(TransformDirtySet* set, entt::entity e) {
+        dirtySet = set;
+        self = e;
+        dirty = false;
+        MarkDirty();
+    }
+    // The system has taken this entity out of the dirty set
+    void ClearDirty() { dirty = false; }
+
+private:
+    glm::vec3 position{0.0f};
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec3 scale{1.0f};
+    entt::entity parent{entt::null};
+
+    // Euler angles as last set; stale once the quaternion is written directly
+    glm::vec3 rotationEuler{0.0f};
+    bool eulerValid = true;
+
+    // Change tracking; dirty means self is already in dirtySet
+    TransformDirtySet* dirtySet = nullptr;
+    entt::entity self{entt::null};
+    bool dirty = false;
+
+    void MarkDirty() {
+        if (dirty || !dirtySet) return;
+        dirty = true;
+        dirtySet->Add(self);
+    }
+
+    void CopyValues(const Transform& other) {
+        position = other.position;
+        rotation = other.rotation;
+        scale = other.scale;
+        parent = other.parent;
+        rotationEuler = other.rotationEuler;
+        eulerValid = other.eulerValid;
     }
 };
+
+/**
+ * Cached world matrix, maintained by Systems::UpdateTransform
+ * Only entities whose Transform changed, and everything below them, are recomputed.
+ */
+struct WorldTransform {
+    glm::mat4 matrix{1.0f};
+    glm::mat4 local{1.0f};
+
+    // World rotation and its basis, updated with matrix
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec3 forward{0.0f, 0.0f, 1.0f};
+    glm::vec3 right{1.0f, 0.0f, 0.0f};
+    glm::vec3 up{0.0f, 1.0f, 0.0f};
+
+    // Parent the matrix was composed with (the Transform's parent unless that is
+    // missing or part of a cycle)
+    entt::entity cachedParent{entt::null};
+
+    // UpdateTransform pass that last rewrote matrix (0 = never)
+    uint32_t updatedFrame = 0;
+
+    glm::vec3 GetPosition() const { return glm::vec3(matrix[3]); }
+};
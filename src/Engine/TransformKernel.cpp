@@ -0,0 +1,138 @@
+#include "TransformKernel.h"
+#include "TransformKernelSimd.h"
+#include "CpuFeatures.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPROUT_TRANSFORM_KERNEL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SPROUT_TRANSFORM_KERNEL_AVX2 1
+#endif
+
+namespace {
+    void ComposeTRSScalar(const TransformKernel::TRSArrays& in, float* out, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float qx = in.rotationX[i], qy = in.rotationY[i], qz = in.rotationZ[i], qw = in.rotationW[i];
+            const float sx = in.scaleX[i], sy = in.scaleY[i], sz = in.scaleZ[i];
+
+            const float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+            const float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+            const float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+            float* m = out + i * 16;
+            m[0] = (1.0f - 2.0f * (yy + zz)) * sx;
+            m[1] = 2.0f * (xy + wz) * sx;
+            m[2] = 2.0f * (xz - wy) * sx;
+            m[3] = 0.0f;
+
+            m[4] = 2.0f * (xy - wz) * sy;
+            m[5] = (1.0f - 2.0f * (xx + zz)) * sy;
+            m[6] = 2.0f * (yz + wx) * sy;
+            m[7] = 0.0f;
+
+            m[8] = 2.0f * (xz + wy) * sz;
+            m[9] = 2.0f * (yz - wx) * sz;
+            m[10] = (1.0f - 2.0f * (xx + yy)) * sz;
+            m[11] = 0.0f;
+
+            m[12] = in.positionX[i];
+            m[13] = in.positionY[i];
+            m[14] = in.positionZ[i];
+            m[15] = 1.0f;
+        }
+    }
+
+#if SPROUT_TRANSFORM_KERNEL_SSE2
+    struct SSE2Ops {
+        using F = __m128;
+        static constexpr size_t Width = 4;
+
+        static F Load(const float* p) { return _mm_loadu_ps(p); }
+        static F Set(float v) { return _mm_set1_ps(v); }
+        static F Add(F a, F b) { return _mm_add_ps(a, b); }
+        static F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+        static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+
+        // m[] holds one matrix element per register; transpose each column into 4 matrices
+        static void StoreMatrices(const F (&m)[16], float* out) {
+            for (int c = 0; c < 4; ++c) {
+                F r0 = m[c * 4 + 0], r1 = m[c * 4 + 1], r2 = m[c * 4 + 2], r3 = m[c * 4 + 3];
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(out + 0 * 16 + c * 4, r0);
+                _mm_storeu_ps(out + 1 * 16 + c * 4, r1);
+                _mm_storeu_ps(out + 2 * 16 + c * 4, r2);
+                _mm_storeu_ps(out + 3 * 16 + c * 4, r3);
+            }
+        }
+    };
+#endif
+}
+
+namespace TransformKernel {
+    bool IsPathSupported(Path path) {
+        switch (path) {
+            case Path::Scalar:
+                return true;
+            case Path::SSE2:
+#if SPROUT_TRANSFORM_KERNEL_SSE2
+                return CpuFeatures::Get().sse2;
+#else
+                return false;
+#endif
+            case Path::AVX2:
+#if SPROUT_TRANSFORM_KERNEL_AVX2
+                return CpuFeatures::Get().avx2;
+#else
+                return false;
+#endif
+        }
+        return false;
+    }
+
+    Path GetBestPath() {
+        static const Path best = IsPathSupported(Path::AVX2) ? Path::AVX2
+                               : IsPathSupported(Path::SSE2) ? Path::SSE2
+                               : Path::Scalar;
+        return best;
+    }
+
+    const char* GetPathName(Path path) {
+        switch (path) {
+            case Path::Scalar: return "Scalar";
+            case Path::SSE2: return "SSE2";
+            case Path::AVX2: return "AVX2";
+        }
+        return "Unknown";
+    }
+
+    void ComposeTRS(const TRSArrays& in, float* out, size_t count) {
+        ComposeTRS(in, out, count, GetBestPath());
+    }
+
+    void ComposeTRS(const TRSArrays& in, float* out, size_t count, Path path) {
+        if (!IsPathSupported(path)) {
+            path = Path::Scalar;
+        }
+
+        size_t done = 0;
+        switch (path) {
+            case Path::AVX2:
+#if SPROUT_TRANSFORM_KERNEL_AVX2
+                done = ComposeTRSBatchesAVX2(in, out, count);
+#endif
+                break;
+            case Path::SSE2:
+#if SPROUT_TRANSFORM_KERNEL_SSE2
+                done = TransformKernelDetail::ComposeTRSBatches<SSE2Ops>(in, out, count);
+#endif
+                break;
+            case Path::Scalar:
+                break;
+        }
+
+        // Remainder that does not fill a whole vector
+        ComposeTRSScalar(in, out, done, count);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * TransformKernel - batched TRS -> matrix composition over SoA inputs
+ * Builds T * R(q) * S (the same as Transform::GetLocalMatrix) from unit quaternions,
+ * 4 (SSE2) or 8 (AVX2) matrices per iteration, with a scalar fallback. The best path
+ * supported by the CPU is picked at runtime.
+ *
+ * Output matrices are column-major, 16 floats each, laid out back to back
+ * (directly memcpy-able into glm::mat4).
+ */
+namespace TransformKernel {
+    enum class Path {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    // Structure-of-arrays input; rotations are normalized quaternions. All arrays hold at least count values.
+    struct TRSArrays {
+        const float* positionX;
+        const float* positionY;
+        const float* positionZ;
+        const float* rotationX;
+        const float* rotationY;
+        const float* rotationZ;
+        const float* rotationW;
+        const float* scaleX;
+        const float* scaleY;
+        const float* scaleZ;
+    };
+
+    // Writes count matrices (count * 16 floats) to out using the best available path
+    void ComposeTRS(const TRSArrays& in, float* out, size_t count);
+
+    // Forces a specific path; falls back to Scalar if the path is not supported here
+    void ComposeTRS(const TRSArrays& in, float* out, size_t count, Path path);
+
+    Path GetBestPath();
+    bool IsPathSupported(Path path);
+    const char* GetPathName(Path path);
+}
@@ -0,0 +1,47 @@
+// Compiled with AVX2 enabled (see CMakeLists.txt); only called after a runtime CPU check
+#include "TransformKernelSimd.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+
+namespace {
+    struct AVX2Ops {
+        using F = __m256;
+        static constexpr size_t Width = 8;
+
+        static F Load(const float* p) { return _mm256_loadu_ps(p); }
+        static F Set(float v) { return _mm256_set1_ps(v); }
+        static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+        static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+        static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+
+        // Per column: 4x8 transpose within each 128-bit half, low half -> matrices 0-3, high -> 4-7
+        static void StoreMatrices(const F (&m)[16], float* out) {
+            for (int c = 0; c < 4; ++c) {
+                const F t0 = _mm256_unpacklo_ps(m[c * 4 + 0], m[c * 4 + 1]);
+                const F t1 = _mm256_unpackhi_ps(m[c * 4 + 0], m[c * 4 + 1]);
+                const F t2 = _mm256_unpacklo_ps(m[c * 4 + 2], m[c * 4 + 3]);
+                const F t3 = _mm256_unpackhi_ps(m[c * 4 + 2], m[c * 4 + 3]);
+
+                const F lanes[4] = {
+                    _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+                    _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+                    _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+                    _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2))
+                };
+
+                for (int lane = 0; lane < 4; ++lane) {
+                    _mm_storeu_ps(out + lane * 16 + c * 4, _mm256_castps256_ps128(lanes[lane]));
+                    _mm_storeu_ps(out + (lane + 4) * 16 + c * 4, _mm256_extractf128_ps(lanes[lane], 1));
+                }
+            }
+        }
+    };
+}
+
+namespace TransformKernel {
+    size_t ComposeTRSBatchesAVX2(const TRSArrays& in, float* out, size_t count) {
+        return TransformKernelDetail::ComposeTRSBatches<AVX2Ops>(in, out, count);
+    }
+}
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+// Internal to the TransformKernel translation units. Everything here is in an anonymous
+// namespace on purpose: the AVX2 unit is compiled with different target flags, so no
+// inline function may be shared (and deduplicated by the linker) across units.
+#include "TransformKernel.h"
+
+namespace TransformKernel {
+    // Defined in TransformKernelAVX2.cpp (only built for x86); returns how many matrices it wrote
+    size_t ComposeTRSBatchesAVX2(const TRSArrays& in, float* out, size_t count);
+}
+
+namespace {
+    namespace TransformKernelDetail {
+        // Composes V::Width matrices per iteration; returns how many were written
+        template<typename V>
+        inline size_t ComposeTRSBatches(const TransformKernel::TRSArrays& in, float* out, size_t count) {
+            using F = typename V::F;
+
+            const F zero = V::Set(0.0f);
+            const F one = V::Set(1.0f);
+
+            size_t i = 0;
+            for (; i + V::Width <= count; i += V::Width) {
+                const F qx = V::Load(in.rotationX + i);
+                const F qy = V::Load(in.rotationY + i);
+                const F qz = V::Load(in.rotationZ + i);
+                const F qw = V::Load(in.rotationW + i);
+
+                const F sx = V::Load(in.scaleX + i);
+                const F sy = V::Load(in.scaleY + i);
+                const F sz = V::Load(in.scaleZ + i);
+
+                const F x2 = V::Add(qx, qx), y2 = V::Add(qy, qy), z2 = V::Add(qz, qz);
+                const F xx = V::Mul(qx, x2), yy = V::Mul(qy, y2), zz = V::Mul(qz, z2);
+                const F xy = V::Mul(qx, y2), xz = V::Mul(qx, z2), yz = V::Mul(qy, z2);
+                const F wx = V::Mul(qw, x2), wy = V::Mul(qw, y2), wz = V::Mul(qw, z2);
+
+                // Rotation matrix of q, columns scaled by S, translation in column 3
+                F m[16];
+                m[0] = V::Mul(V::Sub(one, V::Add(yy, zz)), sx);
+                m[1] = V::Mul(V::Add(xy, wz), sx);
+                m[2] = V::Mul(V::Sub(xz, wy), sx);
+                m[3] = zero;
+
+                m[4] = V::Mul(V::Sub(xy, wz), sy);
+                m[5] = V::Mul(V::Sub(one, V::Add(xx, zz)), sy);
+                m[6] = V::Mul(V::Add(yz, wx), sy);
+                m[7] = zero;
+
+                m[8] = V::Mul(V::Add(xz, wy), sz);
+                m[9] = V::Mul(V::Sub(yz, wx), sz);
+                m[10] = V::Mul(V::Sub(one, V::Add(xx, yy)), sz);
+                m[11] = zero;
+
+                m[12] = V::Load(in.positionX + i);
+                m[13] = V::Load(in.positionY + i);
+                m[14] = V::Load(in.positionZ + i);
+                m[15] = one;
+
+                V::StoreMatrices(m, out + i * 16);
+            }
+            return i;
+        }
+    }
+}
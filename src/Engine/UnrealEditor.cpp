@@ -1019,8 +1019,8 @@ void UnrealEditor::HandleEntitySelection(entt::registry& registry, ImVec2 mouseP
     for (auto e : view) {
         auto& t = view.get<Transform>(e);
         // AABB centered at position with half-extents 0.5 (cube)
-        glm::vec3 aabbMin = t.position - glm::vec3(0.5f) * t.scale;
-        glm::vec3 aabbMax = t.position + glm::vec3(0.5f) * t.scale;
+        glm::vec3 aabbMin = t.GetPosition() - glm::vec3(0.5f) * t.GetScale();
+        glm::vec3 aabbMax = t.GetPosition() + glm::vec3(0.5f) * t.GetScale();
 
         // Ray-AABB slab method
         float tmin = 0.0f, tmax = FLT_MAX;
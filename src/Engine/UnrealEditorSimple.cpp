@@ -3,6 +3,7 @@
 #include "BlueprintEditor.cpp"
 #include "Renderer.h"
 #include "Scripting.h"
+#include "Systems.h"
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
@@ -13,6 +14,11 @@
 #include <fstream>
 #include <iostream>
 #include <cstring>
+#include <unordered_set>
+#include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 
 UnrealEditor::UnrealEditor() {
 }
@@ -65,6 +71,16 @@ void UnrealEditor::Update(float deltaTime) {
 void UnrealEditor::Render(entt::registry& registry, Renderer& renderer, Scripting& scripting, bool& playMode) {
     // ImGui frame is started in main.cpp - we just draw our UI here
 
+    // Scripts the watchdog stopped since last frame
+    for (const std::string& report : scripting.getWatchdog().TakeReports()) {
+        AddLog(report, "Error");
+    }
+
+    // Shader reloads and compile errors
+    for (const ShaderLibrary::Report& report : renderer.getShaderLibrary().TakeReports()) {
+        AddLog(report.message, report.error ? "Error" : "Info");
+    }
+
     // Draw main menu bar
     DrawMainMenuBar(registry, scripting, playMode);
 
@@ -251,14 +267,20 @@ void UnrealEditor::DrawMainMenuBar(entt::registry& registry, Scripting& scriptin
             }
 
             if (ModernTheme::ModernMenuItem("🔄 Reload All Blueprints")) {
-                // Reload all blueprint components
+                // Point every blueprint entity at its script, then recompile each file once;
+                // reloadScript re-binds all entities running it
                 auto view = registry.view<BlueprintComponent>();
                 int reloadedCount = 0;
+                std::unordered_set<std::string> blueprintPaths;
                 for (auto entity : view) {
                     auto& blueprint = view.get<BlueprintComponent>(entity);
-                    scripting.loadScript(registry, entity, blueprint.filePath);
+                    registry.get_or_emplace<Script>(entity).filePath = blueprint.filePath;
+                    blueprintPaths.insert(FileWatcher::NormalizePath(blueprint.filePath));
                     reloadedCount++;
                 }
+                for (const auto& path : blueprintPaths) {
+                    scripting.reloadScript(registry, path);
+                }
                 AddLog("Reloaded " + std::to_string(reloadedCount) + " blueprints", "Info");
             }
 
@@ -394,6 +416,11 @@ void UnrealEditor::DrawViewport(entt::registry& registry, Renderer& renderer) {
                    selectedEntity != entt::null ?
                    GetEntityName(registry, selectedEntity).c_str() : "None");
 
+        // Render stats for this frame (cubes outside the camera frustum are culled)
+        const Renderer::FrameStats& stats = renderer.getFrameStats();
+        ImGui::Text("Draw calls: %u  Instances: %u  Visible: %u  Culled: %u",
+                    stats.drawCalls, stats.instances, stats.visible, stats.culled);
+
         // Viewport controls info
         ImGui::Text("Controls: WASD + Mouse to navigate, Click to select entities");
 
@@ -430,25 +457,30 @@ void UnrealEditor::DrawViewport(entt::registry& registry, Renderer& renderer) {
                                              viewportCamera.farPlane);
 
             auto& tr = registry.get<Transform>(selectedEntity);
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, tr.position);
-            model = glm::rotate(model, glm::radians(tr.rotationEuler.x), glm::vec3(1,0,0));
-            model = glm::rotate(model, glm::radians(tr.rotationEuler.y), glm::vec3(0,1,0));
-            model = glm::rotate(model, glm::radians(tr.rotationEuler.z), glm::vec3(0,0,1));
-            model = glm::scale(model, tr.scale);
+            glm::mat4 model = Systems::GetWorldMatrix(registry, selectedEntity);
 
             float matrix[16];
             memcpy(matrix, glm::value_ptr(model), sizeof(float)*16);
             if (ImGuizmo::Manipulate(glm::value_ptr(view), glm::value_ptr(proj),
                                      currentGizmoOperation, ImGuizmo::WORLD, matrix)) {
-                glm::vec3 translation, rotation, scale;
-                ImGuizmo::DecomposeMatrixToComponents(matrix,
-                    glm::value_ptr(translation),
-                    glm::value_ptr(rotation),
-                    glm::value_ptr(scale));
-                tr.position = translation;
-                tr.rotationEuler = rotation;
-                tr.scale = scale;
+                // The gizmo works in world space; Transform is relative to the parent
+                glm::mat4 local = glm::make_mat4(matrix);
+                if (tr.GetParent() != entt::null && registry.valid(tr.GetParent())) {
+                    local = glm::inverse(Systems::GetWorldMatrix(registry, tr.GetParent())) * local;
+                }
+
+                // Decompose straight to a quaternion so rotation never goes through Euler angles
+                glm::vec3 scale(glm::length(glm::vec3(local[0])),
+                                glm::length(glm::vec3(local[1])),
+                                glm::length(glm::vec3(local[2])));
+                if (scale.x > 0.0f && scale.y > 0.0f && scale.z > 0.0f) {
+                    glm::mat3 rotation(glm::vec3(local[0]) / scale.x,
+                                       glm::vec3(local[1]) / scale.y,
+                                       glm::vec3(local[2]) / scale.z);
+                    tr.SetPosition(glm::vec3(local[3]));
+                    tr.SetRotation(glm::quat_cast(rotation));
+                    tr.SetScale(scale);
+                }
             }
         }
 
@@ -649,9 +681,18 @@ void UnrealEditor::DrawInspector(entt::registry& registry, Scripting& scripting)
             // Transform Component
             if (auto* transform = registry.try_get<Transform>(selectedEntity)) {
                 if (ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen)) {
-                    ImGui::DragFloat3("Position", &transform->position.x, 0.1f);
-                    ImGui::DragFloat3("Rotation", &transform->rotationEuler.x, 1.0f);
-                    ImGui::DragFloat3("Scale", &transform->scale.x, 0.1f);
+                    glm::vec3 position = transform->GetPosition();
+                    if (ImGui::DragFloat3("Position", &position.x, 0.1f)) {
+                        transform->SetPosition(position);
+                    }
+                    glm::vec3 euler = transform->GetRotationEuler();
+                    if (ImGui::DragFloat3("Rotation", &euler.x, 1.0f)) {
+                        transform->SetRotationEuler(euler);
+                    }
+                    glm::vec3 scale = transform->GetScale();
+                    if (ImGui::DragFloat3("Scale", &scale.x, 0.1f)) {
+                        transform->SetScale(scale);
+                    }
                 }
             }
 
@@ -688,7 +729,8 @@ void UnrealEditor::DrawInspector(entt::registry& registry, Scripting& scripting)
                     }
 
                     if (ImGui::Button("Reload Script")) {
-                        scripting.loadScript(registry, selectedEntity, script->filePath);
+                        // Recompiles once for every entity running this file
+                        scripting.reloadScript(registry, script->filePath);
                         AddLog("Reloaded script: " + script->filePath, "Info");
                     }
 
@@ -991,7 +1033,7 @@ void UnrealEditor::DuplicateEntity(entt::registry& registry, entt::entity entity
         registry.emplace<Transform>(newEntity, *transform);
         // Offset position slightly
         auto& newTransform = registry.get<Transform>(newEntity);
-        newTransform.position.x += 1.0f;
+        newTransform.SetPosition(newTransform.GetPosition() + glm::vec3(1.0f, 0.0f, 0.0f));
     }
 
     // Copy other components
@@ -1031,6 +1073,19 @@ void UnrealEditor::ExecuteCommand(const std::string& command, entt::registry& re
         AddLog("  entities - List all entities", "Info");
         AddLog("  info - Show engine information", "Info");
         AddLog("  create <type> - Create entity (cube, hud)", "Info");
+        AddLog("  profile on|off|reset - Script profiler", "Info");
+        AddLog("  profile scripts - Time and Lua allocations per script", "Info");
+        AddLog("  profile sample on [instructions]|off - Sample Lua functions", "Info");
+        AddLog("  profile functions - Most expensive sampled functions", "Info");
+        AddLog("  profile trace start|stop [file] - Chrome trace (default script_trace.json)", "Info");
+        AddLog("  profile cache - Script bytecode cache hits and compile time", "Info");
+        AddLog("  gc [reset] - Lua GC pause histogram and frame times", "Info");
+        AddLog("  gc budget <ms> | mode auto|inc|gen | full - Lua GC scheduling", "Info");
+        AddLog("  parallel [threads|off] - Tick Parallel = true scripts on several Lua states", "Info");
+        AddLog("  watchdog [on|off] - Script budgets and disabled scripts", "Info");
+        AddLog("  watchdog default|budget <script> <ms> [instructions] - Set a call budget", "Info");
+        AddLog("  watchdog enable <script> - Re-enable a disabled script", "Info");
+        AddLog("  spawn <count> <script> - Create scripted entities (for load tests)", "Info");
     } else if (command == "clear") {
         console.logs.clear();
     } else if (command == "entities") {
@@ -1061,12 +1116,239 @@ void UnrealEditor::ExecuteCommand(const std::string& command, entt::registry& re
             AddLog("Unknown entity type: " + type, "Warning");
             AddLog("Available types: cube, hud", "Info");
         }
+    } else if (command == "profile" || command.substr(0, 8) == "profile ") {
+        ExecuteProfileCommand(command.size() > 8 ? command.substr(8) : "", scripting);
+    } else if (command == "parallel" || command.substr(0, 9) == "parallel ") {
+        std::string option = command.size() > 9 ? command.substr(9) : "";
+        if (option == "off") {
+            scripting.setParallelThreads(0);
+        } else if (!option.empty()) {
+            int threads = std::atoi(option.c_str());
+            if (threads > 0) scripting.setParallelThreads(static_cast<unsigned>(threads));
+            else AddLog("Usage: parallel [threads|off]", "Warning");
+        }
+        unsigned threads = scripting.getParallelThreads();
+        AddLog(threads ? "Parallel scripts on " + std::to_string(threads) + " Lua states" : "Parallel scripts off", "Info");
+    } else if (command.substr(0, 6) == "spawn ") {
+        std::istringstream in(command.substr(6));
+        int count = 0;
+        std::string path;
+        in >> count >> path;
+        if (count <= 0 || path.empty()) {
+            AddLog("Usage: spawn <count> <script>", "Warning");
+        } else {
+            int loaded = 0;
+            for (int i = 0; i < count; ++i) {
+                entt::entity entity = CreateEntity(registry, "Spawned " + std::to_string(i));
+                registry.emplace<Script>(entity);
+                if (scripting.loadScript(registry, entity, path)) ++loaded;
+            }
+            AddLog("Spawned " + std::to_string(count) + " entities running " + path +
+                   " (" + std::to_string(loaded) + " loaded)", loaded == count ? "Info" : "Warning");
+        }
+    } else if (command == "watchdog" || command.substr(0, 9) == "watchdog ") {
+        ExecuteWatchdogCommand(command.size() > 9 ? command.substr(9) : "", scripting);
+    } else if (command == "gc" || command.substr(0, 3) == "gc ") {
+        ExecuteGcCommand(command.size() > 3 ? command.substr(3) : "", scripting);
     } else {
         AddLog("Unknown command: " + command, "Warning");
         AddLog("Type 'help' for available commands", "Info");
     }
 }
 
+void UnrealEditor::ExecuteProfileCommand(const std::string& args, Scripting& scripting) {
+    ScriptProfiler& profiler = scripting.getProfiler();
+    std::istringstream in(args);
+    std::string action, option;
+    in >> action >> option;
+
+    char line[256];
+    if (action == "on" || action == "off") {
+        profiler.SetEnabled(action == "on");
+        AddLog(std::string("Script profiler ") + (profiler.IsEnabled() ? "enabled" : "disabled"), "Info");
+    } else if (action == "reset") {
+        profiler.Reset();
+        AddLog("Script profiler counters reset", "Info");
+    } else if (action == "scripts" || action.empty()) {
+        if (!profiler.IsEnabled()) AddLog("Profiler is off ('profile on' to start)", "Warning");
+
+        std::vector<const ScriptProfiler::ScriptStats*> sorted;
+        for (const auto& stats : profiler.GetScriptStats()) sorted.push_back(&stats);
+        std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) {
+            return a->GetTotalSeconds() > b->GetTotalSeconds();
+        });
+
+        const double frames = static_cast<double>(std::max<uint64_t>(1, profiler.GetFrameCount()));
+        AddLog("Scripts over " + std::to_string(profiler.GetFrameCount()) + " frames, Lua heap " +
+               std::to_string(profiler.GetLiveBytes() / 1024) + " KB:", "Info");
+        for (const auto* stats : sorted) {
+            const auto& tick = stats->callbacks[static_cast<size_t>(ScriptProfiler::Callback::OnTick)];
+            const auto& batch = stats->callbacks[static_cast<size_t>(ScriptProfiler::Callback::OnTickBatch)];
+            const uint64_t tickCalls = tick.calls + batch.calls;
+            const double tickSeconds = tick.totalSeconds + batch.totalSeconds;
+            std::snprintf(line, sizeof(line), "  %-40s %8.3f ms/frame  %8llu ticks  %7.2f us/tick  max %7.2f us  %8.1f KB alloc (%llu)",
+                          stats->path.c_str(), stats->GetTotalSeconds() * 1000.0 / frames,
+                          static_cast<unsigned long long>(tickCalls),
+                          tickCalls ? tickSeconds * 1e6 / static_cast<double>(tickCalls) : 0.0,
+                          std::max(tick.maxSeconds, batch.maxSeconds) * 1e6,
+                          static_cast<double>(stats->allocatedBytes) / 1024.0,
+                          static_cast<unsigned long long>(stats->allocationCount));
+            AddLog(line, "Info");
+        }
+    } else if (action == "sample") {
+        int interval = 1000;
+        in >> interval;
+        if (option == "on" && !profiler.IsEnabled()) profiler.SetEnabled(true);
+        profiler.SetSampling(option == "on", interval);
+        AddLog(profiler.IsSampling() ? "Sampling every " + std::to_string(interval) + " Lua instructions" : "Sampling off", "Info");
+    } else if (action == "functions") {
+        auto functions = profiler.GetFunctionStats();
+        if (functions.empty()) AddLog("No samples ('profile sample on' first)", "Warning");
+        for (size_t i = 0; i < functions.size() && i < 20; ++i) {
+            std::snprintf(line, sizeof(line), "  %-48s %8.3f ms  %8llu samples", functions[i].name.c_str(),
+                          functions[i].seconds * 1000.0, static_cast<unsigned long long>(functions[i].samples));
+            AddLog(line, "Info");
+        }
+    } else if (action == "cache") {
+        const ScriptBytecodeCache& cache = scripting.getBytecodeCache();
+        const ScriptBytecodeCache::Stats& stats = cache.GetStats();
+        std::snprintf(line, sizeof(line), "Bytecode cache (%s): %zu chunks, %llu compiled (%.2f ms), %llu from disk (%.2f ms), %llu memory hits",
+                      cache.GetDirectory().empty() ? "memory only" : cache.GetDirectory().c_str(), cache.GetEntryCount(),
+                      static_cast<unsigned long long>(stats.compiles), stats.compileSeconds * 1000.0,
+                      static_cast<unsigned long long>(stats.diskHits), stats.diskSeconds * 1000.0,
+                      static_cast<unsigned long long>(stats.memoryHits));
+        AddLog(line, "Info");
+    } else if (action == "trace") {
+        std::string file;
+        in >> file;
+        if (file.empty()) file = "script_trace.json";
+        if (option == "start") {
+            if (!profiler.IsEnabled()) profiler.SetEnabled(true);
+            profiler.StartTrace();
+            AddLog("Script trace started", "Info");
+        } else if (option == "stop") {
+            profiler.StopTrace();
+            if (profiler.WriteChromeTrace(file)) {
+                AddLog("Wrote " + std::to_string(profiler.GetTraceEventCount()) + " events to " + file, "Info");
+            } else {
+                AddLog("Failed to write " + file, "Error");
+            }
+        } else {
+            AddLog("Usage: profile trace start|stop [file]", "Warning");
+        }
+    } else {
+        AddLog("Unknown profile command: " + action, "Warning");
+    }
+}
+
+void UnrealEditor::ExecuteWatchdogCommand(const std::string& args, Scripting& scripting) {
+    ScriptWatchdog& watchdog = scripting.getWatchdog();
+    std::istringstream in(args);
+    std::string action;
+    in >> action;
+
+    char line[256];
+    if (action == "on" || action == "off") {
+        watchdog.SetEnabled(action == "on");
+        AddLog(std::string("Script watchdog ") + (watchdog.IsEnabled() ? "enabled" : "disabled"), "Info");
+    } else if (action == "default" || action == "budget") {
+        std::string path;
+        if (action == "budget") in >> path;
+        double milliseconds = -1.0;
+        unsigned long long instructions = 0;
+        in >> milliseconds >> instructions;
+        if (milliseconds < 0.0 || (action == "budget" && path.empty())) {
+            AddLog("Usage: watchdog default <ms> [instructions] | watchdog budget <script> <ms> [instructions]", "Warning");
+            return;
+        }
+
+        ScriptWatchdog::Budget budget{milliseconds, instructions};
+        if (action == "default") watchdog.SetDefaultBudget(budget);
+        else watchdog.SetBudget(scripting.getScriptId(path), budget);
+        std::snprintf(line, sizeof(line), "Budget for %s: %.2f ms, %llu instructions (0 = unlimited)",
+                      action == "default" ? "all scripts" : path.c_str(), milliseconds, instructions);
+        AddLog(line, "Info");
+    } else if (action == "enable") {
+        std::string path;
+        in >> path;
+        watchdog.EnableScript(scripting.getScriptId(path));
+        AddLog("Re-enabled " + path, "Info");
+    } else if (action.empty()) {
+        const ScriptWatchdog::Budget& budget = watchdog.GetDefaultBudget();
+        std::snprintf(line, sizeof(line), "Script watchdog %s, default budget %.2f ms / %llu instructions",
+                      watchdog.IsEnabled() ? "on" : "off", budget.maxMilliseconds,
+                      static_cast<unsigned long long>(budget.maxInstructions));
+        AddLog(line, "Info");
+
+        const auto& scripts = scripting.getProfiler().GetScriptStats();
+        const auto& states = watchdog.GetScriptStates();
+        for (size_t id = 0; id < states.size() && id < scripts.size(); ++id) {
+            const ScriptWatchdog::ScriptState& state = states[id];
+            if (!state.hasBudget && !state.disabled && state.violations == 0) continue;
+            std::snprintf(line, sizeof(line), "  %-40s %s  budget %.2f ms / %llu  violations %llu", scripts[id].path.c_str(),
+                          state.disabled ? "DISABLED" : "ok      ", watchdog.GetBudget(static_cast<uint32_t>(id)).maxMilliseconds,
+                          static_cast<unsigned long long>(watchdog.GetBudget(static_cast<uint32_t>(id)).maxInstructions),
+                          static_cast<unsigned long long>(state.violations));
+            AddLog(line, state.disabled ? "Warning" : "Info");
+        }
+    } else {
+        AddLog("Unknown watchdog command: " + action, "Warning");
+    }
+}
+
+void UnrealEditor::ExecuteGcCommand(const std::string& args, Scripting& scripting) {
+    LuaGcScheduler& gc = scripting.getGcScheduler();
+    std::istringstream in(args);
+    std::string action, option;
+    in >> action >> option;
+
+    char line[256];
+    if (action == "budget") {
+        if (!option.empty()) gc.SetBudgetMs(std::atof(option.c_str()));
+        std::snprintf(line, sizeof(line), "Lua GC budget %.2f ms/frame", gc.GetBudgetMs());
+        AddLog(line, "Info");
+    } else if (action == "mode") {
+        if (option == "auto") gc.SetMode(LuaGcScheduler::Mode::Automatic);
+        else if (option == "inc") gc.SetMode(LuaGcScheduler::Mode::Incremental);
+        else if (option == "gen") gc.SetMode(LuaGcScheduler::Mode::Generational);
+        else if (!option.empty()) AddLog("Usage: gc mode auto|inc|gen", "Warning");
+        AddLog(std::string("Lua GC mode: ") + LuaGcScheduler::GetModeName(gc.GetMode()), "Info");
+    } else if (action == "full") {
+        gc.FullCollect();
+        AddLog("Lua heap after full collect: " + std::to_string(gc.GetHeapKB()) + " KB", "Info");
+    } else if (action == "reset") {
+        gc.ResetStats();
+        AddLog("Lua GC stats reset", "Info");
+    } else if (action.empty() || action == "stats") {
+        const LuaGcScheduler::Stats& stats = gc.GetStats();
+        std::snprintf(line, sizeof(line), "Lua GC %s, budget %.2f ms, heap %zu KB", LuaGcScheduler::GetModeName(gc.GetMode()),
+                      gc.GetBudgetMs(), gc.GetHeapKB());
+        AddLog(line, "Info");
+        std::snprintf(line, sizeof(line), "  %llu frames  %llu steps  %llu cycles  %llu emergencies  %.3f ms/frame  max pause %.1f us",
+                      static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.steps),
+                      static_cast<unsigned long long>(stats.cycles), static_cast<unsigned long long>(stats.emergencies),
+                      stats.frames ? stats.totalSeconds * 1000.0 / static_cast<double>(stats.frames) : 0.0,
+                      stats.maxPauseSeconds * 1e6);
+        AddLog(line, "Info");
+        std::snprintf(line, sizeof(line), "  frame time p50 %.2f ms  p99 %.2f ms  max %.2f ms",
+                      gc.GetFrameTimePercentile(0.5) * 1000.0, gc.GetFrameTimePercentile(0.99) * 1000.0,
+                      gc.GetFrameTimePercentile(1.0) * 1000.0);
+        AddLog(line, "Info");
+        for (size_t bucket = 0; bucket < LuaGcScheduler::PauseBucketCount; ++bucket) {
+            if (bucket + 1 < LuaGcScheduler::PauseBucketCount) {
+                std::snprintf(line, sizeof(line), "  < %6.0f us  %llu", LuaGcScheduler::GetPauseBucketLimitMicros(bucket),
+                              static_cast<unsigned long long>(stats.pauseHistogram[bucket]));
+            } else {
+                std::snprintf(line, sizeof(line), "  >=%6.0f us  %llu", LuaGcScheduler::GetPauseBucketLimitMicros(bucket - 1),
+                              static_cast<unsigned long long>(stats.pauseHistogram[bucket]));
+            }
+            AddLog(line, "Info");
+        }
+    } else {
+        AddLog("Unknown gc command: " + action, "Warning");
+    }
+}
+
 void UnrealEditor::RefreshContentBrowser() {
     contentBrowser.directories.clear();
     contentBrowser.files.clear();
@@ -1113,11 +1395,14 @@ void UnrealEditor::HandleEntitySelection(entt::registry& registry, ImVec2 mouseP
     float bestT = FLT_MAX;
     entt::entity best = entt::null;
 
-    auto view = registry.view<Transform, MeshCube>();
+    auto view = registry.view<WorldTransform, MeshCube>();
     for (auto e : view) {
-        auto& t = view.get<Transform>(e);
-        glm::vec3 aabbMin = t.position - glm::vec3(0.5f) * t.scale;
-        glm::vec3 aabbMax = t.position + glm::vec3(0.5f) * t.scale;
+        // World-space AABB of the unit cube under the cached world matrix
+        const glm::mat4& M = view.get<WorldTransform>(e).matrix;
+        glm::vec3 center = glm::vec3(M[3]);
+        glm::vec3 extents = 0.5f * (glm::abs(glm::vec3(M[0])) + glm::abs(glm::vec3(M[1])) + glm::abs(glm::vec3(M[2])));
+        glm::vec3 aabbMin = center - extents;
+        glm::vec3 aabbMax = center + extents;
 
         float tmin = 0.0f, tmax = FLT_MAX;
         for (int i = 0; i < 3; ++i) {
@@ -130,6 +130,9 @@ private:
     // Console functionality
     void AddLog(const std::string& message, const std::string& level = "Info");
     void ExecuteCommand(const std::string& command, entt::registry& registry, Scripting& scripting);
+    void ExecuteProfileCommand(const std::string& args, Scripting& scripting);
+    void ExecuteGcCommand(const std::string& args, Scripting& scripting);
+    void ExecuteWatchdogCommand(const std::string& args, Scripting& scripting);
 
     // Utility functions
     std::string GetEntityName(entt::registry& registry, entt::entity entity);
@@ -3,12 +3,15 @@
 #include <algorithm>
 #include <iostream>
 
-World::World(const std::string& name) : worldName(name) {
+World::World(const std::string& name)
+    : worldName(name), jobSystem(&JobSystem::Shared()) {
     // Initialize the world
 }
 
 World::~World() {
     EndPlay();
+    // Drop all subscriptions up front so destroying actors does not unsubscribe one by one
+    eventBus.Clear();
     actors.clear();
     actorMap.clear();
 }
@@ -16,8 +19,24 @@ World::~World() {
 void World::DestroyActor(Actor* actor) {
     if (!actor) return;
 
-    actor->MarkForDestroy();
-    pendingDestroyActors.push_back(actor);
+    {
+        std::lock_guard<std::mutex> lock(pendingDestroyMutex);
+        if (actor->IsPendingDestroy()) return;
+        actor->MarkForDestroy();
+        pendingDestroyActors.push_back(actor);
+    }
+
+    // Inside a parallel tick group the buckets (and other actors' components) are in use
+    // by other workers; Tick unregisters the actor once the group is done
+    if (tickRegistry.IsInParallelPhase()) return;
+
+    tickRegistry.UnregisterActor(actor);
+    UnregisterComponentTicks(actor);
+}
+
+void World::SetWorkerThreadCount(unsigned workerCount) {
+    ownedJobSystem = std::make_unique<JobSystem>(workerCount);
+    jobSystem = ownedJobSystem.get();
 }
 
 void World::DestroyActor(ActorID actorId) {
@@ -32,32 +51,40 @@ Actor* World::FindActor(ActorID actorId) const {
     return (it != actorMap.end()) ? it->second : nullptr;
 }
 
-Actor* World::FindActorByName(const std::string& name) const {
-    for (const auto& actor : actors) {
-        if (actor->GetName() == name) {
-            return actor.get();
-        }
+Actor* World::ResolveActor(ActorHandle handle) const {
+    if (handle.index >= actorSlots.size()) return nullptr;
+
+    const ActorSlot& slot = actorSlots[handle.index];
+    if (slot.generation != handle.generation || slot.denseIndex == ActorHandle::InvalidIndex) {
+        return nullptr;
     }
-    return nullptr;
+    return actors[slot.denseIndex].get();
+}
+
+bool World::IsHandleValid(ActorHandle handle) const {
+    return ResolveActor(handle) != nullptr;
+}
+
+Actor* World::FindActorByName(const std::string& name) const {
+    auto it = actorNameIndex.find(name);
+    return (it != actorNameIndex.end()) ? it->second : nullptr;
 }
 
 void World::Tick(float deltaTime) {
-    // Tick all actors
-    for (const auto& actor : actors) {
-        if (!actor->IsPendingDestroy()) {
-            actor->Tick(deltaTime);
+    // Events posted since the last frame
+    eventBus.Flush();
 
-            // Tick components
-            for (const auto& [typeIndex, component] : actor->components) {
-                if (component->IsTickEnabled()) {
-                    component->TickComponent(deltaTime);
-                }
-            }
-        }
+    // Tick groups run in order; each one ticks its actors, then its components type by type.
+    // Events posted by a group are delivered before the next group starts.
+    for (size_t group = 0; group < NumTickGroups; ++group) {
+        tickRegistry.RunTickGroup(static_cast<ETickGroup>(group), deltaTime, jobSystem);
+        UnregisterDestroyedTicks();
+        eventBus.Flush();
     }
 
     // Clean up destroyed actors
     CleanupDestroyedActors();
+    eventBus.Flush();
 }
 
 void World::BeginPlay() {
@@ -65,16 +92,11 @@ void World::BeginPlay() {
 
     hasBegunPlay = true;
 
-    // Begin play for all existing actors
-    for (const auto& actor : actors) {
+    // Begin play for all existing actors (BeginPlay may spawn more)
+    for (size_t i = 0; i < actors.size(); ++i) {
+        Actor* actor = actors[i].get();
         if (!actor->hasBegunPlay) {
-            actor->BeginPlay();
-            actor->hasBegunPlay = true;
-
-            // Begin play for components
-            for (const auto& [typeIndex, component] : actor->components) {
-                component->BeginPlay();
-            }
+            BeginPlayForActor(actor);
         }
     }
 }
@@ -85,13 +107,7 @@ void World::EndPlay() {
     // End play for all actors
     for (const auto& actor : actors) {
         if (actor->hasBegunPlay) {
-            // End play for components first
-            for (const auto& [typeIndex, component] : actor->components) {
-                component->EndPlay();
-            }
-
-            actor->EndPlay();
-            actor->hasBegunPlay = false;
+            EndPlayForActor(actor.get());
         }
     }
 
@@ -122,22 +138,16 @@ bool World::LoadWorld(const std::string& filePath) {
 void World::CleanupDestroyedActors() {
     if (pendingDestroyActors.empty()) return;
 
-    for (Actor* actor : pendingDestroyActors) {
+    // Destroyed() may queue more actors; indexed loop picks them up in the same pass
+    for (size_t i = 0; i < pendingDestroyActors.size(); ++i) {
+        Actor* actor = pendingDestroyActors[i];
+
         // Call destroyed event
         actor->Destroyed();
 
         // Remove from maps and vectors
-        UnregisterActor(actor->GetActorID());
-
-        // Remove from actors vector
-        auto it = std::find_if(actors.begin(), actors.end(),
-            [actor](const std::unique_ptr<Actor>& ptr) {
-                return ptr.get() == actor;
-            });
-
-        if (it != actors.end()) {
-            actors.erase(it);
-        }
+        UnregisterActor(actor);
+        RemoveActorStorage(actor);
     }
 
     pendingDestroyActors.clear();
@@ -147,10 +157,142 @@ void World::RegisterActor(std::unique_ptr<Actor> actor) {
     ActorID id = actor->GetActorID();
     Actor* ptr = actor.get();
 
+    uint32_t slotIndex;
+    if (!freeActorSlots.empty()) {
+        slotIndex = freeActorSlots.back();
+        freeActorSlots.pop_back();
+    } else {
+        slotIndex = static_cast<uint32_t>(actorSlots.size());
+        actorSlots.push_back(ActorSlot{ActorHandle::InvalidIndex, 0});
+    }
+
+    ActorSlot& slot = actorSlots[slotIndex];
+    slot.denseIndex = static_cast<uint32_t>(actors.size());
+    ptr->handle = ActorHandle{slotIndex, slot.generation};
+
     actorMap[id] = ptr;
+    actorNameIndex.emplace(ptr->GetName(), ptr);
     actors.push_back(std::move(actor));
 }
 
-void World::UnregisterActor(ActorID actorId) {
-    actorMap.erase(actorId);
+void World::UnregisterActor(Actor* actor) {
+    actorMap.erase(actor->GetActorID());
+
+    auto range = actorNameIndex.equal_range(actor->GetName());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == actor) {
+            actorNameIndex.erase(it);
+            break;
+        }
+    }
+
+    RemoveFromClassBuckets(actor);
+}
+
+void World::AddToClassBucket(Actor* actor, const std::string& className) {
+    std::vector<Actor*>& bucket = actorClassIndex[className];
+    actor->classBuckets[actor->classBucketCount++] = {&bucket, static_cast<uint32_t>(bucket.size())};
+    bucket.push_back(actor);
+}
+
+void World::RemoveFromClassBuckets(Actor* actor) {
+    for (uint32_t i = 0; i < actor->classBucketCount; ++i) {
+        const Actor::ClassBucketEntry& entry = actor->classBuckets[i];
+        std::vector<Actor*>& bucket = *entry.bucket;
+
+        // Swap-and-pop, then point the moved actor's entry at its new slot
+        Actor* last = bucket.back();
+        bucket[entry.slot] = last;
+        bucket.pop_back();
+        if (last != actor) {
+            for (uint32_t j = 0; j < last->classBucketCount; ++j) {
+                if (last->classBuckets[j].bucket == entry.bucket) {
+                    last->classBuckets[j].slot = entry.slot;
+                    break;
+                }
+            }
+        }
+    }
+    actor->classBucketCount = 0;
+}
+
+void World::OnActorRenamed(Actor* actor, const std::string& oldName) {
+    // Only actors already registered with this world are indexed
+    auto range = actorNameIndex.equal_range(oldName);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == actor) {
+            actorNameIndex.erase(it);
+            actorNameIndex.emplace(actor->GetName(), actor);
+            return;
+        }
+    }
+}
+
+void World::RemoveActorStorage(Actor* actor) {
+    ActorSlot& slot = actorSlots[actor->handle.index];
+    uint32_t denseIndex = slot.denseIndex;
+
+    // Swap-and-pop; keep the owning pointer alive until the storage is consistent
+    std::unique_ptr<Actor> removed = std::move(actors[denseIndex]);
+    if (denseIndex + 1 != actors.size()) {
+        actors[denseIndex] = std::move(actors.back());
+        actorSlots[actors[denseIndex]->handle.index].denseIndex = denseIndex;
+    }
+    actors.pop_back();
+
+    // Invalidate outstanding handles and recycle the slot
+    slot.denseIndex = ActorHandle::InvalidIndex;
+    ++slot.generation;
+    freeActorSlots.push_back(actor->handle.index);
+}
+
+void World::BeginPlayForActor(Actor* actor) {
+    actor->BeginPlay();
+    actor->hasBegunPlay = true;
+
+    // Begin play for components, then let them tick
+    for (ActorComponent* component : actor->components) {
+        component->BeginPlay();
+    }
+
+    if (!actor->IsPendingDestroy()) {
+        tickRegistry.RegisterActor(actor);
+        RegisterComponentTicks(actor);
+    }
+}
+
+void World::EndPlayForActor(Actor* actor) {
+    // Stop ticking before EndPlay so nothing ticks after it has ended
+    tickRegistry.UnregisterActor(actor);
+    UnregisterComponentTicks(actor);
+
+    // End play for components first
+    for (ActorComponent* component : actor->components) {
+        component->EndPlay();
+    }
+
+    actor->EndPlay();
+    actor->hasBegunPlay = false;
+}
+
+void World::UnregisterDestroyedTicks() {
+    // Actors destroyed from parallel ticks were only marked; both calls are no-ops for the rest
+    for (Actor* actor : pendingDestroyActors) {
+        tickRegistry.UnregisterActor(actor);
+        UnregisterComponentTicks(actor);
+    }
+}
+
+void World::RegisterComponentTicks(Actor* actor) {
+    for (ActorComponent* component : actor->components) {
+        if (component->IsTickEnabled()) {
+            tickRegistry.Register(component, component->componentTypeId);
+        }
+    }
+}
+
+void World::UnregisterComponentTicks(Actor* actor) {
+    for (ActorComponent* component : actor->components) {
+        tickRegistry.Unregister(component);
+    }
 }
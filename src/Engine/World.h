@@ -6,10 +6,47 @@
 #include <string>
 #include <functional>
 #include <typeindex>
+#include <mutex>
+#include "TickRegistry.h"
+#include "JobSystem.h"
+#include "EventBus.h"
+#include "ObjectPool.h"
 
 class Actor;
+class ActorComponent;
+struct ActorHandle;
 using ActorID = uint64_t;
 
+/**
+ * Non-allocating view over one of the World's per-class actor buckets
+ * Invalidated when an actor of that class is spawned or cleaned up
+ */
+template<typename ActorType>
+class ActorClassView {
+public:
+    class Iterator {
+    public:
+        explicit Iterator(Actor* const* it) : it(it) {}
+        ActorType* operator*() const { return static_cast<ActorType*>(*it); }
+        Iterator& operator++() { ++it; return *this; }
+        bool operator==(const Iterator& other) const { return it == other.it; }
+        bool operator!=(const Iterator& other) const { return it != other.it; }
+    private:
+        Actor* const* it;
+    };
+
+    explicit ActorClassView(const std::vector<Actor*>& bucket) : bucket(&bucket) {}
+
+    Iterator begin() const { return Iterator(bucket->data()); }
+    Iterator end() const { return Iterator(bucket->data() + bucket->size()); }
+    size_t size() const { return bucket->size(); }
+    bool empty() const { return bucket->empty(); }
+    ActorType* operator[](size_t index) const { return static_cast<ActorType*>((*bucket)[index]); }
+
+private:
+    const std::vector<Actor*>* bucket;
+};
+
 /**
  * World class - manages the game world, actors, and global systems
  * Similar to Unreal's UWorld
@@ -23,19 +60,34 @@ public:
     const std::string& GetName() const { return worldName; }
     void SetName(const std::string& name) { worldName = name; }
 
-    // Actor management
+    // Actor management. SpawnActor is game-thread only. DestroyActor may be called from
+    // parallel ticks: there it only marks the actor, and its ticks stop at the end of the group.
     template<typename ActorType = Actor, typename... Args>
     ActorType* SpawnActor(const std::string& name = "", Args&&... args);
 
     void DestroyActor(Actor* actor);
     void DestroyActor(ActorID actorId);
 
+    // Reserves pool slots and index capacity so the next count spawns of ActorType do not
+    // allocate. Components created by the actor are warmed separately (PrewarmComponents).
+    template<typename ActorType>
+    void PrewarmActors(size_t count);
+
+    template<typename ComponentType>
+    static void PrewarmComponents(size_t count);
+
     Actor* FindActor(ActorID actorId) const;
     Actor* FindActorByName(const std::string& name) const;
 
+    // Returns null for stale handles (destroyed actor or reused slot)
+    Actor* ResolveActor(ActorHandle handle) const;
+    bool IsHandleValid(ActorHandle handle) const;
+
+    // All actors of ActorType, including subclasses (e.g. Pawn also yields Characters)
     template<typename ActorType>
-    std::vector<ActorType*> FindActorsOfClass() const;
+    ActorClassView<ActorType> FindActorsOfClass() const;
 
+    // Dense storage; order is not stable across destroys (swap-and-pop)
     const std::vector<std::unique_ptr<Actor>>& GetAllActors() const { return actors; }
 
     // ECS Registry access
@@ -47,17 +99,31 @@ public:
     void BeginPlay();
     void EndPlay();
 
+    TickRegistry& GetTickRegistry() { return tickRegistry; }
+
+    // Pool for parallel tick groups; JobSystem::Shared() unless the world was given its own.
+    // SetWorkerThreadCount starts a private pool (0 ticks everything on the calling thread).
+    JobSystem& GetJobSystem() { return *jobSystem; }
+    void SetWorkerThreadCount(unsigned workerCount);
+
     // Level streaming (for future implementation)
     void LoadSubLevel(const std::string& levelPath);
     void UnloadSubLevel(const std::string& levelPath);
 
-    // Event system
+    // Event system. BroadcastEvent queues the event (safe from parallel ticks); queued events
+    // are delivered before the first tick group, after each group and after cleanup.
     template<typename EventType>
     void BroadcastEvent(const EventType& event);
 
+    // Delivers to every subscriber before returning (game-thread only)
+    template<typename EventType>
+    void BroadcastEventImmediate(const EventType& event);
+
     template<typename EventType>
     void RegisterGlobalEventHandler(std::function<void(const EventType&)> handler);
 
+    EventBus& GetEventBus() { return eventBus; }
+
     // Serialization
     void SaveWorld(const std::string& filePath) const;
     bool LoadWorld(const std::string& filePath);
@@ -70,73 +136,163 @@ private:
     std::string worldName;
     entt::registry registry;
     std::vector<std::unique_ptr<Actor>> actors;
-    std::unordered_map<ActorID, Actor*> actorMap;
+    std::unordered_map<ActorID, Actor*, std::hash<ActorID>, std::equal_to<ActorID>,
+                       PoolAllocator<std::pair<const ActorID, Actor*>>> actorMap;
+
+    // Lookup indexes, maintained on spawn, rename and cleanup (nodes come from the pools)
+    std::unordered_multimap<std::string, Actor*, std::hash<std::string>, std::equal_to<std::string>,
+                            PoolAllocator<std::pair<const std::string, Actor*>>> actorNameIndex;
+    std::unordered_map<std::string, std::vector<Actor*>> actorClassIndex;
+
+    // Handle slots: slot -> dense index in actors, bumped generation on free
+    struct ActorSlot {
+        uint32_t denseIndex;
+        uint32_t generation;
+    };
+    std::vector<ActorSlot> actorSlots;
+    std::vector<uint32_t> freeActorSlots;
+    TickRegistry tickRegistry;
+    JobSystem* jobSystem;
+    std::unique_ptr<JobSystem> ownedJobSystem;
 
-    // Global event handlers
-    std::unordered_map<std::type_index, std::vector<std::function<void(const void*)>>> globalEventHandlers;
+    // Global handlers are subscribed with the world as owner, actor bindings with the actor
+    EventBus eventBus;
 
     // State
     bool hasBegunPlay = false;
     std::vector<Actor*> pendingDestroyActors;
+    std::mutex pendingDestroyMutex;
 
     // Internal helpers
     void RegisterActor(std::unique_ptr<Actor> actor);
-    void UnregisterActor(ActorID actorId);
+    void UnregisterActor(Actor* actor);
+    void RemoveActorStorage(Actor* actor);
+
+    template<typename ActorType>
+    void RegisterActorClassChain(Actor* actor);
+    template<typename ActorType>
+    void ReserveActorClassChain(size_t count);
+    template<typename ActorType>
+    static constexpr size_t GetActorClassDepth();
+    void AddToClassBucket(Actor* actor, const std::string& className);
+    void RemoveFromClassBuckets(Actor* actor);
+    void OnActorRenamed(Actor* actor, const std::string& oldName);
+
+    friend class Actor;
+    void BeginPlayForActor(Actor* actor);
+    void EndPlayForActor(Actor* actor);
+    void RegisterComponentTicks(Actor* actor);
+    void UnregisterComponentTicks(Actor* actor);
+    void UnregisterDestroyedTicks();
 };
 
 // Template implementations
 template<typename ActorType, typename... Args>
 ActorType* World::SpawnActor(const std::string& name, Args&&... args) {
     static_assert(std::is_base_of_v<Actor, ActorType>, "ActorType must derive from Actor");
+    static_assert(GetActorClassDepth<ActorType>() <= ActorType::MaxClassDepth, "Actor class chain is deeper than Actor::MaxClassDepth");
 
     std::string actorName = name.empty() ? ActorType::StaticClass() : name;
-    auto actor = std::make_unique<ActorType>(this, actorName, std::forward<Args>(args)...);
+    std::unique_ptr<ActorType> actor(ObjectPools::New<ActorType>(this, actorName, std::forward<Args>(args)...));
     ActorType* ptr = actor.get();
+    ptr->sourcePool = &ObjectPools::GetPool<ActorType>();
 
     RegisterActor(std::move(actor));
+    RegisterActorClassChain<ActorType>(ptr);
 
     // If world has already begun play, begin play for this actor
     if (hasBegunPlay) {
-        ptr->BeginPlay();
+        BeginPlayForActor(ptr);
     }
 
     return ptr;
 }
 
 template<typename ActorType>
-std::vector<ActorType*> World::FindActorsOfClass() const {
+void World::PrewarmActors(size_t count) {
     static_assert(std::is_base_of_v<Actor, ActorType>, "ActorType must derive from Actor");
 
-    std::vector<ActorType*> result;
-    for (const auto& actor : actors) {
-        if (auto* typedActor = dynamic_cast<ActorType*>(actor.get())) {
-            result.push_back(typedActor);
-        }
+    ObjectPools::GetPool<ActorType>().Reserve(count);
+
+    const size_t total = actors.size() + count;
+    actors.reserve(total);
+    actorSlots.reserve(total);
+    freeActorSlots.reserve(total);
+    pendingDestroyActors.reserve(total);
+    actorMap.reserve(total);
+    actorNameIndex.reserve(total);
+    ReserveActorClassChain<ActorType>(count);
+}
+
+template<typename ComponentType>
+void World::PrewarmComponents(size_t count) {
+    static_assert(std::is_base_of_v<ActorComponent, ComponentType>, "ComponentType must derive from ActorComponent");
+    ObjectPools::GetPool<ComponentType>().Reserve(count);
+}
+
+// Buckets are keyed by StaticClass() and read back with a static_cast, so a subclass that
+// inherited its parent's StaticClass()/Super would hand out parents as the subclass
+template<typename ActorType>
+constexpr bool DeclaresOwnActorClass() {
+    return std::is_same_v<typename ActorType::ThisClass, ActorType>;
+}
+
+template<typename ActorType>
+void World::ReserveActorClassChain(size_t count) {
+    static_assert(DeclaresOwnActorClass<ActorType>(), "ActorType must declare its own ThisClass, Super and StaticClass()");
+    std::vector<Actor*>& bucket = actorClassIndex[ActorType::StaticClass()];
+    bucket.reserve(bucket.size() + count);
+
+    if constexpr (!std::is_same_v<ActorType, Actor>) {
+        ReserveActorClassChain<typename ActorType::Super>(count);
     }
-    return result;
 }
 
-template<typename EventType>
-void World::BroadcastEvent(const EventType& event) {
-    // Send to global handlers
-    std::type_index typeIndex(typeid(EventType));
-    auto it = globalEventHandlers.find(typeIndex);
-    if (it != globalEventHandlers.end()) {
-        for (auto& handler : it->second) {
-            handler(&event);
-        }
+template<typename ActorType>
+constexpr size_t World::GetActorClassDepth() {
+    if constexpr (std::is_same_v<ActorType, Actor>) {
+        return 1;
+    } else {
+        return 1 + GetActorClassDepth<typename ActorType::Super>();
     }
+}
 
-    // Send to all actors
-    for (const auto& actor : actors) {
-        actor->TriggerEvent(event);
+template<typename ActorType>
+ActorClassView<ActorType> World::FindActorsOfClass() const {
+    static_assert(std::is_base_of_v<Actor, ActorType>, "ActorType must derive from Actor");
+    static_assert(DeclaresOwnActorClass<ActorType>(), "ActorType must declare its own ThisClass, Super and StaticClass()");
+
+    static const std::string className = ActorType::StaticClass();
+    static const std::vector<Actor*> emptyBucket;
+
+    auto it = actorClassIndex.find(className);
+    return ActorClassView<ActorType>(it != actorClassIndex.end() ? it->second : emptyBucket);
+}
+
+template<typename ActorType>
+void World::RegisterActorClassChain(Actor* actor) {
+    static_assert(DeclaresOwnActorClass<ActorType>(), "ActorType must declare its own ThisClass, Super and StaticClass()");
+    AddToClassBucket(actor, ActorType::StaticClass());
+
+    if constexpr (!std::is_same_v<ActorType, Actor>) {
+        using SuperType = typename ActorType::Super;
+        static_assert(std::is_base_of_v<SuperType, ActorType> && !std::is_same_v<SuperType, ActorType>,
+                      "ActorType::Super must name the direct parent class");
+        RegisterActorClassChain<SuperType>(actor);
     }
 }
 
+template<typename EventType>
+void World::BroadcastEvent(const EventType& event) {
+    eventBus.Post(event);
+}
+
+template<typename EventType>
+void World::BroadcastEventImmediate(const EventType& event) {
+    eventBus.Dispatch(event);
+}
+
 template<typename EventType>
 void World::RegisterGlobalEventHandler(std::function<void(const EventType&)> handler) {
-    std::type_index typeIndex(typeid(EventType));
-    globalEventHandlers[typeIndex].push_back([handler](const void* eventPtr) {
-        handler(*static_cast<const EventType*>(eventPtr));
-    });
+    eventBus.Subscribe<EventType>(this, std::move(handler));
 }
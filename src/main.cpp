@@ -1,4 +1,7 @@
 #include "Engine/Renderer.h"
+#include "Engine/RenderQueue.h"
+#include "Engine/FrustumCulling.h"
+#include "Engine/JobSystem.h"
 #include "Engine/Scene.h"
 #include "Engine/Components.h"
 #include "Engine/Systems.h"
@@ -19,18 +22,25 @@
 #include <iostream>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv){
+    // Benchmark mode: --bench-cubes N [--bench-frames F] [--bench-immediate]
+    // Spawns N cubes, runs F frames without vsync and prints draw calls and frame times.
+    // --bench-immediate draws with one drawCube call per entity for comparison.
+    int benchCubes = 0;
+    int benchFrames = 300;
+    bool benchImmediate = false;
+    for(int i = 1; i < argc; ++i){
+        if(!std::strcmp(argv[i], "--bench-cubes") && i + 1 < argc) benchCubes = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--bench-frames") && i + 1 < argc) benchFrames = std::max(1, std::atoi(argv[++i]));
+        else if(!std::strcmp(argv[i], "--bench-immediate")) benchImmediate = true;
+    }
 
-static glm::mat4 ComposeTRS(const Transform& t){
-    glm::mat4 M(1.0f);
-    M = glm::translate(M, t.position);
-    M = glm::rotate(M, glm::radians(t.rotationEuler.x), glm::vec3(1,0,0));
-    M = glm::rotate(M, glm::radians(t.rotationEuler.y), glm::vec3(0,1,0));
-    M = glm::rotate(M, glm::radians(t.rotationEuler.z), glm::vec3(0,0,1));
-    M = glm::scale(M, t.scale);
-    return M;
-}
-
-int main(){
     if(!glfwInit()){ std::cerr<<"Failed to init GLFW\n"; return -1; }
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -73,7 +83,7 @@ int main(){
     }
 
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1);
+    glfwSwapInterval(benchCubes > 0 ? 0 : 1);
 
     Renderer renderer;
     if(!renderer.init(window)){ std::cerr<<"Renderer init failed\n"; return -1; }
@@ -101,25 +111,37 @@ int main(){
     auto cube2 = scene.createEntity("DemoCube2");
     scene.registry.emplace<MeshCube>(cube2);
     auto& transform2 = scene.registry.get<Transform>(cube2);
-    transform2.position = {3, 0, 0};
+    transform2.SetPosition({3, 0, 0});
 
     auto cube3 = scene.createEntity("RotatingCube");
     scene.registry.emplace<MeshCube>(cube3);
     auto& transform3 = scene.registry.get<Transform>(cube3);
-    transform3.position = {-3, 0, 0};
+    transform3.SetPosition({-3, 0, 0});
 
     // Create a HUD entity
     auto hudE = scene.createEntity("HUD");
     scene.registry.emplace<HUDComponent>(hudE, HUDComponent{85.0f, 60.0f, 420, "SproutEngine HUD"});
 
+    // Benchmark cubes on a square grid behind the demo cubes
+    const int benchSide = std::max(1, (int)std::ceil(std::sqrt((double)benchCubes)));
+    for(int i = 0; i < benchCubes; ++i){
+        auto e = scene.createEntity("BenchCube" + std::to_string(i));
+        scene.registry.emplace<MeshCube>(e);
+        auto& t = scene.registry.get<Transform>(e);
+        t.SetPosition({(i % benchSide - benchSide * 0.5f) * 1.5f, -2.0f, -(float)(i / benchSide) * 1.5f});
+        t.SetScale({0.5f, 0.5f, 0.5f});
+    }
+
     auto& tr = scene.registry.get<Transform>(cube);
-    tr.position = {0, 0, 0};
-    tr.scale = {1,1,1};
+    tr.SetPosition({0, 0, 0});
+    tr.SetScale({1,1,1});
 
     // Scripting
     Scripting scripting;
     scripting.init();
     scripting.attach(scene.registry);
+    // collectGarbage runs every frame below, so GC cycles can be paced in the leftover time
+    scripting.getGcScheduler().SetMode(LuaGcScheduler::Mode::Incremental);
     // Optional: attach script immediately
     scene.registry.emplace<Script>(cube3, Script{std::string("assets/scripts/Rotate.lua"), 0.0, false});
     scripting.loadScript(scene.registry, cube3, "assets/scripts/Rotate.lua");
@@ -157,6 +179,19 @@ int main(){
 
     bool playMode = true;
     auto last = std::chrono::high_resolution_clock::now();
+    RenderQueue renderQueue;
+    GLRenderBackend glBackend(renderer);
+    // Culling scratch, reused every frame; large scenes are culled in chunks on the shared pool
+    JobSystem& cullJobs = JobSystem::Shared();
+    FrustumCulling::BoxList cullBoxes;
+    std::vector<entt::entity> cullEntities;
+    std::vector<uint32_t> cullVisible;
+    int benchFrame = 0;
+    double benchSeconds = 0.0, benchWorst = 0.0;
+
+    // Frame time the Lua GC fits into (vsync is on, so the monitor's refresh period)
+    const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    const double targetFrameSeconds = 1.0 / (videoMode && videoMode->refreshRate > 0 ? videoMode->refreshRate : 60);
 
     while(!glfwWindowShouldClose(window)){
         glfwPollEvents();
@@ -175,13 +210,15 @@ int main(){
 
             if(playMode){
                 scripting.update(scene.registry, dt);
-                Systems::UpdateTransform(scene.registry, dt);
 
                 // Manually rotate one cube to show animation
                 auto& rotatingTransform = scene.registry.get<Transform>(cube3);
-                rotatingTransform.rotationEuler.y += 45.0f * dt; // 45 degrees per second
+                rotatingTransform.Rotate(glm::angleAxis(glm::radians(45.0f * dt), glm::vec3(0,1,0))); // 45 degrees per second
             }
 
+            // Runs in edit mode too so gizmo/inspector edits show up; only changed subtrees are rebuilt
+            Systems::UpdateTransform(scene.registry, dt);
+
             // Update editor
             unrealEditor.Update(dt);
 
@@ -190,19 +227,38 @@ int main(){
             glm::mat4 V = glm::lookAt(camPos, glm::vec3(0,0,0), glm::vec3(0,1,0));
             glm::mat4 P = glm::perspective(glm::radians(60.0f), width > 0 ? (float)width/height : 16.0f/9.0f, 0.1f, 100.0f);
 
-            // Draw cubes
-            auto view = scene.registry.view<Transform, MeshCube>();
+            // Cull cube bounds against the camera frustum; only visible cubes are drawn
+            glm::mat4 PV = P * V;
+            auto view = scene.registry.view<WorldTransform, MeshCube>();
+            cullBoxes.Clear();
+            cullEntities.clear();
             for(auto e : view){
-                auto& t = view.get<Transform>(e);
-                glm::mat4 M = ComposeTRS(t);
-                glm::mat4 MVP = P * V * M;
+                cullBoxes.AddTransformed(view.get<WorldTransform>(e).matrix, glm::vec3(0.0f), glm::vec3(0.5f));
+                cullEntities.push_back(e);
+            }
+            cullVisible.resize(cullEntities.size());
+            const FrustumCulling::Frustum frustum = FrustumCulling::ExtractFrustum(PV);
+            const size_t visibleCount = FrustumCulling::CullParallel(cullJobs, frustum, cullBoxes.GetArrays(),
+                                                                     cullBoxes.Size(), cullVisible.data());
+            renderer.addCullStats((uint32_t)visibleCount, (uint32_t)(cullEntities.size() - visibleCount));
+
+            // Draw cubes: recorded as packets, sorted, then one instanced draw per batch
+            renderQueue.Clear();
+            RenderCommandList& drawList = renderQueue.GetThreadList(cullJobs);
+            for(size_t i = 0; i < visibleCount; ++i){
+                auto e = cullEntities[cullVisible[i]];
+                const auto& world = view.get<WorldTransform>(e);
                 // If this entity is the selected one in the editor, tint it
                 glm::vec3 tint(1.0f, 1.0f, 1.0f);
                 if (unrealEditor.GetSelectedEntity() == e) {
                     tint = glm::vec3(1.0f, 0.6f, 0.2f); // orange highlight
                 }
-                renderer.drawCube(MVP, tint);
+                if (benchImmediate) { renderer.drawCube(PV * world.matrix, tint); continue; }
+                float depth = glm::length(glm::vec3(world.matrix[3]) - camPos) / 100.0f;
+                drawList.Draw(SortKey::MakeOpaque(Renderer::MaterialBasic, Renderer::MeshCube, depth),
+                              Renderer::MeshCube, Renderer::MaterialBasic, InstanceData{world.matrix, glm::vec4(tint, 1.0f)});
             }
+            renderQueue.Submit(glBackend, PV);
 
             // ---- Unreal-like Editor Interface ----
             // Start the Dear ImGui frame
@@ -218,7 +274,31 @@ int main(){
             // ---- end ImGui ----
 
             renderer.endFrame();
+
+            // Lua GC gets what is left of the frame, before waiting on the swap
+            double frameSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - now).count();
+            scripting.collectGarbage(frameSeconds, targetFrameSeconds);
+
             glfwSwapBuffers(window);
+
+            if(benchCubes > 0){
+                // Skip the first frames (shader compiles, buffer growth)
+                if(benchFrame++ >= 10){
+                    benchSeconds += dt;
+                    benchWorst = std::max(benchWorst, (double)dt);
+                }
+                if(benchFrame == benchFrames + 10){
+                    const auto& stats = renderer.getFrameStats();
+                    std::cout << "bench: " << benchCubes << " cubes, "
+                              << (benchImmediate ? "immediate" : renderer.usesPersistentMapping() ? "instanced (persistent)" : "instanced (orphaned)")
+                              << ", " << renderQueue.GetFrame().stats.packets << " packets"
+                              << ", " << stats.visible << " visible / " << stats.culled << " culled"
+                              << ", " << stats.drawCalls << " draw calls, " << stats.instances << " instances, avg "
+                              << benchSeconds * 1000.0 / benchFrames << " ms, worst " << benchWorst * 1000.0
+                              << " ms over " << benchFrames << " frames" << std::endl;
+                    glfwSetWindowShouldClose(window, GLFW_TRUE);
+                }
+            }
         }
     }
 
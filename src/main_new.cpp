@@ -17,13 +17,7 @@
 #include <chrono>
 
 static glm::mat4 ComposeTRS(const Transform& t){
-    glm::mat4 M(1.0f);
-    M = glm::translate(M, t.position);
-    M = glm::rotate(M, glm::radians(t.rotationEuler.x), glm::vec3(1,0,0));
-    M = glm::rotate(M, glm::radians(t.rotationEuler.y), glm::vec3(0,1,0));
-    M = glm::rotate(M, glm::radians(t.rotationEuler.z), glm::vec3(0,0,1));
-    M = glm::scale(M, t.scale);
-    return M;
+    return t.GetLocalMatrix();
 }
 
 void SetupExampleBlueprints() {
@@ -116,7 +110,7 @@ int main(){
     auto legacyCube = scene.createEntity("LegacyCube");
     scene.registry.emplace<MeshCube>(legacyCube);
     auto& legacyTransform = scene.registry.get<Transform>(legacyCube);
-    legacyTransform.position = {0, 0, -3};
+    legacyTransform.SetPosition({0, 0, -3});
 
     // Create a HUD entity (legacy system)
     auto hudE = scene.createEntity("HUD");
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "Engine/GameplayActors.h"
+#include "Engine/World.h"
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Inherits Pawn's ThisClass/Super/StaticClass(): World refuses to index or query it
+class UndeclaredPawn : public Pawn {
+public:
+    using Pawn::Pawn;
+};
+
+static_assert(DeclaresOwnActorClass<Character>());
+static_assert(!DeclaresOwnActorClass<UndeclaredPawn>());
+
+// The index's answer against a dynamic_cast over every live actor
+template<typename ActorType>
+void ExpectClassViewMatches(const World& world) {
+    std::set<Actor*> expected;
+    for (const auto& actor : world.GetAllActors()) {
+        if (dynamic_cast<ActorType*>(actor.get())) expected.insert(actor.get());
+    }
+    std::set<Actor*> indexed;
+    for (ActorType* actor : world.FindActorsOfClass<ActorType>()) {
+        ASSERT_NE(dynamic_cast<ActorType*>(static_cast<Actor*>(actor)), nullptr) << ActorType::StaticClass();
+        indexed.insert(actor);
+    }
+    EXPECT_EQ(indexed, expected) << ActorType::StaticClass();
+    EXPECT_EQ(world.FindActorsOfClass<ActorType>().size(), expected.size()) << "duplicates in " << ActorType::StaticClass();
+}
+
+void ExpectIndexesMatch(const World& world) {
+    ExpectClassViewMatches<Actor>(world);
+    ExpectClassViewMatches<Pawn>(world);
+    ExpectClassViewMatches<Character>(world);
+    ExpectClassViewMatches<Controller>(world);
+    for (const auto& actor : world.GetAllActors()) {
+        Actor* found = world.FindActorByName(actor->GetName());
+        ASSERT_NE(found, nullptr) << actor->GetName();
+        EXPECT_EQ(found->GetName(), actor->GetName());
+    }
+}
+
+} // namespace
+
+TEST(ActorClassIndex, PawnQueryIncludesCharacters) {
+    World world("Classes");
+    std::vector<Pawn*> pawns;
+    for (int i = 0; i < 3; ++i) pawns.push_back(world.SpawnActor<Pawn>("Pawn" + std::to_string(i)));
+    for (int i = 0; i < 2; ++i) pawns.push_back(world.SpawnActor<Character>("Character" + std::to_string(i)));
+    world.SpawnActor<Controller>("Controller");
+
+    EXPECT_EQ(world.FindActorsOfClass<Pawn>().size(), 5u);
+    EXPECT_EQ(world.FindActorsOfClass<Character>().size(), 2u);
+    EXPECT_EQ(world.FindActorsOfClass<Controller>().size(), 1u);
+    EXPECT_EQ(world.FindActorsOfClass<PlayerController>().size(), 0u);
+    EXPECT_EQ(world.FindActorsOfClass<Actor>().size(), 6u);
+
+    // Every Character is also in the Pawn view, and only Characters are in theirs
+    for (Pawn* pawn : pawns) {
+        bool found = false;
+        for (Pawn* indexed : world.FindActorsOfClass<Pawn>()) found = found || indexed == pawn;
+        EXPECT_TRUE(found) << pawn->GetName();
+    }
+    ExpectIndexesMatch(world);
+}
+
+TEST(ActorClassIndex, IndexesFollowSpawnRenameAndDestroy) {
+    World world("Upkeep");
+    std::mt19937 rng(3);
+    std::vector<Actor*> live;
+    int nextName = 0;
+
+    for (int op = 0; op < 3000; ++op) {
+        const uint32_t roll = rng() % 10;
+        if (roll < 4 || live.empty()) {
+            const std::string name = "A" + std::to_string(nextName++);
+            switch (rng() % 4) {
+                case 0: live.push_back(world.SpawnActor<Pawn>(name)); break;
+                case 1: live.push_back(world.SpawnActor<Character>(name)); break;
+                case 2: live.push_back(world.SpawnActor<PlayerController>(name)); break;
+                default: live.push_back(world.SpawnActor<Actor>(name)); break;
+            }
+        } else if (roll < 7) {
+            Actor* actor = live[rng() % live.size()];
+            const std::string oldName = actor->GetName();
+            actor->SetName("R" + std::to_string(nextName++));
+            EXPECT_EQ(world.FindActorByName(actor->GetName()), actor);
+            EXPECT_EQ(world.FindActorByName(oldName), nullptr);
+        } else {
+            const size_t index = rng() % live.size();
+            world.DestroyActor(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+            // Cleaned up at varying points, so some cleanups remove several actors at once
+            if (rng() % 3 == 0) world.CleanupDestroyedActors();
+        }
+
+        if (op % 100 == 0) {
+            world.CleanupDestroyedActors();
+            ASSERT_EQ(world.GetActorCount(), live.size());
+            ExpectIndexesMatch(world);
+            if (HasFailure()) FAIL() << "op " << op;
+        }
+    }
+
+    world.CleanupDestroyedActors();
+    ExpectIndexesMatch(world);
+    for (Actor* actor : live) world.DestroyActor(actor);
+    world.CleanupDestroyedActors();
+    EXPECT_TRUE(world.FindActorsOfClass<Actor>().empty());
+    EXPECT_TRUE(world.FindActorsOfClass<Character>().empty());
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "Engine/Actor.h"
+#include "Engine/ComponentStorage.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+
+namespace {
+
+int g_liveComponents = 0;
+
+class CountedComponent : public ActorComponent {
+public:
+    CountedComponent() : ActorComponent(nullptr) { ++g_liveComponents; }
+    ~CountedComponent() override { --g_liveComponents; }
+};
+
+std::unique_ptr<ActorComponent> Make() { return std::make_unique<CountedComponent>(); }
+
+// Every id in 1..maxId resolves as in the model, and iteration visits exactly its values
+void ExpectMatches(const ComponentStorage& storage, const std::map<ComponentTypeId, ActorComponent*>& model,
+                   ComponentTypeId maxId) {
+    ASSERT_EQ(storage.Size(), model.size());
+    for (ComponentTypeId id = 1; id <= maxId; ++id) {
+        auto it = model.find(id);
+        ASSERT_EQ(storage.Find(id), it != model.end() ? it->second : nullptr) << "id " << id;
+    }
+    std::set<ActorComponent*> iterated(storage.begin(), storage.end());
+    std::set<ActorComponent*> expected;
+    for (const auto& [id, component] : model) expected.insert(component);
+    ASSERT_EQ(iterated, expected);
+}
+
+} // namespace
+
+TEST(ComponentStorage, RandomOpsMatchAMap) {
+    constexpr ComponentTypeId maxId = 24;
+    std::mt19937 rng(10);
+    {
+        ComponentStorage storage;
+        std::map<ComponentTypeId, ActorComponent*> model;
+
+        for (int op = 0; op < 20000; ++op) {
+            const ComponentTypeId id = 1 + rng() % maxId;
+            // Drift the size up and down so it keeps crossing InlineCapacity
+            const bool grow = (op / 500) % 2 == 0;
+            if (rng() % 3 != 0 ? grow : !grow) {
+                std::unique_ptr<ActorComponent> component = Make();
+                ActorComponent* raw = component.get();
+                std::unique_ptr<ActorComponent> previous = storage.Set(id, std::move(component));
+                auto it = model.find(id);
+                ASSERT_EQ(previous.get(), it != model.end() ? it->second : nullptr) << "op " << op;
+                model[id] = raw;
+            } else {
+                std::unique_ptr<ActorComponent> removed = storage.Remove(id);
+                auto it = model.find(id);
+                ASSERT_EQ(removed.get(), it != model.end() ? it->second : nullptr) << "op " << op;
+                if (it != model.end()) model.erase(it);
+            }
+            ExpectMatches(storage, model, maxId);
+            if (HasFatalFailure()) FAIL() << "op " << op;
+        }
+        EXPECT_EQ(g_liveComponents, static_cast<int>(model.size()));
+    }
+    EXPECT_EQ(g_liveComponents, 0);
+}
+
+TEST(ComponentStorage, AddAndRemoveAcrossTheInlineBoundary) {
+    ComponentStorage storage;
+    std::map<ComponentTypeId, ActorComponent*> model;
+    // Descending ids, so the sorted fallback has to reorder them
+    for (ComponentTypeId id = ComponentStorage::InlineCapacity + 1; id >= 1; --id) {
+        model[id] = Make().release();
+        storage.Set(id, std::unique_ptr<ActorComponent>(model[id]));
+        ExpectMatches(storage, model, 20);
+    }
+    ASSERT_EQ(storage.Size(), ComponentStorage::InlineCapacity + 1);
+
+    // Back to exactly InlineCapacity (inline search again), then over and under once more
+    storage.Remove(5);
+    model.erase(5);
+    ExpectMatches(storage, model, 20);
+    model[17] = Make().release();
+    storage.Set(17, std::unique_ptr<ActorComponent>(model[17]));
+    ExpectMatches(storage, model, 20);
+    for (ComponentTypeId id : {1u, 2u, 17u}) {
+        storage.Remove(id);
+        model.erase(id);
+        ExpectMatches(storage, model, 20);
+    }
+
+    // Removing what is not there changes nothing
+    EXPECT_EQ(storage.Remove(19), nullptr);
+    EXPECT_EQ(storage.Remove(InvalidComponentTypeId), nullptr);
+    ExpectMatches(storage, model, 20);
+
+    storage.Clear();
+    EXPECT_TRUE(storage.Empty());
+    EXPECT_EQ(g_liveComponents, 0);
+}
+
+TEST(ComponentStorage, DuplicateIdReplacesInBothModes) {
+    ComponentStorage storage;
+    for (size_t total : {size_t(3), ComponentStorage::InlineCapacity * 2}) {
+        storage.Clear();
+        for (ComponentTypeId id = 1; id <= total; ++id) storage.Set(id, Make());
+
+        std::unique_ptr<ActorComponent> replacement = Make();
+        ActorComponent* raw = replacement.get();
+        ActorComponent* before = storage.Find(2);
+        std::unique_ptr<ActorComponent> previous = storage.Set(2, std::move(replacement));
+        EXPECT_EQ(previous.get(), before);
+        EXPECT_EQ(storage.Find(2), raw);
+        EXPECT_EQ(storage.Size(), total);
+    }
+
+    // The invalid id stores nothing and hands the component back
+    std::unique_ptr<ActorComponent> rejected = storage.Set(InvalidComponentTypeId, Make());
+    EXPECT_NE(rejected, nullptr);
+    EXPECT_EQ(storage.Find(InvalidComponentTypeId), nullptr);
+}
@@ -0,0 +1,373 @@
+#include <gtest/gtest.h>
+#include "Engine/Actor.h"
+#include "Engine/EventBus.h"
+#include "Engine/FrameArena.h"
+#include "Engine/World.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct PingEvent {
+    int value;
+};
+
+struct PongEvent {
+    int value;
+};
+
+// Non-trivial payload: the bus must copy it in and destroy it exactly once
+struct NamedEvent {
+    static inline int live = 0;
+    std::string name;
+
+    explicit NamedEvent(std::string name) : name(std::move(name)) { ++live; }
+    NamedEvent(const NamedEvent& other) : name(other.name) { ++live; }
+    ~NamedEvent() { --live; }
+};
+
+// Opaque subscription owners
+int g_ownerA, g_ownerB, g_ownerC;
+
+// Posts the event again from its own handler, forever
+struct LoopEvent {
+    int generation;
+};
+
+class PingActor : public Actor {
+public:
+    using ThisClass = PingActor;
+    using Super = Actor;
+    PingActor(World* world, const std::string& name) : Actor(world, name) {}
+    static std::string StaticClass() { return "PingActor"; }
+};
+
+// Posts a PingEvent from the PrePhysics group; the PostPhysics listener records whether it arrived
+class PostingActor : public Actor {
+public:
+    using ThisClass = PostingActor;
+    using Super = Actor;
+    PostingActor(World* world, const std::string& name) : Actor(world, name) {}
+    static std::string StaticClass() { return "PostingActor"; }
+    void Tick(float) override { GetWorld()->BroadcastEvent(PingEvent{7}); }
+};
+
+class ListeningActor : public Actor {
+public:
+    using ThisClass = ListeningActor;
+    using Super = Actor;
+    ListeningActor(World* world, const std::string& name) : Actor(world, name) {
+        SetTickGroup(ETickGroup::PostPhysics);
+        BindEvent<PingEvent>([this](const PingEvent&) { ++received; });
+    }
+    static std::string StaticClass() { return "ListeningActor"; }
+    void Tick(float) override { receivedBeforeTick = received; }
+
+    int received = 0;
+    int receivedBeforeTick = -1;
+};
+
+} // namespace
+
+TEST(EventBus, PostIsDeliveredInPostOrderOnFlush) {
+    EventBus bus;
+    std::vector<int> log;
+    bus.Subscribe<PingEvent>(&g_ownerA, [&](const PingEvent& e) { log.push_back(e.value); });
+    bus.Subscribe<PongEvent>(&g_ownerA, [&](const PongEvent& e) { log.push_back(-e.value); });
+
+    bus.Post(PingEvent{1});
+    bus.Post(PongEvent{2});
+    bus.Post(PingEvent{3});
+    EXPECT_TRUE(log.empty());
+    EXPECT_EQ(bus.GetQueuedCount(), 3u);
+
+    bus.Flush();
+    EXPECT_EQ(log, (std::vector<int>{1, -2, 3}));
+    EXPECT_EQ(bus.GetQueuedCount(), 0u);
+}
+
+TEST(EventBus, PostWithoutSubscribersIsDropped) {
+    EventBus bus;
+    bus.Post(PingEvent{1});
+    EXPECT_EQ(bus.GetQueuedCount(), 0u);
+}
+
+TEST(EventBus, PostingDuringFlushIsDeliveredInTheSameFlush) {
+    EventBus bus;
+    std::vector<int> log;
+    bus.Subscribe<PingEvent>(&g_ownerA, [&](const PingEvent& e) {
+        log.push_back(e.value);
+        bus.Post(PongEvent{e.value * 10});
+    });
+    bus.Subscribe<PongEvent>(&g_ownerA, [&](const PongEvent& e) { log.push_back(e.value); });
+
+    bus.Post(PingEvent{1});
+    bus.Post(PingEvent{2});
+    bus.Flush();
+
+    // The second pass picks up both pongs, after both pings
+    EXPECT_EQ(log, (std::vector<int>{1, 2, 10, 20}));
+    EXPECT_EQ(bus.GetQueuedCount(), 0u);
+}
+
+TEST(EventBus, PostingDuringImmediateDispatchWaitsForFlush) {
+    EventBus bus;
+    std::vector<int> log;
+    bus.Subscribe<PingEvent>(&g_ownerA, [&](const PingEvent& e) {
+        log.push_back(e.value);
+        bus.Post(PongEvent{e.value + 1});
+    });
+    bus.Subscribe<PongEvent>(&g_ownerA, [&](const PongEvent& e) { log.push_back(e.value); });
+
+    bus.Dispatch(PingEvent{1});
+    EXPECT_EQ(log, (std::vector<int>{1}));
+    EXPECT_EQ(bus.GetQueuedCount(), 1u);
+
+    bus.Flush();
+    EXPECT_EQ(log, (std::vector<int>{1, 2}));
+}
+
+TEST(EventBus, UnsubscribingDuringDispatchStopsDeliveryAtOnce) {
+    EventBus bus;
+    std::vector<std::string> log;
+    bus.Subscribe<PingEvent>(&g_ownerA, [&](const PingEvent&) {
+        log.push_back("A");
+        bus.UnsubscribeAll(&g_ownerB);
+        bus.UnsubscribeAll(&g_ownerA);
+    });
+    bus.Subscribe<PingEvent>(&g_ownerB, [&](const PingEvent&) { log.push_back("B"); });
+    bus.Subscribe<PingEvent>(&g_ownerC, [&](const PingEvent&) { log.push_back("C"); });
+    bus.Subscribe<PongEvent>(&g_ownerB, [&](const PongEvent&) { log.push_back("B.Pong"); });
+
+    // B sits after A in the channel but must not run once A has dropped it
+    bus.Post(PingEvent{1});
+    bus.Flush();
+    EXPECT_EQ(log, (std::vector<std::string>{"A", "C"}));
+    EXPECT_EQ(bus.GetSubscriberCount<PingEvent>(), 1u);
+    EXPECT_EQ(bus.GetSubscriberCount<PongEvent>(), 0u);
+
+    log.clear();
+    bus.Dispatch(PingEvent{2});
+    bus.Dispatch(PongEvent{2});
+    EXPECT_EQ(log, (std::vector<std::string>{"C"}));
+}
+
+TEST(EventBus, SubscribingDuringDispatchTakesEffectAfterIt) {
+    EventBus bus;
+    int lateCalls = 0;
+    bus.Subscribe<PingEvent>(&g_ownerA, [&](const PingEvent&) {
+        bus.Subscribe<PingEvent>(&g_ownerB, [&](const PingEvent&) { ++lateCalls; });
+    });
+
+    bus.Dispatch(PingEvent{1});
+    EXPECT_EQ(lateCalls, 0);
+    EXPECT_EQ(bus.GetSubscriberCount<PingEvent>(), 2u);
+
+    // A subscribes B again every dispatch; B's first handler sees this one
+    bus.Dispatch(PingEvent{2});
+    EXPECT_EQ(lateCalls, 1);
+}
+
+TEST(EventBus, UnsubscribeDropsSubscriptionsDeferredInTheSameDispatch) {
+    EventBus bus;
+    int calls = 0;
+    bus.Subscribe<PingEvent>(&g_ownerA, [&](const PingEvent&) {
+        bus.Subscribe<PongEvent>(&g_ownerB, [&](const PongEvent&) { ++calls; });
+        bus.UnsubscribeAll(&g_ownerB);
+    });
+
+    bus.Dispatch(PingEvent{1});
+    EXPECT_EQ(bus.GetSubscriberCount<PongEvent>(), 0u);
+    bus.Dispatch(PongEvent{1});
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(EventBus, UnsubscribeKeepsOtherOwnersSlots) {
+    EventBus bus;
+    std::vector<std::string> log;
+    for (int i = 0; i < 3; ++i) {
+        bus.Subscribe<PingEvent>(&g_ownerA, [&](const PingEvent&) { log.push_back("A"); });
+        bus.Subscribe<PingEvent>(&g_ownerB, [&](const PingEvent&) { log.push_back("B"); });
+        bus.Subscribe<PingEvent>(&g_ownerC, [&](const PingEvent&) { log.push_back("C"); });
+    }
+
+    // Swap-and-pop moves B's and C's handlers into A's old slots; DispatchTo must still find them
+    bus.UnsubscribeAll(&g_ownerA);
+    EXPECT_EQ(bus.GetSubscriberCount<PingEvent>(), 6u);
+
+    bus.DispatchTo(&g_ownerB, PingEvent{1});
+    EXPECT_EQ(log, (std::vector<std::string>{"B", "B", "B"}));
+
+    log.clear();
+    bus.UnsubscribeAll(&g_ownerB);
+    bus.DispatchTo(&g_ownerC, PingEvent{1});
+    EXPECT_EQ(log, (std::vector<std::string>{"C", "C", "C"}));
+    bus.DispatchTo(&g_ownerA, PingEvent{1});
+    bus.DispatchTo(&g_ownerB, PingEvent{1});
+    EXPECT_EQ(log.size(), 3u);
+}
+
+TEST(EventBus, FlushStopsAfterMaxPassesAndResumesNextFlush) {
+    EventBus bus;
+    std::vector<int> generations;
+    bus.Subscribe<LoopEvent>(&g_ownerA, [&](const LoopEvent& e) {
+        generations.push_back(e.generation);
+        bus.Post(LoopEvent{e.generation + 1});
+    });
+
+    bus.Post(LoopEvent{0});
+    bus.Flush();
+
+    // MaxFlushPasses (16) passes, then the 17th generation is left queued
+    ASSERT_EQ(generations.size(), 16u);
+    EXPECT_EQ(generations.back(), 15);
+    EXPECT_EQ(bus.GetQueuedCount(), 1u);
+
+    bus.Flush();
+    ASSERT_EQ(generations.size(), 32u);
+    EXPECT_EQ(generations[16], 16);
+    EXPECT_EQ(bus.GetQueuedCount(), 1u);
+}
+
+TEST(EventBus, EventsLeftQueuedByTheCutoffKeepTheirPayload) {
+    EventBus bus;
+    std::vector<std::string> names;
+    bus.Subscribe<NamedEvent>(&g_ownerA, [&](const NamedEvent& e) {
+        names.push_back(e.name);
+        if (names.size() < 20) bus.Post(NamedEvent("event" + std::to_string(names.size())));
+    });
+
+    bus.Post(NamedEvent("event0"));
+    bus.Flush();
+    ASSERT_EQ(names.size(), 16u);
+    EXPECT_EQ(NamedEvent::live, 1);
+
+    // The leftover's storage survived the first flush, so it still reads back intact
+    bus.Flush();
+    ASSERT_EQ(names.size(), 20u);
+    for (size_t i = 0; i < names.size(); ++i) EXPECT_EQ(names[i], "event" + std::to_string(i));
+    EXPECT_EQ(NamedEvent::live, 0);
+}
+
+TEST(EventBus, QueuedPayloadsAreDestroyedByFlushAndClear) {
+    {
+        EventBus bus;
+        bus.Subscribe<NamedEvent>(&g_ownerA, [](const NamedEvent&) {});
+        bus.Post(NamedEvent("flushed"));
+        EXPECT_EQ(NamedEvent::live, 1);
+        bus.Flush();
+        EXPECT_EQ(NamedEvent::live, 0);
+
+        bus.Post(NamedEvent("cleared"));
+        bus.Clear();
+        EXPECT_EQ(NamedEvent::live, 0);
+        EXPECT_EQ(bus.GetQueuedCount(), 0u);
+
+        bus.Subscribe<NamedEvent>(&g_ownerA, [](const NamedEvent&) {});
+        bus.Post(NamedEvent("destroyed with the bus"));
+    }
+    EXPECT_EQ(NamedEvent::live, 0);
+}
+
+TEST(FrameArena, ResetReusesBlocksBetweenFrames) {
+    FrameArena arena(1024);
+
+    std::vector<void*> firstFrame;
+    for (int i = 0; i < 40; ++i) firstFrame.push_back(arena.Allocate(48, 16));
+    const size_t capacity = arena.GetCapacity();
+    EXPECT_EQ(arena.GetBytesUsed(), 40u * 48u);
+    EXPECT_GE(capacity, 2u * 1024u);
+
+    // The next frame hands out the same addresses from the same blocks
+    for (int frame = 0; frame < 3; ++frame) {
+        arena.Reset();
+        EXPECT_EQ(arena.GetBytesUsed(), 0u);
+        for (int i = 0; i < 40; ++i) EXPECT_EQ(arena.Allocate(48, 16), firstFrame[i]) << "frame " << frame;
+        EXPECT_EQ(arena.GetCapacity(), capacity);
+    }
+}
+
+TEST(FrameArena, AllocationsAreAlignedAndDisjoint) {
+    FrameArena arena(256);
+    std::vector<std::pair<uintptr_t, size_t>> ranges;
+    const size_t alignments[] = {1, 4, 8, 16, 64};
+    for (int i = 0; i < 200; ++i) {
+        const size_t alignment = alignments[i % 5];
+        const size_t size = 1 + (i * 7) % 60;
+        auto address = reinterpret_cast<uintptr_t>(arena.Allocate(size, alignment));
+        EXPECT_EQ(address % alignment, 0u);
+        ranges.emplace_back(address, size);
+    }
+    std::sort(ranges.begin(), ranges.end());
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        EXPECT_LE(ranges[i - 1].first + ranges[i - 1].second, ranges[i].first);
+    }
+}
+
+TEST(FrameArena, OversizedAllocationsAreFreedOnReset) {
+    FrameArena arena(256);
+    arena.Allocate(16, 8);
+    const size_t blockCapacity = arena.GetCapacity();
+
+    void* big = arena.Allocate(4096, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(big) % 64, 0u);
+    EXPECT_GT(arena.GetCapacity(), blockCapacity + 4096);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetCapacity(), blockCapacity);
+}
+
+TEST(WorldEvents, ImmediateRunsNowAndQueuedRunsAtTheNextFlush) {
+    World world("Events");
+    world.SetWorkerThreadCount(0);
+    std::vector<int> log;
+    world.RegisterGlobalEventHandler<PingEvent>([&](const PingEvent& e) { log.push_back(e.value); });
+
+    world.BroadcastEvent(PingEvent{1});
+    world.BroadcastEventImmediate(PingEvent{2});
+    world.BroadcastEvent(PingEvent{3});
+    EXPECT_EQ(log, (std::vector<int>{2}));
+
+    world.Tick(0.016f);
+    EXPECT_EQ(log, (std::vector<int>{2, 1, 3}));
+}
+
+TEST(WorldEvents, EventsPostedByAGroupArriveBeforeTheNextGroup) {
+    World world("Events");
+    world.SetWorkerThreadCount(0);
+    world.SpawnActor<PostingActor>("Poster");
+    auto* listener = world.SpawnActor<ListeningActor>("Listener");
+    world.BeginPlay();
+
+    world.Tick(0.016f);
+    EXPECT_EQ(listener->received, 1);
+    EXPECT_EQ(listener->receivedBeforeTick, 1);
+}
+
+TEST(WorldEvents, DestroyedActorsLoseTheirSubscriptions) {
+    World world("Events");
+    world.SetWorkerThreadCount(0);
+    int calls = 0;
+    auto* kept = world.SpawnActor<PingActor>("Kept");
+    auto* doomed = world.SpawnActor<PingActor>("Doomed");
+    kept->BindEvent<PingEvent>([&](const PingEvent&) { ++calls; });
+    doomed->BindEvent<PingEvent>([&](const PingEvent&) { ++calls; });
+    doomed->BindEvent<PongEvent>([&](const PongEvent&) { ++calls; });
+    EXPECT_EQ(world.GetEventBus().GetSubscriberCount<PingEvent>(), 2u);
+
+    // The doomed actor lives until cleanup, so the first flush of the tick still reaches it
+    world.BroadcastEvent(PingEvent{1});
+    world.DestroyActor(doomed);
+    world.Tick(0.016f);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(world.GetEventBus().GetSubscriberCount<PingEvent>(), 1u);
+    EXPECT_EQ(world.GetEventBus().GetSubscriberCount<PongEvent>(), 0u);
+
+    calls = 0;
+    world.BroadcastEventImmediate(PingEvent{2});
+    world.BroadcastEventImmediate(PongEvent{2});
+    EXPECT_EQ(calls, 1);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "Engine/FrustumCulling.h"
+#include "Engine/JobSystem.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+using FrustumCulling::Path;
+
+// Camera at the origin looking down -z, 90 degree fov, depth 1..100
+FrustumCulling::Frustum TestFrustum() {
+    const glm::mat4 proj = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return FrustumCulling::ExtractFrustum(proj * view);
+}
+
+// Random boxes around the frustum, some inside, many outside, some straddling a plane
+FrustumCulling::BoxList RandomBoxes(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 5.0f);
+    FrustumCulling::BoxList boxes;
+    for (size_t i = 0; i < count; ++i) {
+        boxes.Add({position(rng), position(rng), position(rng) - 50.0f}, {extent(rng), extent(rng), extent(rng)});
+    }
+    return boxes;
+}
+
+std::vector<uint32_t> CullWith(const FrustumCulling::BoxList& boxes, Path path) {
+    std::vector<uint32_t> visible(boxes.Size());
+    visible.resize(FrustumCulling::Cull(TestFrustum(), boxes.GetArrays(), boxes.Size(), visible.data(), path));
+    return visible;
+}
+
+bool IsVisible(const glm::vec3& center, const glm::vec3& extent) {
+    FrustumCulling::BoxList boxes;
+    boxes.Add(center, extent);
+    return CullWith(boxes, Path::Scalar).size() == 1;
+}
+
+} // namespace
+
+TEST(FrustumCulling, PlanesBoundTheView) {
+    EXPECT_TRUE(IsVisible({0.0f, 0.0f, -10.0f}, glm::vec3(0.5f)));
+    EXPECT_TRUE(IsVisible({9.0f, 0.0f, -10.0f}, glm::vec3(0.5f)));
+    EXPECT_FALSE(IsVisible({12.0f, 0.0f, -10.0f}, glm::vec3(0.5f)));   // right of a 45 degree half angle
+    EXPECT_FALSE(IsVisible({0.0f, -12.0f, -10.0f}, glm::vec3(0.5f)));  // below
+    EXPECT_FALSE(IsVisible({0.0f, 0.0f, 10.0f}, glm::vec3(0.5f)));     // behind the camera
+    EXPECT_FALSE(IsVisible({0.0f, 0.0f, -0.2f}, glm::vec3(0.5f)));     // before the near plane
+    EXPECT_FALSE(IsVisible({0.0f, 0.0f, -110.0f}, glm::vec3(5.0f)));   // past the far plane
+
+    // Straddling a plane counts as visible
+    EXPECT_TRUE(IsVisible({12.0f, 0.0f, -10.0f}, glm::vec3(3.0f)));
+    EXPECT_TRUE(IsVisible({0.0f, 0.0f, -102.0f}, glm::vec3(5.0f)));
+}
+
+TEST(FrustumCulling, EveryPathMatchesScalar) {
+    // Odd count so the vector paths also run their scalar remainder
+    const FrustumCulling::BoxList boxes = RandomBoxes(10007, 11);
+    const std::vector<uint32_t> expected = CullWith(boxes, Path::Scalar);
+    ASSERT_GT(expected.size(), 100u);
+    ASSERT_LT(expected.size(), boxes.Size() / 2);
+
+    for (Path path : {Path::SSE2, Path::AVX2}) {
+        if (!FrustumCulling::IsPathSupported(path)) continue;
+        EXPECT_EQ(CullWith(boxes, path), expected) << FrustumCulling::GetPathName(path);
+    }
+}
+
+TEST(FrustumCulling, ParallelMatchesSerial) {
+    const FrustumCulling::BoxList boxes = RandomBoxes(50001, 12);
+    std::vector<uint32_t> expected(boxes.Size());
+    expected.resize(FrustumCulling::Cull(TestFrustum(), boxes.GetArrays(), boxes.Size(), expected.data()));
+
+    JobSystem jobs(3);
+    std::vector<uint32_t> visible(boxes.Size());
+    visible.resize(FrustumCulling::CullParallel(jobs, TestFrustum(), boxes.GetArrays(), boxes.Size(),
+                                                visible.data(), 1000));
+    EXPECT_EQ(visible, expected);
+}
+
+TEST(FrustumCulling, TransformedBoxesEncloseTheRotatedBox) {
+    FrustumCulling::BoxList boxes;
+    const glm::mat4 world = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f)),
+                                        glm::radians(45.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    boxes.AddTransformed(world, glm::vec3(0.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+    const FrustumCulling::AABBArrays arrays = boxes.GetArrays();
+
+    EXPECT_FLOAT_EQ(arrays.centerX[0], 1.0f);
+    EXPECT_FLOAT_EQ(arrays.centerY[0], 2.0f);
+    EXPECT_FLOAT_EQ(arrays.centerZ[0], 3.0f);
+    EXPECT_NEAR(arrays.extentX[0], std::sqrt(2.0f), 1e-5f);
+    EXPECT_NEAR(arrays.extentY[0], std::sqrt(2.0f), 1e-5f);
+    EXPECT_NEAR(arrays.extentZ[0], 1.0f, 1e-5f);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "Engine/InstanceBatcher.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace {
+
+glm::mat4 At(float x) {
+    return glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, 0.0f));
+}
+
+} // namespace
+
+TEST(InstanceBatcher, PacksOneBatchPerMeshAndMaterial) {
+    InstanceBatcher batcher;
+    // Interleaved on purpose: mesh 2 first, materials mixed
+    batcher.Add(2, 0, At(0), glm::vec4(1.0f));
+    batcher.Add(1, 5, At(1), glm::vec4(0.5f));
+    batcher.Add(2, 0, At(2), glm::vec4(0.25f));
+    batcher.Add(1, 3, At(3), glm::vec4(1.0f));
+    batcher.Add(1, 5, At(4), glm::vec4(1.0f));
+    ASSERT_EQ(batcher.GetInstanceCount(), 5u);
+
+    std::vector<InstanceData> packed(batcher.GetInstanceCount());
+    const std::vector<InstanceBatcher::Batch>& batches = batcher.Pack(packed.data());
+
+    // Ordered by mesh, then material; back to back in the output
+    ASSERT_EQ(batches.size(), 3u);
+    EXPECT_EQ(batches[0].mesh, 1u);
+    EXPECT_EQ(batches[0].material, 3u);
+    EXPECT_EQ(batches[1].mesh, 1u);
+    EXPECT_EQ(batches[1].material, 5u);
+    EXPECT_EQ(batches[2].mesh, 2u);
+    uint32_t next = 0;
+    for (const InstanceBatcher::Batch& batch : batches) {
+        EXPECT_EQ(batch.firstInstance, next);
+        next += batch.instanceCount;
+    }
+    EXPECT_EQ(next, 5u);
+
+    // Instances keep their add order inside a batch, matrix and tint as given
+    EXPECT_FLOAT_EQ(packed[0].model[3].x, 3.0f);
+    EXPECT_FLOAT_EQ(packed[1].model[3].x, 1.0f);
+    EXPECT_FLOAT_EQ(packed[2].model[3].x, 4.0f);
+    EXPECT_FLOAT_EQ(packed[3].model[3].x, 0.0f);
+    EXPECT_FLOAT_EQ(packed[4].model[3].x, 2.0f);
+    EXPECT_EQ(packed[1].tint, glm::vec4(0.5f));
+    EXPECT_EQ(packed[4].tint, glm::vec4(0.25f));
+}
+
+TEST(InstanceBatcher, ClearedBucketsProduceNoBatches) {
+    InstanceBatcher batcher;
+    batcher.Add(1, 1, At(0), glm::vec4(1.0f));
+    batcher.Add(2, 1, At(1), glm::vec4(1.0f));
+    std::vector<InstanceData> packed(2);
+    batcher.Pack(packed.data());
+
+    batcher.Clear();
+    EXPECT_EQ(batcher.GetInstanceCount(), 0u);
+    EXPECT_TRUE(batcher.Pack(packed.data()).empty());
+
+    // Only the bucket used this frame is drawn
+    batcher.Add(2, 1, At(7), glm::vec4(1.0f));
+    const std::vector<InstanceBatcher::Batch>& batches = batcher.Pack(packed.data());
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].mesh, 2u);
+    EXPECT_EQ(batches[0].firstInstance, 0u);
+    EXPECT_FLOAT_EQ(packed[0].model[3].x, 7.0f);
+}
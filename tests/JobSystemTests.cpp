@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "Engine/JobSystem.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(JobSystem, ParallelForVisitsEveryIndexOnce) {
+    JobSystem jobs(3);
+    std::vector<std::atomic<int>> visits(10000);
+
+    jobs.ParallelFor(visits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) visits[i].fetch_add(1);
+    });
+
+    for (const auto& count : visits) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+TEST(JobSystem, NestedParallelForCompletes) {
+    JobSystem jobs(3);
+    std::atomic<size_t> total{0};
+
+    jobs.ParallelFor(16, 1, [&](size_t, size_t) {
+        jobs.ParallelFor(256, 16, [&](size_t begin, size_t end) { total.fetch_add(end - begin); });
+    });
+
+    EXPECT_EQ(total.load(), 16u * 256u);
+}
+
+TEST(JobSystem, ThreadIndexBelongsToItsPool) {
+    JobSystem outer(2);
+    JobSystem inner(2);
+    EXPECT_EQ(outer.GetCurrentThreadIndex(), 0u);
+
+    std::atomic<bool> outerInRange{true};
+    std::atomic<bool> innerIsExternal{true};
+    outer.ParallelFor(64, 1, [&](size_t, size_t) {
+        if (outer.GetCurrentThreadIndex() > outer.GetWorkerCount()) outerInRange = false;
+        // A worker of another pool is an external thread here
+        if (inner.GetCurrentThreadIndex() != 0) innerIsExternal = false;
+    });
+
+    EXPECT_TRUE(outerInRange.load());
+    EXPECT_TRUE(innerIsExternal.load());
+}
+
+TEST(JobSystem, ExceptionIsRethrownOnCaller) {
+    JobSystem jobs(3);
+    std::atomic<size_t> ran{0};
+
+    EXPECT_THROW(jobs.ParallelFor(1000, 10, [&](size_t begin, size_t) {
+        ran.fetch_add(1);
+        if (begin == 500) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+    EXPECT_LE(ran.load(), 100u);
+
+    // The pool is still usable afterwards
+    std::atomic<size_t> total{0};
+    jobs.ParallelFor(1000, 10, [&](size_t begin, size_t end) { total.fetch_add(end - begin); });
+    EXPECT_EQ(total.load(), 1000u);
+}
+
+TEST(JobSystem, ExceptionWithoutWorkersIsRethrown) {
+    JobSystem jobs(0);
+    EXPECT_THROW(jobs.ParallelFor(100, 10, [](size_t, size_t) { throw std::logic_error("inline"); }),
+                 std::logic_error);
+}
+
+TEST(JobSystem, SharedPoolIsOneInstance) {
+    EXPECT_EQ(&JobSystem::Shared(), &JobSystem::Shared());
+    EXPECT_EQ(JobSystem::Shared().GetWorkerCount(), JobSystem::DefaultWorkerCount());
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "Engine/LuaGcScheduler.h"
+#include <lua.hpp>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Short-lived tables only: everything becomes garbage right away
+constexpr const char* MakeGarbage = "for i = 1, 200000 do local t = { i, i + 1, tostring(i) } end";
+
+class LuaGcSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        L = luaL_newstate();
+        luaL_openlibs(L);
+        scheduler.Attach(L);
+    }
+    void TearDown() override { lua_close(L); }
+
+    void Run(const char* chunk) { ASSERT_EQ(luaL_dostring(L, chunk), LUA_OK) << lua_tostring(L, -1); }
+
+    lua_State* L = nullptr;
+    LuaGcScheduler scheduler;
+};
+
+} // namespace
+
+TEST_F(LuaGcSchedulerTest, DefaultsToGenerational) {
+    EXPECT_EQ(scheduler.GetMode(), LuaGcScheduler::Mode::Generational);
+}
+
+TEST_F(LuaGcSchedulerTest, IncrementalWithoutStepKeepsTheHeapBounded) {
+    scheduler.SetMode(LuaGcScheduler::Mode::Incremental);
+
+    // About 100 MB of garbage in total; nobody calls Step()
+    for (int i = 0; i < 10; ++i) {
+        Run(MakeGarbage);
+    }
+    EXPECT_LT(scheduler.GetHeapKB(), 16u * 1024u);
+}
+
+TEST_F(LuaGcSchedulerTest, StepFinishesCyclesInsideTheBudget) {
+    scheduler.SetMode(LuaGcScheduler::Mode::Incremental);
+    scheduler.SetBudgetMs(2.0);
+
+    // A live set of a few MB: on a tiny heap Lua's own pause fires long before Step()
+    // would start a cycle
+    Run("keep = {} for i = 1, 50000 do keep[i] = { i, tostring(i) } end");
+    scheduler.FullCollect();
+    scheduler.ResetStats();
+    const size_t liveKB = scheduler.GetHeapKB();
+
+    size_t peakKB = 0;
+    double longestStepCall = 0.0;
+    for (int frame = 0; frame < 60; ++frame) {
+        Run("for i = 1, 20000 do local t = { i, tostring(i) } end");
+        peakKB = std::max(peakKB, scheduler.GetHeapKB());
+        const auto start = std::chrono::steady_clock::now();
+        scheduler.Step(0.001, 1.0 / 60.0);
+        longestStepCall = std::max(longestStepCall,
+                                   std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    const LuaGcScheduler::Stats& stats = scheduler.GetStats();
+    EXPECT_GT(stats.cycles, 0u);
+    EXPECT_EQ(stats.emergencies, 0u);
+    EXPECT_EQ(stats.frames, 60u);
+    // No new step once the budget is spent: at most one step past it. How long one
+    // step takes is up to Lua and the machine, so it is not bounded here.
+    EXPECT_LT(longestStepCall, 0.002 + stats.maxPauseSeconds + 0.001);
+    EXPECT_LT(peakKB, static_cast<size_t>(liveKB * LuaGcScheduler::EmergencyGrowth));
+}
+
+TEST_F(LuaGcSchedulerTest, FrameTimePercentiles) {
+    for (int frame = 1; frame <= 100; ++frame) {
+        scheduler.Step(frame * 0.001, 1.0);
+    }
+    EXPECT_NEAR(scheduler.GetFrameTimePercentile(0.5), 0.050, 0.0011);
+    EXPECT_NEAR(scheduler.GetFrameTimePercentile(0.99), 0.099, 0.0011);
+}
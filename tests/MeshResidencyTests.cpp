@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "Engine/MeshResidency.h"
+#include <glad/glad.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+// MeshResidency's handle bookkeeping against a fake GL that accepts every call. The fake
+// reports plain GL 3.3, so uploads go through glBufferSubData without a staging ring.
+
+namespace {
+
+GLuint g_nextName = 1;
+
+void MockGenNames(GLsizei count, GLuint* names) {
+    for (GLsizei i = 0; i < count; ++i) names[i] = g_nextName++;
+}
+void MockDeleteNames(GLsizei, const GLuint*) {}
+void MockBindVertexArray(GLuint) {}
+void MockBindBuffer(GLenum, GLuint) {}
+void MockBufferData(GLenum, GLsizeiptr, const void*, GLenum) {}
+void MockBufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) {}
+void MockVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+void MockEnableVertexAttribArray(GLuint) {}
+
+void InstallMockGL() {
+#ifdef GL_VERSION_4_3
+    GLAD_GL_VERSION_4_3 = 0;
+#endif
+#ifdef GL_VERSION_4_4
+    GLAD_GL_VERSION_4_4 = 0;
+#endif
+#ifdef GL_ARB_multi_draw_indirect
+    GLAD_GL_ARB_multi_draw_indirect = 0;
+#endif
+#ifdef GL_ARB_buffer_storage
+    GLAD_GL_ARB_buffer_storage = 0;
+#endif
+
+    glad_glGenVertexArrays = MockGenNames;
+    glad_glGenBuffers = MockGenNames;
+    glad_glDeleteVertexArrays = MockDeleteNames;
+    glad_glDeleteBuffers = MockDeleteNames;
+    glad_glBindVertexArray = MockBindVertexArray;
+    glad_glBindBuffer = MockBindBuffer;
+    glad_glBufferData = MockBufferData;
+    glad_glBufferSubData = MockBufferSubData;
+    glad_glVertexAttribPointer = MockVertexAttribPointer;
+    glad_glEnableVertexAttribArray = MockEnableVertexAttribArray;
+}
+
+class MeshResidencyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        InstallMockGL();
+        ASSERT_TRUE(meshes.Init());
+        EXPECT_FALSE(meshes.UsesStaging());
+    }
+
+    void TearDown() override { meshes.Shutdown(); }
+
+    MeshResidency::Handle Upload(uint32_t vertexCount) {
+        std::vector<Vertex> vertices(vertexCount);
+        std::vector<uint32_t> indices(vertexCount * 3, 0);
+        return meshes.Upload(vertices.data(), vertexCount, indices.data(), vertexCount * 3);
+    }
+
+    MeshResidency meshes{1024, 4096, 0};
+};
+
+} // namespace
+
+TEST_F(MeshResidencyTest, ReleasedHandleStaysInvalidAfterItsSlotIsReused) {
+    const MeshResidency::Handle first = Upload(10);
+    ASSERT_NE(meshes.GetRecord(first), nullptr);
+    EXPECT_EQ(meshes.GetRecord(first)->vertexCount, 10u);
+
+    meshes.Release(first);
+    EXPECT_EQ(meshes.GetRecord(first), nullptr);
+
+    // Same slot, new generation: the old handle must not see the new mesh
+    const MeshResidency::Handle second = Upload(20);
+    EXPECT_EQ(second & MeshResidency::HandleIndexMask, first & MeshResidency::HandleIndexMask);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(meshes.GetRecord(first), nullptr);
+    ASSERT_NE(meshes.GetRecord(second), nullptr);
+    EXPECT_EQ(meshes.GetRecord(second)->vertexCount, 20u);
+
+    // Releasing through the stale handle leaves the new mesh alone
+    meshes.Release(first);
+    ASSERT_NE(meshes.GetRecord(second), nullptr);
+    EXPECT_EQ(meshes.GetStats().meshes, 1u);
+}
+
+TEST_F(MeshResidencyTest, FirstHandleIsZero) {
+    // Renderer relies on its cube being handle 0
+    EXPECT_EQ(Upload(8), 0u);
+    EXPECT_EQ(meshes.GetRecord(MeshResidency::InvalidHandle), nullptr);
+    EXPECT_EQ(meshes.Upload(nullptr, 0, nullptr, 0), MeshResidency::InvalidHandle);
+}
+
+TEST_F(MeshResidencyTest, SlotIsRetiredBeforeItsGenerationWraps) {
+    MeshResidency::Handle handle = Upload(4);
+    const uint32_t index = handle & MeshResidency::HandleIndexMask;
+    for (uint32_t generation = 0; generation < MeshResidency::MaxHandleGeneration; ++generation) {
+        meshes.Release(handle);
+        handle = Upload(4);
+        ASSERT_EQ(handle & MeshResidency::HandleIndexMask, index);
+    }
+    EXPECT_EQ(handle >> MeshResidency::HandleIndexBits, MeshResidency::MaxHandleGeneration);
+
+    // Reusing it again would bring back generation 0, and with it the very first handle
+    meshes.Release(handle);
+    const MeshResidency::Handle next = Upload(4);
+    EXPECT_NE(next & MeshResidency::HandleIndexMask, index);
+    EXPECT_EQ(meshes.GetRecord(index), nullptr);
+}
+
+TEST_F(MeshResidencyTest, RandomUploadsAndReleasesMatchLiveSet) {
+    std::mt19937 rng(11);
+    std::vector<std::pair<MeshResidency::Handle, uint32_t>> live;
+    std::vector<MeshResidency::Handle> released;
+
+    for (int op = 0; op < 2000; ++op) {
+        if (live.empty() || rng() % 5 < 3) {
+            const uint32_t vertexCount = 1 + rng() % 64;
+            const MeshResidency::Handle handle = Upload(vertexCount);
+            ASSERT_NE(handle, MeshResidency::InvalidHandle);
+            live.emplace_back(handle, vertexCount);
+        } else {
+            const size_t at = rng() % live.size();
+            meshes.Release(live[at].first);
+            released.push_back(live[at].first);
+            live[at] = live.back();
+            live.pop_back();
+        }
+    }
+
+    EXPECT_EQ(meshes.GetStats().meshes, live.size());
+    for (const auto& [handle, vertexCount] : live) {
+        const MeshResidency::MeshRecord* record = meshes.GetRecord(handle);
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(record->vertexCount, vertexCount);
+    }
+    for (MeshResidency::Handle handle : released) {
+        EXPECT_EQ(meshes.GetRecord(handle), nullptr);
+    }
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "Engine/Actor.h"
+#include "Engine/World.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Every global operator new in this binary is counted, so a loop can assert it made none
+namespace {
+std::atomic<uint64_t> g_globalNews{0};
+}
+
+void* operator new(size_t size) {
+    g_globalNews.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+class PooledPayloadComponent : public ActorComponent {
+public:
+    PooledPayloadComponent(Actor* owner) : ActorComponent(owner) {}
+    float values[4] = {};
+};
+
+// Same size as the component above, different type
+class OtherPayloadComponent : public ActorComponent {
+public:
+    OtherPayloadComponent(Actor* owner) : ActorComponent(owner) {}
+    float values[4] = {};
+};
+
+class PooledActor : public Actor {
+public:
+    using ThisClass = PooledActor;
+    using Super = Actor;
+    PooledActor(World* world, const std::string& name) : Actor(world, name) {
+        CreateComponent<PooledPayloadComponent>();
+    }
+    static std::string StaticClass() { return "PooledActor"; }
+};
+
+void SpawnAndDestroyWave(World& world, std::vector<Actor*>& spawned, size_t count) {
+    spawned.clear();
+    for (size_t i = 0; i < count; ++i) {
+        spawned.push_back(world.SpawnActor<PooledActor>("P"));
+    }
+    for (Actor* actor : spawned) {
+        world.DestroyActor(actor);
+    }
+    world.CleanupDestroyedActors();
+}
+
+} // namespace
+
+TEST(ObjectPools, EachTypeHasItsOwnPool) {
+    static_assert(sizeof(PooledPayloadComponent) == sizeof(OtherPayloadComponent));
+    EXPECT_NE(&ObjectPools::GetPool<PooledPayloadComponent>(), &ObjectPools::GetPool<OtherPayloadComponent>());
+    EXPECT_EQ(&ObjectPools::GetPool<PooledActor>(), &ObjectPools::GetPool<PooledActor>());
+}
+
+TEST(ObjectPools, DestroyedActorsReturnToTheirTypePool) {
+    World world("Pools");
+    ObjectPool& actorPool = ObjectPools::GetPool<PooledActor>();
+    ObjectPool& componentPool = ObjectPools::GetPool<PooledPayloadComponent>();
+    const size_t actorsBefore = actorPool.GetLiveCount();
+    const size_t componentsBefore = componentPool.GetLiveCount();
+
+    Actor* actor = world.SpawnActor<PooledActor>("P");
+    EXPECT_EQ(actorPool.GetLiveCount(), actorsBefore + 1);
+    EXPECT_EQ(componentPool.GetLiveCount(), componentsBefore + 1);
+
+    world.DestroyActor(actor);
+    world.CleanupDestroyedActors();
+    EXPECT_EQ(actorPool.GetLiveCount(), actorsBefore);
+    EXPECT_EQ(componentPool.GetLiveCount(), componentsBefore);
+
+    // The freed slot is the next one handed out
+    Actor* again = world.SpawnActor<PooledActor>("P");
+    EXPECT_EQ(again, actor);
+}
+
+TEST(ObjectPools, WarmSpawnDestroyLoopDoesNotAllocate) {
+    constexpr size_t waveSize = 2000;
+    World world("ZeroAlloc");
+    world.PrewarmActors<PooledActor>(waveSize);
+    World::PrewarmComponents<PooledPayloadComponent>(waveSize);
+
+    std::vector<Actor*> spawned;
+    spawned.reserve(waveSize);
+    // One wave grows the registry and index storage to their peak
+    SpawnAndDestroyWave(world, spawned, waveSize);
+
+    const PoolStats before = ObjectPools::GetStats();
+    const uint64_t newsBefore = g_globalNews.load();
+    for (int wave = 0; wave < 10; ++wave) {
+        SpawnAndDestroyWave(world, spawned, waveSize);
+    }
+    const uint64_t newsAfter = g_globalNews.load();
+    const PoolStats after = ObjectPools::GetStats();
+
+    EXPECT_EQ(newsAfter - newsBefore, 0u);
+    EXPECT_EQ(after.heapAllocations, before.heapAllocations);
+    EXPECT_GE(after.allocations - before.allocations, 10u * waveSize * 2);
+    EXPECT_EQ(world.GetActorCount(), 0u);
+}
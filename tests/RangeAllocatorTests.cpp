@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "Engine/RangeAllocator.h"
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Shadow of the allocator: one flag per element, true when allocated
+struct Bitmap {
+    std::vector<bool> used;
+
+    // Maximal free runs, as the allocator's free list should hold them
+    std::vector<std::pair<uint32_t, uint32_t>> FreeRuns() const {
+        std::vector<std::pair<uint32_t, uint32_t>> runs;
+        for (uint32_t i = 0; i < used.size();) {
+            if (used[i]) { ++i; continue; }
+            uint32_t end = i;
+            while (end < used.size() && !used[end]) ++end;
+            runs.emplace_back(i, end - i);
+            i = end;
+        }
+        return runs;
+    }
+};
+
+void ExpectMatches(const RangeAllocator& allocator, const Bitmap& bitmap) {
+    const auto runs = bitmap.FreeRuns();
+    uint32_t freeElements = 0;
+    uint32_t largest = 0;
+    for (const auto& run : runs) {
+        freeElements += run.second;
+        largest = std::max(largest, run.second);
+    }
+    ASSERT_EQ(allocator.GetCapacity(), bitmap.used.size());
+    ASSERT_EQ(allocator.GetFree(), freeElements);
+    // Fully merged: one free range per run
+    ASSERT_EQ(allocator.GetFreeRangeCount(), runs.size());
+    ASSERT_EQ(allocator.GetLargestFreeRange(), largest);
+}
+
+} // namespace
+
+TEST(RangeAllocator, RandomOpsMatchABitmap) {
+    std::mt19937 rng(25);
+    RangeAllocator allocator(1u << 16);
+    Bitmap bitmap;
+    bitmap.used.assign(allocator.GetCapacity(), false);
+    std::vector<std::pair<uint32_t, uint32_t>> live;   // offset, size
+
+    for (int op = 0; op < 200000; ++op) {
+        const uint32_t roll = rng() % 1000;
+        if (roll == 0 && allocator.GetCapacity() < (1u << 20)) {
+            const uint32_t capacity = allocator.GetCapacity() + 1024 + rng() % 4096;
+            allocator.Grow(capacity);
+            bitmap.used.resize(capacity, false);
+        } else if (roll < 520 || live.empty()) {
+            // Mostly small meshes, now and then a large one
+            const uint32_t size = rng() % 16 == 0 ? 1 + rng() % 8192 : 1 + rng() % 256;
+            const uint32_t offset = allocator.Allocate(size);
+            if (offset == RangeAllocator::InvalidOffset) {
+                // Only when no free run is large enough
+                for (const auto& run : bitmap.FreeRuns()) ASSERT_LT(run.second, size) << "op " << op;
+                continue;
+            }
+            ASSERT_LE(offset + size, bitmap.used.size()) << "op " << op;
+            for (uint32_t i = offset; i < offset + size; ++i) {
+                ASSERT_FALSE(bitmap.used[i]) << "element " << i << " handed out twice, op " << op;
+                bitmap.used[i] = true;
+            }
+            live.emplace_back(offset, size);
+        } else {
+            const size_t index = rng() % live.size();
+            const auto [offset, size] = live[index];
+            live[index] = live.back();
+            live.pop_back();
+            allocator.Free(offset, size);
+            for (uint32_t i = offset; i < offset + size; ++i) bitmap.used[i] = false;
+        }
+
+        if (op % 500 == 0) {
+            ExpectMatches(allocator, bitmap);
+            if (HasFatalFailure()) FAIL() << "op " << op;
+        }
+    }
+    ExpectMatches(allocator, bitmap);
+
+    // Freeing everything leaves the single range it started with
+    for (const auto& [offset, size] : live) allocator.Free(offset, size);
+    EXPECT_EQ(allocator.GetUsed(), 0u);
+    EXPECT_EQ(allocator.GetFreeRangeCount(), 1u);
+    EXPECT_EQ(allocator.GetLargestFreeRange(), allocator.GetCapacity());
+}
+
+TEST(RangeAllocator, BestFitPrefersTheSmallestHole) {
+    RangeAllocator allocator(100);
+    const uint32_t a = allocator.Allocate(10);
+    const uint32_t spacer = allocator.Allocate(5);
+    const uint32_t b = allocator.Allocate(30);
+    allocator.Allocate(5);
+    const uint32_t d = allocator.Allocate(50);
+    ASSERT_EQ(allocator.GetFree(), 0u);
+
+    // Holes of 10, 30 and 50
+    allocator.Free(a, 10);
+    allocator.Free(b, 30);
+    allocator.Free(d, 50);
+    EXPECT_EQ(allocator.Allocate(8), a);
+    EXPECT_EQ(allocator.Allocate(30), b);
+    EXPECT_EQ(allocator.Allocate(51), RangeAllocator::InvalidOffset);
+
+    // The 2 left after a, the spacer and b merge into one range
+    allocator.Free(spacer, 5);
+    allocator.Free(b, 30);
+    EXPECT_EQ(allocator.GetFreeRangeCount(), 2u);
+    EXPECT_EQ(allocator.Allocate(37), a + 8);
+    EXPECT_EQ(allocator.Allocate(50), d);
+}
+
+TEST(RangeAllocator, GrowExtendsTheLastFreeRange) {
+    RangeAllocator allocator(64);
+    allocator.Allocate(32);
+    allocator.Grow(128);
+    EXPECT_EQ(allocator.GetFreeRangeCount(), 1u);
+    EXPECT_EQ(allocator.GetLargestFreeRange(), 96u);
+    EXPECT_EQ(allocator.Allocate(96), 32u);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "Engine/RenderQueue.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+// The tint's x carries an id, so instances can be followed through Build()
+InstanceData Tagged(float id) {
+    return InstanceData{glm::mat4(1.0f), glm::vec4(id, 0.0f, 0.0f, 1.0f)};
+}
+
+std::vector<float> TagsOf(const RenderFrame& frame) {
+    std::vector<float> tags;
+    for (const InstanceData& instance : frame.instances) tags.push_back(instance.tint.x);
+    return tags;
+}
+
+} // namespace
+
+TEST(RenderQueue, RadixSortMatchesStableSort) {
+    std::mt19937_64 rng(3);
+    std::vector<RenderQueue::SortItem> items;
+    for (uint64_t i = 0; i < 20000; ++i) {
+        // Few distinct keys, spread over every byte, so ties are everywhere
+        const uint64_t key = (rng() % 64) * 0x0101010101010101ull ^ (rng() % 4);
+        items.push_back({key, i});
+    }
+
+    std::vector<RenderQueue::SortItem> expected = items;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const RenderQueue::SortItem& a, const RenderQueue::SortItem& b) { return a.key < b.key; });
+
+    std::vector<RenderQueue::SortItem> scratch;
+    RenderQueue::RadixSort(items, scratch);
+    ASSERT_EQ(items.size(), expected.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        ASSERT_EQ(items[i].key, expected[i].key) << i;
+        ASSERT_EQ(items[i].value, expected[i].value) << "equal keys reordered at " << i;
+    }
+}
+
+TEST(RenderQueue, RadixSortSkipsConstantBytes) {
+    // Only the low byte differs; the other seven passes are skipped, the result still sorted
+    std::vector<RenderQueue::SortItem> items;
+    for (uint64_t i = 0; i < 300; ++i) {
+        items.push_back({0xABCD000000000000ull | ((i * 37) % 256), i});
+    }
+    std::vector<RenderQueue::SortItem> scratch;
+    RenderQueue::RadixSort(items, scratch);
+    EXPECT_TRUE(std::is_sorted(items.begin(), items.end(),
+                               [](const RenderQueue::SortItem& a, const RenderQueue::SortItem& b) { return a.key < b.key; }));
+}
+
+TEST(RenderQueue, KeyLayout) {
+    // Opaque: state first, then front to back
+    EXPECT_LT(SortKey::MakeOpaque(1, 5, 0.9f), SortKey::MakeOpaque(2, 0, 0.1f));
+    EXPECT_LT(SortKey::MakeOpaque(1, 1, 0.9f), SortKey::MakeOpaque(1, 2, 0.1f));
+    EXPECT_LT(SortKey::MakeOpaque(1, 1, 0.2f), SortKey::MakeOpaque(1, 1, 0.3f));
+
+    // Translucent: back to front, whatever the state
+    EXPECT_LT(SortKey::MakeTranslucent(9, 9, 0.8f), SortKey::MakeTranslucent(1, 1, 0.2f));
+    EXPECT_LT(SortKey::MakeTranslucent(1, 2, 0.5f), SortKey::MakeTranslucent(2, 1, 0.5f));
+
+    // Every opaque draw before every translucent one; depth is clamped
+    EXPECT_LT(SortKey::MakeOpaque(0xFFFFF, 0xFFFF, 1.0f), SortKey::MakeTranslucent(0, 0, 1.0f));
+    EXPECT_EQ(SortKey::MakeOpaque(3, 3, -1.0f), SortKey::MakeOpaque(3, 3, 0.0f));
+    EXPECT_EQ(SortKey::MakeOpaque(3, 3, 2.0f), SortKey::MakeOpaque(3, 3, 1.0f));
+}
+
+TEST(RenderQueue, BuildOrdersOpaqueFrontToBackAndTranslucentBackToFront) {
+    RenderQueue queue;
+    RenderCommandList& list = queue.GetList(0);
+    list.Draw(SortKey::MakeTranslucent(1, 1, 0.2f), 1, 1, Tagged(4));
+    list.Draw(SortKey::MakeOpaque(1, 1, 0.7f), 1, 1, Tagged(2));
+    list.Draw(SortKey::MakeTranslucent(1, 2, 0.9f), 2, 1, Tagged(3));
+    list.Draw(SortKey::MakeOpaque(1, 1, 0.1f), 1, 1, Tagged(1));
+
+    const RenderFrame& frame = queue.Build();
+    EXPECT_EQ(TagsOf(frame), (std::vector<float>{1, 2, 3, 4}));
+    ASSERT_EQ(frame.batches.size(), 3u);
+    EXPECT_EQ(frame.batches[0].instanceCount, 2u);   // both opaque draws
+    EXPECT_EQ(frame.batches[1].mesh, 2u);
+    EXPECT_EQ(frame.batches[2].mesh, 1u);
+}
+
+TEST(RenderQueue, BatchesCoalesceAcrossLists) {
+    RenderQueue queue(3);
+    // Same state recorded on three lists, interleaved with another material
+    for (unsigned l = 0; l < 3; ++l) {
+        RenderCommandList& list = queue.GetList(l);
+        list.Draw(SortKey::MakeOpaque(7, 2, 0.5f), 2, 7, Tagged(static_cast<float>(l)));
+        const InstanceData group[2] = {Tagged(10.0f + l), Tagged(20.0f + l)};
+        list.Draw(SortKey::MakeOpaque(8, 2, 0.5f), 2, 8, group, 2);
+    }
+
+    const RenderFrame& frame = queue.Build();
+    EXPECT_EQ(frame.stats.packets, 6u);
+    EXPECT_EQ(frame.stats.batches, 2u);
+    EXPECT_EQ(frame.stats.materialChanges, 1u);
+    EXPECT_EQ(frame.stats.meshChanges, 0u);
+
+    ASSERT_EQ(frame.batches.size(), 2u);
+    EXPECT_EQ(frame.batches[0].material, 7u);
+    EXPECT_EQ(frame.batches[0].firstInstance, 0u);
+    EXPECT_EQ(frame.batches[0].instanceCount, 3u);
+    EXPECT_EQ(frame.batches[1].material, 8u);
+    EXPECT_EQ(frame.batches[1].firstInstance, 3u);
+    EXPECT_EQ(frame.batches[1].instanceCount, 6u);
+
+    // Equal keys keep list order, and a packet's instances stay together
+    EXPECT_EQ(TagsOf(frame), (std::vector<float>{0, 1, 2, 10, 20, 11, 21, 12, 22}));
+}
+
+TEST(RenderQueue, RecordingBackendSeesTheBuiltFrame) {
+    RenderQueue queue(2);
+    queue.GetList(1).Draw(SortKey::MakeOpaque(1, 1, 0.5f), 1, 1, Tagged(5));
+
+    RecordingRenderBackend backend;
+    const glm::mat4 viewProj(2.0f);
+    queue.Submit(backend, viewProj);
+    ASSERT_EQ(backend.GetFrames().size(), 1u);
+    EXPECT_EQ(backend.GetFrames()[0].viewProj, viewProj);
+    EXPECT_EQ(backend.GetFrames()[0].frame.stats.batches, 1u);
+
+    // Cleared lists build an empty frame
+    queue.Clear();
+    queue.Submit(backend, viewProj);
+    EXPECT_TRUE(backend.GetFrames()[1].frame.batches.empty());
+    EXPECT_TRUE(backend.GetFrames()[1].frame.instances.empty());
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "Engine/ScriptBytecodeCache.h"
+#include <lua.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int ScriptCount = 500;
+
+std::string ScriptSource(int i) {
+    return "local speed = " + std::to_string(i) + "\nfunction OnTick(dt) return speed * dt end\nreturn speed\n";
+}
+
+std::string ChunkName(int i) { return "@scripts/level/script" + std::to_string(i) + ".lua"; }
+
+class ScriptBytecodeCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        L = luaL_newstate();
+        directory = fs::path(::testing::TempDir()) /
+                    ("sprout_luac_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(directory);
+    }
+
+    void TearDown() override {
+        lua_close(L);
+        fs::remove_all(directory);
+    }
+
+    // Loads every script of the level through a fresh cache, as at startup; the bytecode
+    // must load and return the value its source does
+    ScriptBytecodeCache::Stats Startup() {
+        ScriptBytecodeCache cache(directory.string());
+        for (int i = 0; i < ScriptCount; ++i) {
+            std::string error;
+            const std::string* bytecode = cache.GetBytecode(L, ScriptSource(i), ChunkName(i), error);
+            EXPECT_NE(bytecode, nullptr) << error;
+            if (!bytecode) continue;
+            EXPECT_EQ(luaL_loadbufferx(L, bytecode->data(), bytecode->size(), ChunkName(i).c_str(), "b"), LUA_OK);
+            EXPECT_EQ(lua_pcall(L, 0, 1, 0), LUA_OK);
+            EXPECT_EQ(lua_tointegerx(L, -1, nullptr), i);
+            lua_settop(L, 0);
+        }
+        EXPECT_EQ(cache.GetEntryCount(), static_cast<size_t>(ScriptCount));
+        return cache.GetStats();
+    }
+
+    lua_State* L = nullptr;
+    fs::path directory;
+};
+
+} // namespace
+
+TEST_F(ScriptBytecodeCacheTest, WarmStartCompilesNothing) {
+    const ScriptBytecodeCache::Stats cold = Startup();
+    EXPECT_EQ(cold.compiles, static_cast<uint64_t>(ScriptCount));
+    EXPECT_EQ(cold.diskHits, 0u);
+
+    const ScriptBytecodeCache::Stats warm = Startup();
+    EXPECT_EQ(warm.compiles, 0u);
+    EXPECT_EQ(warm.diskHits, static_cast<uint64_t>(ScriptCount));
+}
+
+TEST_F(ScriptBytecodeCacheTest, SameSourceIsAMemoryHit) {
+    ScriptBytecodeCache cache("");
+    std::string error;
+    const std::string* first = cache.GetBytecode(L, ScriptSource(1), ChunkName(1), error);
+    EXPECT_EQ(cache.GetBytecode(L, ScriptSource(1), ChunkName(1), error), first);
+    EXPECT_EQ(cache.GetStats().memoryHits, 1u);
+
+    // Another chunk name is another entry, even for the same text
+    EXPECT_NE(cache.GetBytecode(L, ScriptSource(1), ChunkName(2), error), first);
+    EXPECT_EQ(cache.GetStats().compiles, 2u);
+    EXPECT_FALSE(fs::exists(directory));
+}
+
+TEST_F(ScriptBytecodeCacheTest, EditedSourceRecompilesOnlyThatScript) {
+    Startup();
+    ScriptBytecodeCache cache(directory.string());
+    std::string error;
+    for (int i = 0; i < ScriptCount; ++i) {
+        const std::string source = i == 42 ? ScriptSource(i) + "-- edited\n" : ScriptSource(i);
+        ASSERT_NE(cache.GetBytecode(L, source, ChunkName(i), error), nullptr) << error;
+    }
+    EXPECT_EQ(cache.GetStats().compiles, 1u);
+    EXPECT_EQ(cache.GetStats().diskHits, static_cast<uint64_t>(ScriptCount - 1));
+}
+
+TEST_F(ScriptBytecodeCacheTest, DamagedFilesAreRecompiled) {
+    Startup();
+    // Cut every cached file short, as a crash mid-write outside the rename would
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        fs::resize_file(entry.path(), fs::file_size(entry.path()) - 1);
+    }
+    EXPECT_EQ(Startup().compiles, static_cast<uint64_t>(ScriptCount));
+}
+
+TEST_F(ScriptBytecodeCacheTest, SyntaxErrorIsReportedAndNotCached) {
+    ScriptBytecodeCache cache(directory.string());
+    std::string error;
+    EXPECT_EQ(cache.GetBytecode(L, "function OnTick(", "@broken.lua", error), nullptr);
+    EXPECT_NE(error.find("broken.lua"), std::string::npos) << error;
+    EXPECT_EQ(cache.GetEntryCount(), 0u);
+    EXPECT_EQ(lua_gettop(L), 0);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "Engine/ScriptWatchdog.h"
+#include <lua.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char* Spin = "function Spin(n) local x = 0; for i = 1, n do x = x + i end; return x end";
+
+// One Lua state with its own watchdog, like the main state or a ParallelScriptRunner shard
+struct GuardedState {
+    GuardedState(ScriptProfiler& profiler, bool sampling) {
+        L = luaL_newstate();
+        luaL_openlibs(L);
+        watchdog.Attach(L, &profiler, sampling);
+        EXPECT_EQ(luaL_dostring(L, Spin), LUA_OK);
+    }
+    ~GuardedState() { lua_close(L); }
+
+    // Spin(iterations) under a guard; true when the call finished
+    bool Call(uint32_t script, ScriptProfiler::Callback callback, const ScriptWatchdog::Budget& budget,
+              lua_Integer iterations) {
+        ScriptWatchdog::Guard guard(watchdog, script, callback, budget);
+        lua_getglobal(L, "Spin");
+        lua_pushinteger(L, iterations);
+        const bool ok = lua_pcall(L, 1, 1, 0) == LUA_OK;
+        lua_settop(L, 0);
+        return ok;
+    }
+
+    lua_State* L = nullptr;
+    ScriptWatchdog watchdog;
+};
+
+ScriptWatchdog::Budget InstructionBudget(uint64_t instructions) {
+    ScriptWatchdog::Budget budget;
+    budget.maxMilliseconds = 0.0;
+    budget.maxInstructions = instructions;
+    return budget;
+}
+
+} // namespace
+
+TEST(ScriptWatchdog, RunawayCallIsStoppedAndDisabled) {
+    ScriptProfiler profiler;
+    const uint32_t script = profiler.RegisterScript("scripts/Runaway.lua");
+    GuardedState state(profiler, true);
+
+    EXPECT_TRUE(state.Call(script, ScriptProfiler::Callback::OnTick, InstructionBudget(100000), 1000));
+    EXPECT_FALSE(state.watchdog.IsDisabled(script));
+
+    EXPECT_FALSE(state.Call(script, ScriptProfiler::Callback::OnTick, InstructionBudget(100000), 100000000));
+    EXPECT_TRUE(state.watchdog.IsDisabled(script));
+    const std::vector<std::string> reports = state.watchdog.TakeReports();
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_NE(reports[0].find("scripts/Runaway.lua"), std::string::npos);
+
+    // The state is usable again once the guard is gone
+    state.watchdog.EnableScript(script);
+    EXPECT_TRUE(state.Call(script, ScriptProfiler::Callback::OnTick, InstructionBudget(100000), 1000));
+}
+
+TEST(ScriptWatchdog, EveryStateTripsOnItsOwnHook) {
+    ScriptProfiler profiler;
+    const uint32_t script = profiler.RegisterScript("scripts/Shard.lua");
+
+    // Shard-style states: names from the shared profiler, no sampling
+    std::vector<std::unique_ptr<GuardedState>> shards;
+    for (int i = 0; i < 3; ++i) {
+        shards.push_back(std::make_unique<GuardedState>(profiler, false));
+    }
+
+    EXPECT_FALSE(shards[1]->Call(script, ScriptProfiler::Callback::OnTick, InstructionBudget(50000), 100000000));
+    EXPECT_TRUE(shards[1]->watchdog.IsDisabled(script));
+    EXPECT_FALSE(shards[0]->watchdog.IsDisabled(script));
+    EXPECT_TRUE(shards[0]->Call(script, ScriptProfiler::Callback::OnTick, InstructionBudget(50000), 1000));
+    EXPECT_TRUE(shards[2]->Call(script, ScriptProfiler::Callback::OnTick, InstructionBudget(50000), 1000));
+
+    // What the runner does after a run: the shard's trip disables the script in the main watchdog
+    ScriptWatchdog main;
+    std::vector<std::string> reports = shards[1]->watchdog.TakeReports();
+    ASSERT_EQ(reports.size(), 1u);
+    main.DisableScript(script, std::move(reports[0]));
+    EXPECT_TRUE(main.IsDisabled(script));
+    EXPECT_EQ(main.TakeReports().size(), 1u);
+}
+
+TEST(ScriptWatchdog, BatchBudgetScalesWithTheBatch) {
+    ScriptWatchdog::Budget perCall;
+    perCall.maxMilliseconds = 2.0;
+    perCall.maxInstructions = 10000;
+    perCall.maxBatchMilliseconds = 50.0;
+
+    const ScriptWatchdog::Budget ten = perCall.ForBatch(10);
+    EXPECT_DOUBLE_EQ(ten.maxMilliseconds, 20.0);
+    EXPECT_EQ(ten.maxInstructions, 100000u);
+
+    const ScriptWatchdog::Budget thousand = perCall.ForBatch(1000);
+    EXPECT_DOUBLE_EQ(thousand.maxMilliseconds, 50.0);
+    EXPECT_EQ(thousand.maxInstructions, 10000000u);
+
+    EXPECT_DOUBLE_EQ(perCall.ForBatch(0).maxMilliseconds, 2.0);
+
+    ScriptWatchdog::Budget unlimited;
+    unlimited.maxMilliseconds = 0.0;
+    EXPECT_DOUBLE_EQ(unlimited.ForBatch(100).maxMilliseconds, 0.0);
+    EXPECT_EQ(unlimited.ForBatch(100).maxInstructions, 0u);
+}
+
+TEST(ScriptWatchdog, BatchOfCheapEntitiesFitsItsScaledBudget) {
+    ScriptProfiler profiler;
+    const uint32_t script = profiler.RegisterScript("scripts/Batch.lua");
+    GuardedState state(profiler, true);
+
+    // 5000 iterations fit one entity's budget; 500 entities' worth in one call do not
+    const ScriptWatchdog::Budget perCall = InstructionBudget(50000);
+    EXPECT_FALSE(state.Call(script, ScriptProfiler::Callback::OnTickBatch, perCall, 500 * 5000));
+    state.watchdog.EnableScript(script);
+    state.watchdog.TakeReports();
+    EXPECT_TRUE(state.Call(script, ScriptProfiler::Callback::OnTickBatch, perCall.ForBatch(500), 500 * 5000));
+    EXPECT_FALSE(state.watchdog.IsDisabled(script));
+}
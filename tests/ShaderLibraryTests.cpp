@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+#include "Engine/ShaderLibrary.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A fake GL behind glad's function pointers: no context or driver needed. "Compiling"
+// just records the source, and a program binary is the linked sources as text.
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr GLenum MockBinaryFormat = 0x5350;
+
+struct MockGL {
+    std::string renderer = "Mock Renderer";
+    bool rejectBinaries = false;
+
+    unsigned nextName = 1;
+    std::unordered_map<unsigned, std::string> shaders;   // name -> source
+    std::unordered_map<unsigned, std::string> programs;  // name -> linked text, empty until linked
+    std::unordered_map<unsigned, std::vector<unsigned>> attached;
+    int shaderCompiles = 0;
+    int binaryLoads = 0;
+};
+
+MockGL* g_gl = nullptr;
+
+const GLubyte* MockGetString(GLenum name) {
+    static std::string value;
+    value = name == GL_RENDERER ? g_gl->renderer : name == GL_VENDOR ? "Mock" : "4.6 Mock";
+    return reinterpret_cast<const GLubyte*>(value.c_str());
+}
+
+void MockGetIntegerv(GLenum name, GLint* data) { *data = name == GL_NUM_PROGRAM_BINARY_FORMATS ? 1 : 0; }
+
+GLuint MockCreateShader(GLenum) {
+    const unsigned name = g_gl->nextName++;
+    g_gl->shaders[name];
+    return name;
+}
+
+void MockShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint*) {
+    std::string& source = g_gl->shaders[shader];
+    source.clear();
+    for (GLsizei i = 0; i < count; ++i) source += strings[i];
+}
+
+void MockCompileShader(GLuint) { ++g_gl->shaderCompiles; }
+
+void MockGetShaderiv(GLuint, GLenum, GLint* value) { *value = GL_TRUE; }
+void MockGetShaderInfoLog(GLuint, GLsizei, GLsizei*, GLchar* log) { log[0] = '\0'; }
+void MockDeleteShader(GLuint shader) { g_gl->shaders.erase(shader); }
+
+GLuint MockCreateProgram() {
+    const unsigned name = g_gl->nextName++;
+    g_gl->programs[name];
+    return name;
+}
+
+void MockAttachShader(GLuint program, GLuint shader) { g_gl->attached[program].push_back(shader); }
+void MockDetachShader(GLuint program, GLuint) { g_gl->attached[program].clear(); }
+void MockProgramParameteri(GLuint, GLenum, GLint) {}
+
+void MockLinkProgram(GLuint program) {
+    std::string linked = "MOCK";
+    for (unsigned shader : g_gl->attached[program]) linked += "\n" + g_gl->shaders[shader];
+    g_gl->programs[program] = linked;
+}
+
+void MockGetProgramiv(GLuint program, GLenum name, GLint* value) {
+    const std::string& linked = g_gl->programs[program];
+    switch (name) {
+        case GL_LINK_STATUS: *value = linked.empty() ? GL_FALSE : GL_TRUE; break;
+        case GL_PROGRAM_BINARY_LENGTH: *value = static_cast<GLint>(linked.size()); break;
+        default: *value = 0; break;
+    }
+}
+
+void MockGetProgramInfoLog(GLuint, GLsizei, GLsizei*, GLchar* log) { log[0] = '\0'; }
+
+void MockGetProgramBinary(GLuint program, GLsizei size, GLsizei* length, GLenum* format, void* binary) {
+    const std::string& linked = g_gl->programs[program];
+    const GLsizei written = std::min(size, static_cast<GLsizei>(linked.size()));
+    std::memcpy(binary, linked.data(), static_cast<size_t>(written));
+    *length = written;
+    *format = MockBinaryFormat;
+}
+
+void MockProgramBinary(GLuint program, GLenum format, const void* binary, GLsizei length) {
+    ++g_gl->binaryLoads;
+    const std::string text(static_cast<const char*>(binary), static_cast<size_t>(length));
+    const bool valid = !g_gl->rejectBinaries && format == MockBinaryFormat && text.compare(0, 4, "MOCK") == 0;
+    g_gl->programs[program] = valid ? text : std::string();
+}
+
+void MockDeleteProgram(GLuint program) {
+    g_gl->programs.erase(program);
+    g_gl->attached.erase(program);
+}
+
+GLint MockGetUniformLocation(GLuint program, const GLchar* name) {
+    return g_gl->programs[program].find(name) != std::string::npos ? 1 : -1;
+}
+
+GLuint MockGetUniformBlockIndex(GLuint, const GLchar*) { return GL_INVALID_INDEX; }
+void MockUniformBlockBinding(GLuint, GLuint, GLuint) {}
+void MockUseProgram(GLuint) {}
+void MockUniform3f(GLint, GLfloat, GLfloat, GLfloat) {}
+void MockGenBuffers(GLsizei count, GLuint* buffers) {
+    for (GLsizei i = 0; i < count; ++i) buffers[i] = g_gl->nextName++;
+}
+void MockDeleteBuffers(GLsizei, const GLuint*) {}
+void MockBindBuffer(GLenum, GLuint) {}
+void MockBindBufferBase(GLenum, GLuint, GLuint) {}
+void MockBufferData(GLenum, GLsizeiptr, const void*, GLenum) {}
+void MockBufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) {}
+
+void InstallMockGL() {
+    GLAD_GL_VERSION_4_1 = 1;
+    GLAD_GL_ARB_get_program_binary = 1;
+    GLAD_GL_KHR_parallel_shader_compile = 0;
+
+    glad_glGetString = MockGetString;
+    glad_glGetIntegerv = MockGetIntegerv;
+    glad_glCreateShader = MockCreateShader;
+    glad_glShaderSource = MockShaderSource;
+    glad_glCompileShader = MockCompileShader;
+    glad_glGetShaderiv = MockGetShaderiv;
+    glad_glGetShaderInfoLog = MockGetShaderInfoLog;
+    glad_glDeleteShader = MockDeleteShader;
+    glad_glCreateProgram = MockCreateProgram;
+    glad_glAttachShader = MockAttachShader;
+    glad_glDetachShader = MockDetachShader;
+    glad_glProgramParameteri = MockProgramParameteri;
+    glad_glLinkProgram = MockLinkProgram;
+    glad_glGetProgramiv = MockGetProgramiv;
+    glad_glGetProgramInfoLog = MockGetProgramInfoLog;
+    glad_glGetProgramBinary = MockGetProgramBinary;
+    glad_glProgramBinary = MockProgramBinary;
+    glad_glDeleteProgram = MockDeleteProgram;
+    glad_glGetUniformLocation = MockGetUniformLocation;
+    glad_glGetUniformBlockIndex = MockGetUniformBlockIndex;
+    glad_glUniformBlockBinding = MockUniformBlockBinding;
+    glad_glUseProgram = MockUseProgram;
+    glad_glUniform3f = MockUniform3f;
+    glad_glGenBuffers = MockGenBuffers;
+    glad_glDeleteBuffers = MockDeleteBuffers;
+    glad_glBindBuffer = MockBindBuffer;
+    glad_glBindBufferBase = MockBindBufferBase;
+    glad_glBufferData = MockBufferData;
+    glad_glBufferSubData = MockBufferSubData;
+}
+
+constexpr int ProgramCount = 50;
+
+class ShaderLibraryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        g_gl = &gl;
+        InstallMockGL();
+
+        root = fs::path(::testing::TempDir()) /
+               ("sprout_shaders_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(root);
+        fs::create_directories(root / "shaders");
+        Write("shaders/common.glsl", "uniform mat4 uMVP;\n");
+        Write("shaders/basic.vert", "#version 330 core\n#include \"common.glsl\"\nvoid main() {}\n");
+        for (int i = 0; i < ProgramCount; ++i) {
+            Write(FragmentPath(i), "#version 330 core\nuniform vec3 uTint;\nvoid main() {} // " + std::to_string(i) + "\n");
+        }
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+        g_gl = nullptr;
+    }
+
+    void Write(const std::string& relative, const std::string& text) {
+        std::ofstream(root / relative, std::ios::binary | std::ios::trunc) << text;
+    }
+
+    std::string FragmentPath(int i) const { return "shaders/variant" + std::to_string(i) + ".frag"; }
+
+    // A fresh library, as at startup, loading every program; returns its stats
+    ShaderLibrary::Stats Startup() {
+        ShaderLibrary library((root / "cache").string());
+        EXPECT_TRUE(library.Init());
+        EXPECT_TRUE(library.UsesProgramBinaries());
+        for (int i = 0; i < ProgramCount; ++i) {
+            const ShaderLibrary::Handle handle = library.Load((root / "shaders/basic.vert").string(),
+                                                              (root / FragmentPath(i)).string(),
+                                                              {"VARIANT " + std::to_string(i)});
+            EXPECT_NE(handle, ShaderLibrary::InvalidHandle);
+            EXPECT_NE(library.GetProgram(handle), 0u);
+            EXPECT_EQ(library.GetUniform(handle, ShaderLibrary::Uniform::MVP), 1);
+            EXPECT_EQ(library.GetUniform(handle, ShaderLibrary::Uniform::Model), -1);
+        }
+        const ShaderLibrary::Stats stats = library.GetStats();
+        library.Shutdown();
+        return stats;
+    }
+
+    MockGL gl;
+    fs::path root;
+};
+
+} // namespace
+
+TEST_F(ShaderLibraryTest, UnchangedProgramsStartWithoutCompiling) {
+    const ShaderLibrary::Stats cold = Startup();
+    EXPECT_EQ(cold.compiles, static_cast<uint32_t>(ProgramCount));
+    EXPECT_EQ(cold.binaryHits, 0u);
+    EXPECT_EQ(gl.shaderCompiles, ProgramCount * 2);
+
+    gl.shaderCompiles = 0;
+    const ShaderLibrary::Stats warm = Startup();
+    EXPECT_EQ(warm.compiles, 0u);
+    EXPECT_EQ(warm.binaryHits, static_cast<uint32_t>(ProgramCount));
+    EXPECT_EQ(gl.shaderCompiles, 0);
+}
+
+TEST_F(ShaderLibraryTest, EditedSourceRecompilesOnlyItsProgram) {
+    Startup();
+    Write(FragmentPath(7), "#version 330 core\nuniform vec3 uTint;\nvoid main() {} // edited\n");
+
+    const ShaderLibrary::Stats stats = Startup();
+    EXPECT_EQ(stats.compiles, 1u);
+    EXPECT_EQ(stats.binaryHits, static_cast<uint32_t>(ProgramCount - 1));
+}
+
+TEST_F(ShaderLibraryTest, EditedIncludeRecompilesEveryUser) {
+    Startup();
+    Write("shaders/common.glsl", "uniform mat4 uMVP;\nuniform float uUnused;\n");
+
+    EXPECT_EQ(Startup().compiles, static_cast<uint32_t>(ProgramCount));
+}
+
+TEST_F(ShaderLibraryTest, OtherDriverOrRejectedBinaryRecompiles) {
+    Startup();
+
+    gl.renderer = "Another Renderer";
+    EXPECT_EQ(Startup().compiles, static_cast<uint32_t>(ProgramCount));
+
+    // Same driver id, but the driver no longer accepts the stored binaries
+    gl.rejectBinaries = true;
+    gl.binaryLoads = 0;
+    EXPECT_EQ(Startup().compiles, static_cast<uint32_t>(ProgramCount));
+    EXPECT_EQ(gl.binaryLoads, ProgramCount);
+}
+
+TEST_F(ShaderLibraryTest, SameFilesAndDefinesShareAHandle) {
+    ShaderLibrary library((root / "cache").string());
+    ASSERT_TRUE(library.Init());
+    const std::string vert = (root / "shaders/basic.vert").string();
+    const std::string frag = (root / FragmentPath(0)).string();
+
+    const ShaderLibrary::Handle a = library.Load(vert, frag, {"A"});
+    EXPECT_EQ(library.Load(vert, frag, {"A"}), a);
+    EXPECT_NE(library.Load(vert, frag, {"B"}), a);
+    EXPECT_EQ(library.GetProgramCount(), 2u);
+    EXPECT_EQ(library.Load(vert, (root / "shaders/missing.frag").string()), ShaderLibrary::InvalidHandle);
+    library.Shutdown();
+}
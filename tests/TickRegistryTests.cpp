@@ -0,0 +1,371 @@
+#include <gtest/gtest.h>
+#include "Engine/Actor.h"
+#include "Engine/World.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Shared log of lifecycle calls, in order
+std::vector<std::string> g_log;
+
+class AlphaComponent : public ActorComponent {
+public:
+    AlphaComponent(Actor* owner) : ActorComponent(owner) { SetTickEnabled(true); }
+    void BeginPlay() override { g_log.push_back("Alpha.BeginPlay"); }
+    void EndPlay() override { g_log.push_back("Alpha.EndPlay"); }
+    void TickComponent(float) override { g_log.push_back("Alpha.Tick"); }
+};
+
+class BetaComponent : public ActorComponent {
+public:
+    BetaComponent(Actor* owner) : ActorComponent(owner) { SetTickEnabled(true); }
+    void TickComponent(float) override { g_log.push_back("Beta.Tick"); }
+};
+
+class IdleComponent : public ActorComponent {
+public:
+    IdleComponent(Actor* owner) : ActorComponent(owner) {}
+    void TickComponent(float) override { g_log.push_back("Idle.Tick"); }
+};
+
+class LoggingActor : public Actor {
+public:
+    using ThisClass = LoggingActor;
+    using Super = Actor;
+    LoggingActor(World* world, const std::string& name) : Actor(world, name) {}
+    static std::string StaticClass() { return "LoggingActor"; }
+
+    void BeginPlay() override { g_log.push_back(GetName() + ".BeginPlay"); }
+    void EndPlay() override { g_log.push_back(GetName() + ".EndPlay"); }
+    void Tick(float) override { g_log.push_back(GetName() + ".Tick"); }
+};
+
+size_t Count(const std::string& entry) {
+    return static_cast<size_t>(std::count(g_log.begin(), g_log.end(), entry));
+}
+
+size_t IndexOf(const std::string& entry) {
+    return static_cast<size_t>(std::find(g_log.begin(), g_log.end(), entry) - g_log.begin());
+}
+
+class TickRegistryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        g_log.clear();
+        world.SetWorkerThreadCount(0);
+    }
+
+    World world{"TickTest"};
+};
+
+} // namespace
+
+TEST_F(TickRegistryTest, ComponentsTickTypeByType) {
+    for (int i = 0; i < 4; ++i) {
+        Actor* actor = world.SpawnActor<LoggingActor>("Actor" + std::to_string(i));
+        if (i % 2 == 0) {
+            actor->CreateComponent<AlphaComponent>();
+            actor->CreateComponent<BetaComponent>();
+        } else {
+            actor->CreateComponent<BetaComponent>();
+            actor->CreateComponent<AlphaComponent>();
+        }
+    }
+    world.BeginPlay();
+    g_log.clear();
+
+    world.Tick(0.016f);
+
+    // Actors first, then all Alphas back to back and all Betas back to back
+    std::vector<std::string> components;
+    for (const std::string& entry : g_log) {
+        if (entry == "Alpha.Tick" || entry == "Beta.Tick") components.push_back(entry);
+    }
+    ASSERT_EQ(components.size(), 8u);
+    for (size_t i = 1; i < components.size(); ++i) {
+        if (i % 4 != 0) EXPECT_EQ(components[i], components[i - 1]) << "runs of one type are interleaved";
+    }
+    EXPECT_LT(IndexOf("Actor3.Tick"), IndexOf("Alpha.Tick"));
+}
+
+TEST_F(TickRegistryTest, DisabledComponentsAreNotVisited) {
+    Actor* actor = world.SpawnActor<LoggingActor>("Actor");
+    actor->CreateComponent<IdleComponent>();
+    world.BeginPlay();
+
+    world.Tick(0.016f);
+    EXPECT_EQ(Count("Idle.Tick"), 0u);
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredCount(), 0u);
+
+    actor->GetComponent<IdleComponent>()->SetTickEnabled(true);
+    world.Tick(0.016f);
+    EXPECT_EQ(Count("Idle.Tick"), 1u);
+}
+
+TEST_F(TickRegistryTest, BeginPlayAndEndPlayBracketTicks) {
+    Actor* actor = world.SpawnActor<LoggingActor>("Actor");
+    actor->CreateComponent<AlphaComponent>();
+
+    // Nothing ticks before BeginPlay
+    world.Tick(0.016f);
+    EXPECT_TRUE(g_log.empty());
+
+    world.BeginPlay();
+    world.Tick(0.016f);
+    EXPECT_LT(IndexOf("Actor.BeginPlay"), IndexOf("Alpha.BeginPlay"));
+    EXPECT_LT(IndexOf("Alpha.BeginPlay"), IndexOf("Actor.Tick"));
+    EXPECT_LT(IndexOf("Alpha.BeginPlay"), IndexOf("Alpha.Tick"));
+
+    world.EndPlay();
+    const size_t ticks = Count("Alpha.Tick");
+    EXPECT_LT(IndexOf("Alpha.EndPlay"), IndexOf("Actor.EndPlay"));
+
+    world.Tick(0.016f);
+    EXPECT_EQ(Count("Alpha.Tick"), ticks);
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredActorCount(), 0u);
+}
+
+TEST_F(TickRegistryTest, LateComponentGetsBeginPlayBeforeItsFirstTick) {
+    Actor* actor = world.SpawnActor<LoggingActor>("Actor");
+    world.BeginPlay();
+    world.Tick(0.016f);
+
+    actor->CreateComponent<AlphaComponent>();
+    EXPECT_EQ(Count("Alpha.BeginPlay"), 1u);
+    world.Tick(0.016f);
+    EXPECT_LT(IndexOf("Alpha.BeginPlay"), IndexOf("Alpha.Tick"));
+    EXPECT_EQ(Count("Alpha.Tick"), 1u);
+}
+
+TEST_F(TickRegistryTest, TickGroupsRunInOrder) {
+    Actor* late = world.SpawnActor<LoggingActor>("Late");
+    Actor* early = world.SpawnActor<LoggingActor>("Early");
+    late->SetTickGroup(ETickGroup::PostUpdateWork);
+    early->SetTickGroup(ETickGroup::PrePhysics);
+    world.BeginPlay();
+
+    world.Tick(0.016f);
+    EXPECT_LT(IndexOf("Early.Tick"), IndexOf("Late.Tick"));
+}
+
+TEST_F(TickRegistryTest, DestroyedActorStopsTicking) {
+    Actor* actor = world.SpawnActor<LoggingActor>("Doomed");
+    actor->CreateComponent<AlphaComponent>();
+    world.BeginPlay();
+    world.Tick(0.016f);
+
+    world.DestroyActor(actor);
+    world.Tick(0.016f);
+    EXPECT_EQ(Count("Doomed.Tick"), 1u);
+    EXPECT_EQ(Count("Alpha.Tick"), 1u);
+    EXPECT_EQ(world.GetActorCount(), 0u);
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredCount(), 0u);
+}
+
+namespace {
+
+std::atomic<int> g_parallelComponentTicks{0};
+
+class CountingComponent : public ActorComponent {
+public:
+    CountingComponent(Actor* owner) : ActorComponent(owner) {
+        SetTickEnabled(true);
+        SetTickOnGameThreadOnly(false);
+    }
+    void TickComponent(float) override { g_parallelComponentTicks.fetch_add(1); }
+};
+
+// Destroys its target from a parallel tick
+class HunterActor : public Actor {
+public:
+    using ThisClass = HunterActor;
+    using Super = Actor;
+    HunterActor(World* world, const std::string& name) : Actor(world, name) {
+        SetTickOnGameThreadOnly(false);
+        CreateComponent<CountingComponent>();
+    }
+    static std::string StaticClass() { return "HunterActor"; }
+
+    void Tick(float) override {
+        if (Actor* prey = GetWorld()->ResolveActor(target)) GetWorld()->DestroyActor(prey);
+    }
+
+    ActorHandle target;
+};
+
+} // namespace
+
+TEST(TickRegistryParallel, GameThreadIsTheDefault) {
+    World world("Defaults");
+    Actor* actor = world.SpawnActor<Actor>("Plain");
+    EXPECT_TRUE(actor->IsTickOnGameThreadOnly());
+    EXPECT_TRUE(actor->CreateComponent<AlphaComponent>()->IsTickOnGameThreadOnly());
+}
+
+TEST(TickRegistryParallel, DestroyFromParallelTickIsDeferred) {
+    World world("Parallel");
+    world.SetWorkerThreadCount(3);
+
+    constexpr int pairs = 2000;
+    std::vector<HunterActor*> hunters;
+    for (int i = 0; i < pairs * 2; ++i) {
+        hunters.push_back(world.SpawnActor<HunterActor>("Hunter"));
+    }
+    for (int i = 0; i < pairs; ++i) {
+        hunters[i * 2]->target = hunters[i * 2 + 1]->GetHandle();
+    }
+    world.BeginPlay();
+
+    g_parallelComponentTicks = 0;
+    world.Tick(0.016f);
+    EXPECT_EQ(world.GetActorCount(), static_cast<size_t>(pairs));
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredActorCount(), static_cast<size_t>(pairs));
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredCount(), static_cast<size_t>(pairs));
+    EXPECT_GE(g_parallelComponentTicks.load(), pairs);
+
+    g_parallelComponentTicks = 0;
+    world.Tick(0.016f);
+    EXPECT_EQ(g_parallelComponentTicks.load(), pairs);
+}
+
+namespace {
+
+// One type per N, so every spawn below needs a component bucket that does not exist yet
+template<int N>
+class FreshComponent : public ActorComponent {
+public:
+    FreshComponent(Actor* owner) : ActorComponent(owner) { SetTickEnabled(true); }
+    void TickComponent(float) override { g_log.push_back("Fresh" + std::to_string(N) + ".Tick"); }
+};
+
+// Spawns actors with new component types from its game-thread Tick, on the first frame only
+class SpawnerActor : public Actor {
+public:
+    using ThisClass = SpawnerActor;
+    using Super = Actor;
+    SpawnerActor(World* world, const std::string& name) : Actor(world, name) {
+        CreateComponent<AlphaComponent>();
+    }
+    static std::string StaticClass() { return "SpawnerActor"; }
+
+    void Tick(float) override {
+        g_log.push_back("Spawner.Tick");
+        if (spawned) return;
+        spawned = true;
+        SpawnWith<FreshComponent<0>, FreshComponent<1>, FreshComponent<2>, FreshComponent<3>>();
+        SpawnWith<FreshComponent<4>, FreshComponent<5>, FreshComponent<6>, FreshComponent<7>>();
+        // A new type on this actor too, while its own components are about to tick
+        CreateComponent<FreshComponent<8>>();
+    }
+
+    template<typename... Components>
+    void SpawnWith() {
+        Actor* child = GetWorld()->SpawnActor<LoggingActor>("Spawned");
+        (child->CreateComponent<Components>(), ...);
+    }
+
+    bool spawned = false;
+};
+
+std::atomic<int> g_earlyTicks{0};
+std::atomic<int> g_lateTicks{0};
+
+class RegroupComponent : public ActorComponent {
+public:
+    RegroupComponent(Actor* owner) : ActorComponent(owner) {
+        SetTickEnabled(true);
+        SetTickOnGameThreadOnly(false);
+    }
+    void TickComponent(float) override {
+        (GetTickGroup() == ETickGroup::PrePhysics ? g_earlyTicks : g_lateTicks).fetch_add(1);
+        SetTickGroup(ETickGroup::PostUpdateWork);
+    }
+};
+
+// Moves itself (and its component) to a later group from its parallel tick
+class RegroupActor : public Actor {
+public:
+    using ThisClass = RegroupActor;
+    using Super = Actor;
+    RegroupActor(World* world, const std::string& name) : Actor(world, name) {
+        SetTickOnGameThreadOnly(false);
+        CreateComponent<RegroupComponent>();
+    }
+    static std::string StaticClass() { return "RegroupActor"; }
+
+    void Tick(float) override {
+        (GetTickGroup() == ETickGroup::PrePhysics ? g_earlyTicks : g_lateTicks).fetch_add(1);
+        SetTickGroup(ETickGroup::PostUpdateWork);
+    }
+};
+
+} // namespace
+
+TEST_F(TickRegistryTest, SpawningNewComponentTypesFromAGameThreadTick) {
+    world.SpawnActor<SpawnerActor>("Spawner");
+    world.BeginPlay();
+    const size_t bucketsBefore = world.GetTickRegistry().GetBucketCount();
+
+    world.Tick(0.016f);
+    // Registered once the group is done, so none of them ticked this frame
+    EXPECT_EQ(world.GetTickRegistry().GetBucketCount(), bucketsBefore + 9);
+    EXPECT_EQ(Count("Fresh0.Tick") + Count("Fresh8.Tick"), 0u);
+    EXPECT_EQ(Count("Alpha.Tick"), 1u);
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredActorCount(), 3u);
+
+    g_log.clear();
+    world.Tick(0.016f);
+    EXPECT_EQ(Count("Spawned.Tick"), 2u);
+    EXPECT_EQ(Count("Fresh0.Tick"), 1u);
+    EXPECT_EQ(Count("Fresh7.Tick"), 1u);
+    EXPECT_EQ(Count("Fresh8.Tick"), 1u);
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredCount(), 10u);
+}
+
+TEST_F(TickRegistryTest, ComponentAddedAndRemovedInOneTickNeverRegisters) {
+    class AddRemoveActor : public LoggingActor {
+    public:
+        using ThisClass = AddRemoveActor;
+        using Super = LoggingActor;
+        using LoggingActor::LoggingActor;
+        static std::string StaticClass() { return "AddRemoveActor"; }
+        void Tick(float) override {
+            CreateComponent<BetaComponent>();
+            RemoveComponent<BetaComponent>();
+        }
+    };
+    world.SpawnActor<AddRemoveActor>("AddRemove");
+    world.BeginPlay();
+
+    world.Tick(0.016f);
+    world.Tick(0.016f);
+    EXPECT_EQ(Count("Beta.Tick"), 0u);
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredCount(), 0u);
+}
+
+TEST(TickRegistryParallel, TickGroupChangeFromParallelTickKeepsTicking) {
+    World world("Regroup");
+    world.SetWorkerThreadCount(3);
+    constexpr int count = 500;
+    for (int i = 0; i < count; ++i) {
+        world.SpawnActor<RegroupActor>("Regroup");
+    }
+    world.BeginPlay();
+
+    g_earlyTicks = 0;
+    g_lateTicks = 0;
+    world.Tick(0.016f);
+    // Moved once PrePhysics is done, so PostUpdateWork already ticks them this frame
+    EXPECT_EQ(g_earlyTicks.load(), count * 2);
+    EXPECT_EQ(g_lateTicks.load(), count * 2);
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredActorCount(), static_cast<size_t>(count));
+    EXPECT_EQ(world.GetTickRegistry().GetRegisteredCount(), static_cast<size_t>(count));
+
+    // Re-bucketed, not dropped
+    for (int frame = 0; frame < 2; ++frame) world.Tick(0.016f);
+    EXPECT_EQ(g_earlyTicks.load(), count * 2);
+    EXPECT_EQ(g_lateTicks.load(), count * 6);
+}
@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include "Engine/Systems.h"
+#include "Engine/Transform.h"
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// World matrix straight from the parent chain, cut at a repeated entity
+glm::mat4 BruteForceWorld(const entt::registry& reg, entt::entity e) {
+    std::vector<entt::entity> chain;
+    entt::entity current = e;
+    while (current != entt::null && reg.valid(current) && reg.all_of<Transform>(current)) {
+        bool seen = false;
+        for (auto visited : chain) seen = seen || visited == current;
+        if (seen) break;
+        chain.push_back(current);
+        current = reg.get<Transform>(current).GetParent();
+    }
+
+    glm::mat4 world(1.0f);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        world = world * reg.get<Transform>(*it).GetLocalMatrix();
+    }
+    return world;
+}
+
+void ExpectMatrixNear(const glm::mat4& actual, const glm::mat4& expected) {
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            EXPECT_NEAR(actual[c][r], expected[c][r], 1e-3f) << "column " << c << " row " << r;
+        }
+    }
+}
+
+uint32_t UpdatedFrame(const entt::registry& reg, entt::entity e) {
+    return reg.get<WorldTransform>(e).updatedFrame;
+}
+
+} // namespace
+
+TEST(TransformHierarchy, MatchesParentChainUnderRandomEdits) {
+    entt::registry reg;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 500; ++i) {
+        entt::entity e = reg.create();
+        Transform& t = reg.emplace<Transform>(e);
+        t.SetPosition({offset(rng), offset(rng), offset(rng)});
+        t.SetRotationEuler({offset(rng) * 20.0f, offset(rng) * 20.0f, 0.0f});
+        // Parents always come earlier, so no cycles here
+        if (i > 0 && rng() % 4 != 0) t.SetParent(entities[rng() % entities.size()]);
+        entities.push_back(e);
+    }
+
+    for (int frame = 0; frame < 10; ++frame) {
+        Systems::UpdateTransform(reg, 0.016f);
+        for (auto e : entities) {
+            ExpectMatrixNear(reg.get<WorldTransform>(e).matrix, BruteForceWorld(reg, e));
+        }
+
+        for (int edit = 0; edit < 20; ++edit) {
+            const size_t index = rng() % entities.size();
+            Transform& t = reg.get<Transform>(entities[index]);
+            if (edit % 5 == 0 && index > 0) {
+                t.SetParent(entities[rng() % index]);
+            } else {
+                t.SetPosition(t.GetPosition() + glm::vec3(offset(rng), 0.0f, 0.0f));
+            }
+        }
+    }
+}
+
+TEST(TransformHierarchy, OnlyChangedSubtreesAreRecomputed) {
+    entt::registry reg;
+    entt::entity root = reg.create();
+    reg.emplace<Transform>(root);
+    entt::entity left = reg.create();
+    reg.emplace<Transform>(left).SetParent(root);
+    entt::entity leftChild = reg.create();
+    reg.emplace<Transform>(leftChild).SetParent(left);
+    entt::entity right = reg.create();
+    reg.emplace<Transform>(right).SetParent(root);
+
+    Systems::UpdateTransform(reg, 0.016f);
+    const uint32_t first = UpdatedFrame(reg, root);
+    EXPECT_NE(first, 0u);
+
+    // Nothing changed: nothing is rewritten
+    Systems::UpdateTransform(reg, 0.016f);
+    EXPECT_EQ(UpdatedFrame(reg, root), first);
+    EXPECT_EQ(UpdatedFrame(reg, leftChild), first);
+
+    reg.get<Transform>(left).SetPosition({1.0f, 0.0f, 0.0f});
+    Systems::UpdateTransform(reg, 0.016f);
+    EXPECT_EQ(UpdatedFrame(reg, root), first);
+    EXPECT_EQ(UpdatedFrame(reg, right), first);
+    EXPECT_GT(UpdatedFrame(reg, left), first);
+    EXPECT_GT(UpdatedFrame(reg, leftChild), first);
+    EXPECT_FLOAT_EQ(reg.get<WorldTransform>(leftChild).GetPosition().x, 1.0f);
+}
+
+TEST(TransformHierarchy, ReparentingMovesTheSubtree) {
+    entt::registry reg;
+    entt::entity a = reg.create();
+    reg.emplace<Transform>(a).SetPosition({10.0f, 0.0f, 0.0f});
+    entt::entity b = reg.create();
+    reg.emplace<Transform>(b).SetPosition({0.0f, 5.0f, 0.0f});
+    entt::entity child = reg.create();
+    reg.emplace<Transform>(child).SetParent(a);
+    entt::entity grandchild = reg.create();
+    Transform& grandchildTransform = reg.emplace<Transform>(grandchild);
+    grandchildTransform.SetParent(child);
+    grandchildTransform.SetPosition({0.0f, 0.0f, 1.0f});
+
+    Systems::UpdateTransform(reg, 0.016f);
+    EXPECT_EQ(reg.get<WorldTransform>(grandchild).GetPosition(), glm::vec3(10.0f, 0.0f, 1.0f));
+
+    reg.get<Transform>(child).SetParent(b);
+    Systems::UpdateTransform(reg, 0.016f);
+    EXPECT_EQ(reg.get<WorldTransform>(grandchild).GetPosition(), glm::vec3(0.0f, 5.0f, 1.0f));
+}
+
+TEST(TransformHierarchy, DestroyedParentLeavesChildrenAsRoots) {
+    entt::registry reg;
+    entt::entity parent = reg.create();
+    reg.emplace<Transform>(parent).SetPosition({3.0f, 0.0f, 0.0f});
+    entt::entity child = reg.create();
+    Transform& childTransform = reg.emplace<Transform>(child);
+    childTransform.SetParent(parent);
+    childTransform.SetPosition({1.0f, 0.0f, 0.0f});
+
+    Systems::UpdateTransform(reg, 0.016f);
+    EXPECT_FLOAT_EQ(reg.get<WorldTransform>(child).GetPosition().x, 4.0f);
+
+    reg.destroy(parent);
+    Systems::UpdateTransform(reg, 0.016f);
+    EXPECT_FLOAT_EQ(reg.get<WorldTransform>(child).GetPosition().x, 1.0f);
+}
+
+TEST(TransformHierarchy, ParentCycleIsCut) {
+    entt::registry reg;
+    entt::entity a = reg.create();
+    entt::entity b = reg.create();
+    reg.emplace<Transform>(a).SetPosition({1.0f, 0.0f, 0.0f});
+    reg.emplace<Transform>(b).SetPosition({2.0f, 0.0f, 0.0f});
+    reg.get<Transform>(a).SetParent(b);
+    reg.get<Transform>(b).SetParent(a);
+
+    Systems::UpdateTransform(reg, 0.016f);
+    const float ax = reg.get<WorldTransform>(a).GetPosition().x;
+    const float bx = reg.get<WorldTransform>(b).GetPosition().x;
+    // One of them is treated as the root, the other composes on top of it
+    EXPECT_TRUE((ax == 1.0f && bx == 3.0f) || (ax == 3.0f && bx == 2.0f)) << ax << ", " << bx;
+}
+
+TEST(TransformHierarchy, AssigningAWholeTransformCountsAsAChange) {
+    entt::registry reg;
+    entt::entity e = reg.create();
+    reg.emplace<Transform>(e);
+    Systems::UpdateTransform(reg, 0.016f);
+
+    Transform moved;
+    moved.SetPosition({0.0f, 7.0f, 0.0f});
+    reg.replace<Transform>(e, moved);
+    Systems::UpdateTransform(reg, 0.016f);
+    EXPECT_FLOAT_EQ(reg.get<WorldTransform>(e).GetPosition().y, 7.0f);
+
+    Transform copy = reg.get<Transform>(e);
+    copy.SetPosition({0.0f, 9.0f, 0.0f});
+    reg.get<Transform>(e) = copy;
+    Systems::UpdateTransform(reg, 0.016f);
+    EXPECT_FLOAT_EQ(reg.get<WorldTransform>(e).GetPosition().y, 9.0f);
+}
+
+TEST(TransformHierarchy, RelocatedComponentsKeepReportingChanges) {
+    entt::registry reg;
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 64; ++i) {
+        entt::entity e = reg.create();
+        reg.emplace<Transform>(e);
+        entities.push_back(e);
+    }
+    Systems::UpdateTransform(reg, 0.016f);
+
+    // Removing from the front swaps later components into the freed slots
+    for (int i = 0; i < 16; ++i) {
+        reg.destroy(entities[i]);
+    }
+    for (int i = 0; i < 64; ++i) {
+        entt::entity e = reg.create();
+        reg.emplace<Transform>(e);
+    }
+    Systems::UpdateTransform(reg, 0.016f);
+
+    for (int i = 16; i < 64; ++i) {
+        reg.get<Transform>(entities[i]).SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+    }
+    Systems::UpdateTransform(reg, 0.016f);
+    for (int i = 16; i < 64; ++i) {
+        EXPECT_FLOAT_EQ(reg.get<WorldTransform>(entities[i]).GetPosition().x, static_cast<float>(i));
+    }
+}
+
+TEST(TransformHierarchy, SettersFromSeveralThreadsAreAllCollected) {
+    entt::registry reg;
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 4000; ++i) {
+        entt::entity e = reg.create();
+        reg.emplace<Transform>(e);
+        entities.push_back(e);
+    }
+    Systems::UpdateTransform(reg, 0.016f);
+
+    // Disjoint strides per thread, as parallel ticks would write them
+    constexpr int ThreadCount = 4;
+    for (int frame = 1; frame <= 3; ++frame) {
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < ThreadCount; ++thread) {
+            threads.emplace_back([&, thread] {
+                for (size_t i = thread; i < entities.size(); i += ThreadCount) {
+                    reg.get<Transform>(entities[i]).SetPosition({static_cast<float>(i), static_cast<float>(frame), 0.0f});
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+
+        Systems::UpdateTransform(reg, 0.016f);
+        for (size_t i = 0; i < entities.size(); ++i) {
+            const glm::vec3 position = reg.get<WorldTransform>(entities[i]).GetPosition();
+            ASSERT_FLOAT_EQ(position.x, static_cast<float>(i));
+            ASSERT_FLOAT_EQ(position.y, static_cast<float>(frame));
+        }
+    }
+}
+
+TEST(TransformHierarchy, RegistriesKeepSeparateDirtySets) {
+    // One thread alternating between registries, and a registry replaced by a new one
+    for (int round = 0; round < 3; ++round) {
+        entt::registry a, b;
+        entt::entity inA = a.create();
+        entt::entity inB = b.create();
+        a.emplace<Transform>(inA);
+        b.emplace<Transform>(inB);
+        Systems::UpdateTransform(a, 0.016f);
+        Systems::UpdateTransform(b, 0.016f);
+
+        for (int i = 1; i <= 4; ++i) {
+            a.get<Transform>(inA).SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+            b.get<Transform>(inB).SetPosition({0.0f, static_cast<float>(i), 0.0f});
+            Systems::UpdateTransform(a, 0.016f);
+            EXPECT_FLOAT_EQ(a.get<WorldTransform>(inA).GetPosition().x, static_cast<float>(i));
+            Systems::UpdateTransform(b, 0.016f);
+            EXPECT_FLOAT_EQ(b.get<WorldTransform>(inB).GetPosition().y, static_cast<float>(i));
+        }
+    }
+}
+
+TEST(Transform, EulerAnglesAccumulateExactly) {
+    // RotatingCube-style per-axis rates: the angles read back are the ones written
+    Transform t;
+    glm::vec3 expected(0.0f);
+    for (int i = 0; i < 400; ++i) {
+        const glm::vec3 delta = glm::vec3(0.3f, 1.0f, 0.5f) * 90.0f * 0.016f;
+        t.SetRotationEuler(t.GetRotationEuler() + delta);
+        expected += delta;
+    }
+    EXPECT_EQ(t.GetRotationEuler(), expected);
+    ExpectMatrixNear(glm::mat4_cast(t.GetRotation()), glm::mat4_cast(Transform::QuatFromEuler(expected)));
+
+    // After a quaternion write the angles describe that quaternion
+    const glm::quat q = Transform::QuatFromEuler({10.0f, 20.0f, 30.0f});
+    t.SetRotation(q);
+    ExpectMatrixNear(glm::mat4_cast(Transform::QuatFromEuler(t.GetRotationEuler())), glm::mat4_cast(q));
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "Engine/Transform.h"
+#include "Engine/TransformKernel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr TransformKernel::Path AllPaths[] = {TransformKernel::Path::Scalar, TransformKernel::Path::SSE2,
+                                              TransformKernel::Path::AVX2};
+
+// Random TRS values as SoA for the kernel, plus the same values as Transforms
+struct Inputs {
+    std::vector<float> px, py, pz, rx, ry, rz, rw, sx, sy, sz;
+    std::vector<glm::mat4> expected;
+
+    explicit Inputs(size_t count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+        for (size_t i = 0; i < count; ++i) {
+            glm::quat q(unit(rng), unit(rng), unit(rng), unit(rng));
+            q = glm::normalize(q);
+            Transform t;
+            t.SetPosition({position(rng), position(rng), position(rng)});
+            t.SetRotation(q);
+            // Uniform and non-uniform scales
+            const float s = scale(rng);
+            t.SetScale(i % 3 == 0 ? glm::vec3(s) : glm::vec3(s, scale(rng), scale(rng)));
+
+            px.push_back(t.GetPosition().x); py.push_back(t.GetPosition().y); pz.push_back(t.GetPosition().z);
+            rx.push_back(q.x); ry.push_back(q.y); rz.push_back(q.z); rw.push_back(q.w);
+            sx.push_back(t.GetScale().x); sy.push_back(t.GetScale().y); sz.push_back(t.GetScale().z);
+            expected.push_back(t.GetLocalMatrix());
+        }
+    }
+
+    TransformKernel::TRSArrays Arrays() const {
+        return {px.data(), py.data(), pz.data(), rx.data(), ry.data(), rz.data(), rw.data(),
+                sx.data(), sy.data(), sz.data()};
+    }
+};
+
+// Composes count matrices on path into a buffer with guard matrices after the end; checks
+// every matrix against Transform::GetLocalMatrix and that the guard is untouched
+void ExpectPathMatches(TransformKernel::Path path, size_t count) {
+    const Inputs inputs(count, static_cast<uint32_t>(count) * 31 + 7);
+    constexpr size_t guardMatrices = 2;
+    constexpr float guard = 12345.0f;
+    std::vector<float> out((count + guardMatrices) * 16, guard);
+
+    TransformKernel::ComposeTRS(inputs.Arrays(), out.data(), count, path);
+
+    for (size_t i = 0; i < count; ++i) {
+        glm::mat4 actual;
+        std::memcpy(&actual, &out[i * 16], sizeof(actual));
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                const float expected = inputs.expected[i][c][r];
+                ASSERT_NEAR(actual[c][r], expected, 1e-5f * std::max(1.0f, std::fabs(expected)))
+                    << TransformKernel::GetPathName(path) << ", count " << count << ", matrix " << i
+                    << ", column " << c << " row " << r;
+            }
+        }
+    }
+    for (size_t i = count * 16; i < out.size(); ++i) {
+        ASSERT_EQ(out[i], guard) << TransformKernel::GetPathName(path) << " wrote past count " << count;
+    }
+}
+
+} // namespace
+
+TEST(TransformKernel, EveryPathMatchesGetLocalMatrix) {
+    // Tails that are not a multiple of the 4- or 8-wide loops, and a long run
+    const size_t counts[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 11, 12, 15, 16, 17, 23, 1003};
+    for (TransformKernel::Path path : AllPaths) {
+        if (!TransformKernel::IsPathSupported(path)) {
+            std::printf("[  SKIPPED ] %s is not supported on this CPU\n", TransformKernel::GetPathName(path));
+            continue;
+        }
+        for (size_t count : counts) {
+            ExpectPathMatches(path, count);
+            if (HasFatalFailure()) return;
+        }
+    }
+}
+
+TEST(TransformKernel, DefaultAndUnsupportedPathsStillCompose) {
+    EXPECT_TRUE(TransformKernel::IsPathSupported(TransformKernel::Path::Scalar));
+    EXPECT_TRUE(TransformKernel::IsPathSupported(TransformKernel::GetBestPath()));
+
+    const Inputs inputs(37, 5);
+    std::vector<float> best(37 * 16);
+    TransformKernel::ComposeTRS(inputs.Arrays(), best.data(), 37);
+    std::vector<float> scalar(37 * 16);
+    TransformKernel::ComposeTRS(inputs.Arrays(), scalar.data(), 37, TransformKernel::Path::Scalar);
+    for (size_t i = 0; i < best.size(); ++i) {
+        ASSERT_NEAR(best[i], scalar[i], 1e-5f * std::max(1.0f, std::fabs(scalar[i]))) << i;
+    }
+
+    // A path the CPU lacks falls back instead of faulting
+    for (TransformKernel::Path path : AllPaths) {
+        ExpectPathMatches(path, 13);
+    }
+}